@@ -6,10 +6,22 @@
 
 // uni_common
 #include "uni_common_array.h"
+#include "uni_common_btreemap.h"
 #include "uni_common_bytes.h"
 #include "uni_common_compiler.h"
+#include "uni_common_hash.h"
 #include "uni_common_lrumap.h"
 #include "uni_common_map.h"
+#include "uni_common_map_seqlock.h"
+#include "uni_common_map_sharded.h"
 #include "uni_common_math.h"
 #include "uni_common_ringbuffer.h"
+#include "uni_common_ringbuffer_broadcast.h"
+#include "uni_common_ringbuffer_file.h"
+#include "uni_common_ringbuffer_mirror.h"
+#include "uni_common_ringbuffer_mpmc.h"
+#include "uni_common_ringbuffer_record.h"
+#include "uni_common_ringbuffer_spsc.h"
+#include "uni_common_ringbuffer_wait.h"
+#include "uni_common_ringbuffer_window.h"
 #include "uni_common_tokenizer.h"
@@ -0,0 +1,297 @@
+#pragma once
+
+/**
+ * Ordered map (B+-tree) with range queries
+ *
+ * behavior:
+ *  * keys are kept in ascending order, enumeration and range scans visit them in that order
+ *  * get/set/remove/lower_bound are O(log n) with the fan-out of UNI_COMMON_BTREEMAP_ORDER
+ *  * sorted keys can be bulk loaded in O(n), the nodes are filled completely
+ *  * ascending inserts split the rightmost nodes unevenly (the new node takes only the new entry), so append-only
+ *    keys such as time-bucketed IDs leave the nodes full instead of half-full
+ *
+ * data storage:
+ *  * caller-provided array of nodes, every node keeps up to UNI_COMMON_BTREEMAP_ORDER keys and occupies 4 cache
+ *    lines on 64-bit targets, the keys are scanned within the node without pointer chasing
+ *  * leaves are linked in both directions, so range scans walk the leaf chain instead of the tree
+ *  * caller-provided array of values, the values of the leaf N are stored at [N * ORDER, (N + 1) * ORDER)
+ *  * unused nodes are kept in the singly-linked free list threaded through the link-to-next field
+ *  * removal frees the node when it becomes empty (free-at-empty), underfull nodes are not merged
+ *
+ * data types:
+ *  * key is size_t, the full range is allowed
+ *  * value is user-defined variable or struct, value pointers are valid only until the next set/remove
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_array.h"
+
+
+
+//
+// Defines
+//
+
+/**
+ * Maximum number of keys in the node
+ */
+#define UNI_COMMON_BTREEMAP_ORDER 20U
+
+/**
+ * Maximum number of tree levels, set fails instead of growing the tree beyond it
+ */
+#define UNI_COMMON_BTREEMAP_HEIGHT_MAX 16U
+
+/**
+ * Marker of the missing node
+ */
+#define UNI_COMMON_BTREEMAP_NODE_NONE UINT32_MAX
+
+
+
+//
+// Typedefs
+//
+
+/**
+ * Typedef for enumerator function
+ *
+ * @param key ordered map item key
+ * @param val pointer to the ordered map item value
+ */
+typedef void (*uni_common_btreemap_enum_func_t)(size_t key, const void *val);
+
+
+/**
+ * Ordered map node
+ */
+typedef struct {
+    /**
+     * Number of used keys
+     */
+    uint16_t count;
+
+    /**
+     * Non-zero for the leaf node
+     */
+    uint16_t leaf;
+
+    /**
+     * Link to the previous leaf, UNI_COMMON_BTREEMAP_NODE_NONE for the first leaf and inner nodes
+     */
+    uint32_t link_prev;
+
+    /**
+     * Link to the next leaf (or next free node), UNI_COMMON_BTREEMAP_NODE_NONE for the last leaf and inner nodes
+     */
+    uint32_t link_next;
+
+    /**
+     * Keys in ascending order, key N of the inner node is the lower bound of the child N subtree
+     */
+    size_t keys[UNI_COMMON_BTREEMAP_ORDER];
+
+    /**
+     * Child nodes of the inner node, unused in leaves
+     */
+    uint32_t links[UNI_COMMON_BTREEMAP_ORDER];
+} uni_common_btreemap_node_t;
+
+
+/**
+ * Ordered map context structure
+ */
+typedef struct {
+    /**
+     * Pointer to the nodes array
+     */
+    uni_common_array_t *nodes;
+
+    /**
+     * Pointer to the values array
+     */
+    uni_common_array_t *vals;
+
+    /**
+     * Number of usable nodes
+     */
+    size_t node_count;
+
+    /**
+     * Number of nodes in the free list
+     */
+    size_t node_free_count;
+
+    /**
+     * First node of the free list
+     */
+    uint32_t node_free;
+
+    /**
+     * Root node
+     */
+    uint32_t root;
+
+    /**
+     * Number of tree levels, 1 when root is leaf
+     */
+    size_t height;
+
+    /**
+     * Number of stored keys
+     */
+    size_t size;
+
+    /**
+     * Flags which stores the initialization state
+     */
+    bool initialized;
+} uni_common_btreemap_context_t;
+
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes ordered map
+ * @param ctx pointer to the ordered map context
+ * @param nodes pointer to the array of nodes
+ * @param vals pointer to the array of values
+ * @note :nodes element size will be changed to sizeof(uni_common_btreemap_node_t), buffer must be suitably aligned
+ * @note node count is min(nodes.length(), vals.length() / UNI_COMMON_BTREEMAP_ORDER, UINT32_MAX), at least 1
+ * @note every node holds from 1 to UNI_COMMON_BTREEMAP_ORDER keys, plan ~2x of size / ORDER nodes for random inserts
+ * @return true on success
+ */
+bool uni_common_btreemap_init(uni_common_btreemap_context_t *ctx, uni_common_array_t *nodes, uni_common_array_t *vals);
+
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns number of tree levels
+ * @param ctx pointer to the ordered map context
+ * @return number of levels, 0 on invalid context
+ */
+size_t uni_common_btreemap_height(const uni_common_btreemap_context_t *ctx);
+
+
+/**
+ * Checks that ordered map was initialized
+ * @param ctx pointer to the ordered map context
+ * @return true if map was properly initialized
+ */
+bool uni_common_btreemap_initialized(const uni_common_btreemap_context_t *ctx);
+
+
+/**
+ * Returns number of stored keys
+ * @param ctx pointer to the ordered map context
+ * @return number of keys
+ */
+size_t uni_common_btreemap_size(const uni_common_btreemap_context_t *ctx);
+
+
+
+//
+// Functions/Process
+//
+
+/**
+ * Resets ordered map to the initial state
+ * @param ctx pointer to the ordered map context
+ * @return true on success
+ */
+bool uni_common_btreemap_clear(uni_common_btreemap_context_t *ctx);
+
+
+/**
+ * Enumerates ordered map in ascending key order
+ * @param ctx pointer to the ordered map context
+ * @param func pointer to the enumerator function
+ * @return true on success
+ */
+bool uni_common_btreemap_enum(uni_common_btreemap_context_t *ctx, uni_common_btreemap_enum_func_t func);
+
+
+/**
+ * Enumerates keys of the [lo, hi) range in ascending order
+ * @param ctx pointer to the ordered map context
+ * @param lo first key of the range
+ * @param hi key after the last key of the range
+ * @param func pointer to the enumerator function
+ * @return number of enumerated keys
+ */
+size_t uni_common_btreemap_enum_range(uni_common_btreemap_context_t *ctx, size_t lo, size_t hi, uni_common_btreemap_enum_func_t func);
+
+
+/**
+ * Get pointer to the start of map element value by element key
+ * @param ctx pointer to the ordered map context
+ * @param key map item key
+ * @return pointer to the element value, NULL if element does not exists
+ */
+uint8_t *uni_common_btreemap_get(uni_common_btreemap_context_t *ctx, size_t key);
+
+
+/**
+ * Replaces the map content with the sorted keys
+ * @param ctx pointer to the ordered map context
+ * @param keys pointer to the keys in strictly ascending order
+ * @param count number of keys
+ * @param vals pointer to the values, packed by the value element size
+ * @return true on success, map is not changed on failure (unsorted keys or not enough nodes)
+ *
+ * @note O(count), leaves and inner nodes are filled completely
+ */
+bool uni_common_btreemap_load(uni_common_btreemap_context_t *ctx, const size_t *keys, size_t count, const void *vals);
+
+
+/**
+ * Finds the first element with key greater than or equal to the given one
+ * @param ctx pointer to the ordered map context
+ * @param key key to search
+ * @param key_found pointer which will contain found key, may be NULL
+ * @param val_found pointer which will contain pointer to the found value, may be NULL
+ * @return true if element was found
+ */
+bool uni_common_btreemap_lower_bound(uni_common_btreemap_context_t *ctx, size_t key, size_t *key_found, uint8_t **val_found);
+
+
+/**
+ * Removes element with the given key from the ordered map
+ * @param ctx pointer to the ordered map context
+ * @param key key to remove
+ * @return true on success (element was removed)
+ */
+bool uni_common_btreemap_remove(uni_common_btreemap_context_t *ctx, size_t key);
+
+
+/**
+ * Inserts or updates the element
+ * @param ctx pointer to the ordered map context
+ * @param key element key
+ * @param val pointer to the element value
+ * @return true on success, false when there are not enough free nodes for the split
+ */
+bool uni_common_btreemap_set(uni_common_btreemap_context_t *ctx, size_t key, const void *val);
+
+
+#if defined(__cplusplus)
+}
+#endif
@@ -36,6 +36,37 @@ UNI_COMMON_COMPILER_INLINE_ALWAYS uint32_t uni_common_bytes_popcount32(uint32_t
 }
 
 
+/**
+ * Get count of trailing 0 bits in variable
+ * @param val variable to check, must not be 0
+ * @return index of the least significant 1 bit
+ */
+UNI_COMMON_COMPILER_INLINE_ALWAYS uint32_t uni_common_bytes_ctz32(uint32_t val) {
+#if defined(_MSC_VER)
+    unsigned long result;
+    _BitScanForward(&result, val);
+    return (uint32_t)result;
+#else
+    return (uint32_t)__builtin_ctz(val);
+#endif
+}
+
+
+/**
+ * Get count of trailing 0 bits in 64-bit variable
+ * @param val variable to check, must not be 0
+ * @return index of the least significant 1 bit
+ */
+UNI_COMMON_COMPILER_INLINE_ALWAYS uint32_t uni_common_bytes_ctz64(uint64_t val) {
+#if defined(_MSC_VER)
+    uint32_t low = (uint32_t)val;
+    return low != 0U ? uni_common_bytes_ctz32(low) : 32U + uni_common_bytes_ctz32((uint32_t)(val >> 32U));
+#else
+    return (uint32_t)__builtin_ctzll(val);
+#endif
+}
+
+
 /**
  * Find subarray in array
  * @param big big array pointer
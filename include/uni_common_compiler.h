@@ -91,3 +91,25 @@
 #else
 #define UNI_COMMON_COMPILER_INLINE_ALWAYS static inline
 #endif
+
+
+
+//
+// UNI_COMMON_COMPILER_CACHELINE
+//
+
+#if !defined(UNI_COMMON_COMPILER_CACHELINE)
+    #define UNI_COMMON_COMPILER_CACHELINE 64
+#endif
+
+
+
+//
+// UNI_COMMON_COMPILER_PREFETCH
+//
+
+#if defined(__GNUC__)
+    #define UNI_COMMON_COMPILER_PREFETCH(x) __builtin_prefetch((x))
+#else
+    #define UNI_COMMON_COMPILER_PREFETCH(x) ((void)(x))
+#endif
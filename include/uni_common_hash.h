@@ -0,0 +1,67 @@
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// Includes
+//
+
+// stdlib
+#include <stddef.h>
+#include <stdint.h>
+
+// uni_common
+#include "uni_common_compiler.h"
+
+
+
+//
+// Functions
+//
+
+/**
+ * Calculates hash of the size_t key
+ * @param key key to hash
+ * @return 64-bit hash with well-mixed bits
+ *
+ * @note murmur3 fmix64 finalizer, it is a bijection so distinct keys never collide before reduction
+ */
+UNI_COMMON_COMPILER_INLINE_ALWAYS uint64_t uni_common_hash_size(size_t key) {
+    uint64_t result = (uint64_t)key;
+
+    result ^= result >> 33U;
+    result *= 0xFF51AFD7ED558CCDULL;
+    result ^= result >> 33U;
+    result *= 0xC4CEB9FE1A85EC53ULL;
+    result ^= result >> 33U;
+
+    return result;
+}
+
+
+/**
+ * Reduces hash to the [0, range) interval
+ * @param hash hash value
+ * @param range size of the output interval, must be greater than 0
+ * @return reduced value
+ *
+ * @note uses multiply-shift instead of the division when range fits into 32 bits
+ */
+UNI_COMMON_COMPILER_INLINE_ALWAYS size_t uni_common_hash_reduce(uint64_t hash, size_t range) {
+    size_t result;
+
+    if ((uint64_t)range <= UINT32_MAX) {
+        result = (size_t)(((hash >> 32U) * (uint64_t)range) >> 32U);
+    } else {
+        result = (size_t)(hash % (uint64_t)range);
+    }
+
+    return result;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
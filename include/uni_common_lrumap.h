@@ -9,9 +9,14 @@
  *
  * data storage:
  *   * it uses double-linked list due to static memory allocation requirement
+ *   * unused slots are kept in the singly-linked free list threaded through the link-to-next array
+ *   * compact layout keeps key and 32-bit links of the slot in the single 16-byte node (on 64-bit targets),
+ *     so relinking touches one cache line instead of three
+ *   * optional key index (open addressing table of slot numbers) makes key lookups O(1)
+ *   * optional rank tree (Fenwick tree over the list positions) makes positional lookups O(log n)
  *
  * data types:
- *   * key is size_t
+ *   * key is size_t, SIZE_MAX is reserved as empty slot marker
  *   * value is user-defined variable or struct
  */
 
@@ -70,6 +75,27 @@ extern uni_common_lrumap_context_t name##_ctx
  */
 typedef void (*uni_common_lrumap_enum_func_t)(size_t key, const void *val);
 
+/**
+ * LRU-map node of the compact layout
+ */
+typedef struct {
+    /**
+     * Key of the slot, SIZE_MAX for unused slot
+     */
+    size_t key;
+
+    /**
+     * Link to the previous slot, UINT32_MAX if there is no previous slot
+     */
+    uint32_t link_prev;
+
+    /**
+     * Link to the next slot, UINT32_MAX if there is no next slot
+     */
+    uint32_t link_next;
+} uni_common_lrumap_node_t;
+
+
 /**
  * LRU-map context structure
  */
@@ -86,6 +112,17 @@ typedef struct {
      */
     size_t slot_last;
 
+    /**
+     * Index of first unused slot
+     * @note equal to SIZE_MAX in case of full list
+     */
+    size_t slot_free;
+
+    /**
+     * Count of used slots
+     */
+    size_t length;
+
     /**
      * Pointer to the link-to-previous list linkage array
      */
@@ -106,6 +143,38 @@ typedef struct {
      */
     uni_common_array_t *arr_vals;
 
+    /**
+     * Pointer to the compact layout nodes array
+     * @note equal to NULL in case of separate link/key arrays
+     */
+    uni_common_array_t *arr_nodes;
+
+    /**
+     * Pointer to the optional key index array (hash table of slot numbers)
+     * @note equal to NULL in case of full scan key lookup
+     */
+    uni_common_array_t *arr_index;
+
+    /**
+     * Pointer to the optional rank tree array (Fenwick tree of used list positions)
+     * @note equal to NULL in case of list walk positional lookup
+     */
+    uni_common_array_t *arr_rank_tree;
+
+    /**
+     * Pointer to the rank position-to-slot array
+     */
+    uni_common_array_t *arr_rank_slots;
+
+    /**
+     * Pointer to the rank slot-to-position array
+     */
+    uni_common_array_t *arr_rank_stamps;
+
+    /**
+     * Next free rank position, positions are renumbered when it reaches the rank tree length
+     */
+    size_t rank_stamp_next;
 
     /**
      * Flags which stores the initialization state
@@ -134,6 +203,45 @@ bool uni_common_lrumap_init(uni_common_lrumap_context_t *ctx, uni_common_array_t
                         uni_common_array_t *arr_keys, uni_common_array_t *arr_vals);
 
 
+/**
+ * Initializes LRU map with the compact layout
+ * @param ctx pointer to the LRU map context
+ * @param arr_nodes pointer to the array of nodes (key and links of every slot)
+ * @param arr_vals pointer to the array of map values
+ * @note :arr_nodes element size will be changed to sizeof(uni_common_lrumap_node_t), buffer must be suitably aligned
+ * @note LRU-map slot count is min(arr_nodes.length(), arr_values.length(), UINT32_MAX)
+ * @return true on success
+ */
+bool uni_common_lrumap_init_compact(uni_common_lrumap_context_t *ctx, uni_common_array_t *arr_nodes, uni_common_array_t *arr_vals);
+
+
+/**
+ * Attaches key index to the LRU-map
+ * @param ctx pointer to the LRU-map context
+ * @param arr_index pointer to the index array, NULL to detach index and return to the full scan
+ * @note :arr_index element size will be changed to sizeof(size_t)
+ * @note :arr_index length must be greater than LRU-map capacity, 2x capacity keeps probe sequences short
+ * @note index is rebuilt from the current LRU-map content
+ * @return true on success
+ */
+bool uni_common_lrumap_set_index(uni_common_lrumap_context_t *ctx, uni_common_array_t *arr_index);
+
+
+/**
+ * Attaches rank tree to the LRU-map
+ * @param ctx pointer to the LRU-map context
+ * @param arr_rank_tree pointer to the rank tree array, NULL to detach rank tree and return to the list walk
+ * @param arr_rank_slots pointer to the position-to-slot array, must have the same length as :arr_rank_tree
+ * @param arr_rank_stamps pointer to the slot-to-position array, must have at least LRU-map capacity elements
+ * @note element size of all arrays will be changed to sizeof(size_t)
+ * @note :arr_rank_tree length must be greater than LRU-map capacity, with 2x capacity the positions are renumbered
+ * once per capacity updates, so the amortized cost stays O(1)
+ * @return true on success
+ */
+bool uni_common_lrumap_set_rank(uni_common_lrumap_context_t *ctx, uni_common_array_t *arr_rank_tree,
+                                uni_common_array_t *arr_rank_slots, uni_common_array_t *arr_rank_stamps);
+
+
 //
 // Functions/Getter
 //
@@ -169,6 +277,7 @@ bool uni_common_lrumap_initialized(const uni_common_lrumap_context_t *ctx);
  * @return numbe of used slots
  *
  * @note use :uni_common_lrumap_capacity to get total number of slots
+ * @note O(1), the counter is maintained by update/remove
  */
 size_t uni_common_lrumap_length(const uni_common_lrumap_context_t *ctx);
 
@@ -223,6 +332,7 @@ uint8_t *uni_common_lrumap_get_last(uni_common_lrumap_context_t *ctx);
  * @param idx idx to get
  * @param key pointer which will contain key content
  * @param val pointer which will contain cal content
+ * @note O(log n) with the rank tree attached, otherwise list is walked from the nearest end
  * @return true on success
  */
 bool uni_common_lrumap_get_idx(uni_common_lrumap_context_t *ctx, size_t idx, size_t *key, void *val);
@@ -3,8 +3,21 @@
 /**
  * Map implementation
  *
+ * modes:
+ *   * linear -- keys are searched by the full scan of keys array, O(capacity)
+ *   * hash -- open addressing with linear probing and backward-shift deletion, expected O(1)
+ *   * swiss -- open addressing over groups of 16 slots with the parallel array of control bytes (7-bit hash
+ *     fragment or empty/deleted marker), one SSE2/NEON compare tests the whole group, so probe sequences stay
+ *     short up to 87.5% load factor at the cost of one byte per slot
+ *
+ * optional occupancy bitmap (one bit per slot) lets enumeration and empty slot search skip 64 slots per word, so
+ * their cost follows the map size instead of the capacity
+ *
+ * growth: map can be migrated into the larger caller-provided arrays without stopping, the old table is drained
+ * by a few slots on every modification while lookups consult both tables
+ *
  * data types:
- *   * key is size_t
+ *   * key is size_t, SIZE_MAX is reserved as empty slot marker
  *   * value is user-defined variable or struct
  */
 
@@ -47,6 +60,30 @@ uni_common_ARRAY_DECLARATION(name##_arr_keys     , size_t, count);
 uni_common_ARRAY_DECLARATION(name##_arr_vals     , type, count);                           \
 extern uni_common_map_context_t name##_ctx
 
+/**
+ * Number of keys which are hashed and prefetched together by the batch operations
+ */
+#if !defined(UNI_COMMON_MAP_BATCH_CHUNK)
+    #define UNI_COMMON_MAP_BATCH_CHUNK 16
+#endif
+
+/**
+ * Number of old table slots which are migrated by every modification
+ */
+#if !defined(UNI_COMMON_MAP_MIGRATE_STEP)
+    #define UNI_COMMON_MAP_MIGRATE_STEP 16
+#endif
+
+/**
+ * Number of slots in the group of swiss mode
+ */
+#define UNI_COMMON_MAP_SWISS_GROUP 16U
+
+/**
+ * Number of 64-bit words of the occupancy bitmap for the given capacity
+ */
+#define UNI_COMMON_MAP_OCCUPANCY_WORDS(capacity) (((capacity) + 63U) / 64U)
+
 
 
 //
@@ -61,6 +98,32 @@ extern uni_common_map_context_t name##_ctx
  */
 typedef void (*uni_common_map_enum_func_t)(size_t key, const void *val);
 
+
+/**
+ * Map lookup mode
+ */
+typedef enum {
+    /**
+     * Full scan of the keys array, the cheapest one for the small maps
+     */
+    UNI_COMMON_MAP_MODE_LINEAR = 0,
+
+    /**
+     * Open addressing hash table with linear probing
+     * @note keep load factor below ~0.8 to keep probe sequences short
+     */
+    UNI_COMMON_MAP_MODE_HASH,
+
+    /**
+     * Swiss-table: groups of UNI_COMMON_MAP_SWISS_GROUP slots probed by the control byte compare
+     * @note requires :ctrl array, capacity is rounded down to the multiple of the group size
+     * @note removal leaves tombstone only when the group has no empty slot, tombstones are reused by inserts and
+     * dropped by the in-place rehash once they exceed 1/16 of capacity
+     */
+    UNI_COMMON_MAP_MODE_SWISS,
+} uni_common_map_mode_t;
+
+
 typedef struct {
     /**
      * Pointer to the LRU-map keys array
@@ -71,6 +134,23 @@ typedef struct {
      * Pointer to the LRU-map values array
      */
      uni_common_array_t *vals;
+
+    /**
+     * Lookup mode
+     */
+    uni_common_map_mode_t mode;
+
+    /**
+     * Pointer to the control bytes array of swiss mode, NULL for other modes
+     * @note element size will be changed to 1
+     */
+    uni_common_array_t *ctrl;
+
+    /**
+     * Pointer to the optional occupancy bitmap array, NULL to scan the keys
+     * @note element size will be changed to sizeof(uint64_t), capacity is limited to 64 slots per element
+     */
+    uni_common_array_t *occupancy;
 } uni_common_map_config_t;
 
 
@@ -82,6 +162,11 @@ typedef struct {
 
     size_t capacity;
 
+    /**
+     * Count of the tombstones in swiss mode
+     */
+    size_t tombstones;
+
     /**
      * Flags which stores the initialization state
      */
@@ -90,9 +175,36 @@ typedef struct {
 } uni_common_map_state_t;
 
 
+/**
+ * Table which is drained by the migration
+ */
+typedef struct {
+    /**
+     * Configuration of the old table
+     */
+    uni_common_map_config_t config;
+
+    /**
+     * State of the old table, initialized while migration is in progress
+     */
+    uni_common_map_state_t state;
+
+    /**
+     * Number of visited old table slots, they are empty
+     */
+    size_t cursor;
+
+    /**
+     * First visited old table slot, slots are visited in descending (cyclic) order
+     */
+    size_t start;
+} uni_common_map_migration_t;
+
+
 typedef struct {
   uni_common_map_config_t config;
   uni_common_map_state_t state;
+  uni_common_map_migration_t migration;
 } uni_common_map_context_t;
 
 
@@ -113,6 +225,16 @@ typedef struct {
 bool uni_common_map_init(uni_common_map_context_t *ctx, uni_common_array_t *arr_keys, uni_common_array_t *arr_vals);
 
 
+/**
+ * Initializes map with the extended configuration
+ * @param ctx pointer to the map context
+ * @param config pointer to the map configuration, it is copied into the context
+ * @note :config.keys element size will be changed to sizeof(size_t)
+ * @return true on success
+ */
+bool uni_common_map_init_ex(uni_common_map_context_t *ctx, const uni_common_map_config_t *config);
+
+
 
 //
 // Functions/Getter
@@ -134,12 +256,21 @@ size_t uni_common_map_capacity(const uni_common_map_context_t *ctx);
 bool uni_common_map_initialized(const uni_common_map_context_t *ctx);
 
 
+/**
+ * Checks that migration into the new table is in progress
+ * @param ctx pointer to the map context
+ * @return true if old table still has entries
+ */
+bool uni_common_map_migrating(const uni_common_map_context_t *ctx);
+
+
 /**
  * Returns count of used LRU-map slots
  * @param ctx pointer to the LRU-map
  * @return numbe of used slots
  *
  * @note use :uni_common_map_capacity to get total number of slots
+ * @note includes entries of the old table during migration
  */
 size_t uni_common_map_size(const uni_common_map_context_t *ctx);
 
@@ -153,6 +284,8 @@ size_t uni_common_map_size(const uni_common_map_context_t *ctx);
  * Resets LRU-map to the initial state
  * @param ctx pointer to the LRU-map
  * @return true on success
+ *
+ * @note migration in progress is stopped, entries of the old table are dropped
  */
 bool uni_common_map_clear(uni_common_map_context_t *ctx);
 
@@ -162,6 +295,8 @@ bool uni_common_map_clear(uni_common_map_context_t *ctx);
  * @param ctx pointer to the LRU-map context
  * @param func pointer to the enumerator function
  * @return true on success
+ *
+ * @note O(size + capacity / 64) with the occupancy bitmap, O(capacity) otherwise
  */
 bool uni_common_map_enum(uni_common_map_context_t *ctx, uni_common_map_enum_func_t func);
 
@@ -175,6 +310,21 @@ bool uni_common_map_enum(uni_common_map_context_t *ctx, uni_common_map_enum_func
 uint8_t *uni_common_map_get(uni_common_map_context_t *ctx, size_t key);
 
 
+/**
+ * Looks up several keys at once
+ * @param ctx pointer to the map context
+ * @param keys pointer to the keys array
+ * @param count number of keys
+ * @param vals pointer to the output array of :count value pointers, NULL for the missing keys
+ * @return number of found keys
+ *
+ * @note in hash and swiss modes keys are hashed and their slots are prefetched in chunks of UNI_COMMON_MAP_BATCH_CHUNK
+ * before they are probed, so the cache misses of the chunk overlap instead of following each other; linear mode falls
+ * back to the scalar lookup
+ */
+size_t uni_common_map_get_batch(uni_common_map_context_t *ctx, const size_t *keys, size_t count, uint8_t **vals);
+
+
 /**
  * Removes element with the given key from the LRU-map
  * @param ctx pointer to the LRU-map context
@@ -194,6 +344,51 @@ bool uni_common_map_remove(uni_common_map_context_t *ctx, size_t key);
 bool uni_common_map_set(uni_common_map_context_t *ctx, size_t key, const void *val);
 
 
+/**
+ * Inserts or updates several elements at once
+ * @param ctx pointer to the map context
+ * @param keys pointer to the keys array
+ * @param count number of keys
+ * @param vals pointer to the packed array of :count values, every value has the item size of the values array
+ * @return number of set elements
+ *
+ * @note elements are set in order, the result is the same as with the loop of uni_common_map_set
+ * @note in hash and swiss modes slots are prefetched in chunks as in :uni_common_map_get_batch; linear mode falls back
+ * to the scalar lookup
+ */
+size_t uni_common_map_set_batch(uni_common_map_context_t *ctx, const size_t *keys, size_t count, const void *vals);
+
+
+/**
+ * Starts migration into the new table
+ * @param ctx pointer to the map context
+ * @param table pointer to the initialized empty map which provides the new table, its arrays must not overlap with
+ * the current ones
+ * @return true on success, false if migration is already in progress, new table is too small or overlaps
+ *
+ * @note O(1), the new table arrays are cleared by its :uni_common_map_init_ex, which may run outside of the
+ * latency-sensitive path
+ * @note new table becomes the map capacity immediately, entries are moved by UNI_COMMON_MAP_MIGRATE_STEP slots on
+ * every set/remove and by :uni_common_map_migrate_step, so no single operation pays for the whole rehash
+ * @note get/remove/enum consult both tables, new keys are inserted into the new table only
+ * @note values element size of both tables must be the same, mode may differ
+ * @note :table context is not used after the call, old arrays may be reused once :uni_common_map_migrating
+ * returns false
+ */
+bool uni_common_map_migrate(uni_common_map_context_t *ctx, const uni_common_map_context_t *table);
+
+
+/**
+ * Moves entries of the old table into the new one
+ * @param ctx pointer to the map context
+ * @param slots maximum number of old table slots to visit
+ * @return number of moved entries
+ *
+ * @note lets read-mostly callers finish the migration in the idle time
+ */
+size_t uni_common_map_migrate_step(uni_common_map_context_t *ctx, size_t slots);
+
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,169 @@
+#pragma once
+
+/**
+ * Read-mostly concurrent map (uni_common_map guarded by the sequence lock)
+ *
+ * behavior:
+ *  * any number of threads read concurrently, readers never write shared memory, so the sequence counter stays
+ *    in the shared state of every core cache and reads scale with the number of cores
+ *  * reader copies the value out and retries when a writer was active during the copy, readers never block writers
+ *    and a reader is delayed only by the write which overlaps with it
+ *  * writers are serialized by compare-and-swap on the sequence counter, writes are expected to be rare (configs,
+ *    routing tables)
+ *
+ * data storage:
+ *  * uni_common_map in any mode with caller-provided arrays, see uni_common_map.h
+ *  * sequence counter is even while the map is stable and odd while the writer modifies it, it lives on its own
+ *    cache line
+ *  * values are returned by copy, pointers into the map are never handed out because the writer may reuse the slot
+ */
+
+//
+// Includes
+//
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_compiler.h"
+#include "uni_common_map.h"
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Typedefs
+//
+
+/**
+ * Read-mostly map context structure
+ */
+typedef struct {
+    /**
+     * Sequence counter, odd while the write is in progress
+     */
+    _Atomic(size_t) sequence UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * Guarded map
+     */
+    uni_common_map_context_t map UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+} uni_common_map_seqlock_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes read-mostly map
+ * @param ctx pointer to the read-mostly map context
+ * @param config pointer to the map configuration, see uni_common_map_init_ex()
+ * @return true on success
+ *
+ * @note must not race with the other functions
+ */
+bool uni_common_map_seqlock_init(uni_common_map_seqlock_context_t *ctx, const uni_common_map_config_t *config);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns map capacity
+ * @param ctx pointer to the read-mostly map context
+ * @return number of slots, 0 on invalid context
+ */
+size_t uni_common_map_seqlock_capacity(const uni_common_map_seqlock_context_t *ctx);
+
+
+/**
+ * Checks that read-mostly map was initialized
+ * @param ctx pointer to the read-mostly map context
+ * @return true if map was properly initialized
+ */
+bool uni_common_map_seqlock_initialized(const uni_common_map_seqlock_context_t *ctx);
+
+
+/**
+ * Returns number of stored elements
+ * @param ctx pointer to the read-mostly map context
+ * @return number of elements, consistent with the state after some write
+ */
+size_t uni_common_map_seqlock_size(const uni_common_map_seqlock_context_t *ctx);
+
+
+/**
+ * Returns map version
+ * @param ctx pointer to the read-mostly map context
+ * @return number of completed writes, readers may use it to validate the data derived from the map
+ */
+size_t uni_common_map_seqlock_version(const uni_common_map_seqlock_context_t *ctx);
+
+
+//
+// Functions/Process
+//
+
+/**
+ * Removes all elements
+ * @param ctx pointer to the read-mostly map context
+ * @return true on success
+ */
+bool uni_common_map_seqlock_clear(uni_common_map_seqlock_context_t *ctx);
+
+
+/**
+ * Copies value of the element with the given key
+ * @param ctx pointer to the read-mostly map context
+ * @param key map item key
+ * @param val pointer to the value buffer, must be >= value element size, may be NULL to check the presence only
+ * @return true if element exists
+ *
+ * @note :val may be overwritten by the retried attempt even when false is returned
+ */
+bool uni_common_map_seqlock_get(const uni_common_map_seqlock_context_t *ctx, size_t key, void *val);
+
+
+/**
+ * Removes element with the given key
+ * @param ctx pointer to the read-mostly map context
+ * @param key key to remove
+ * @return true on success (element was removed)
+ */
+bool uni_common_map_seqlock_remove(uni_common_map_seqlock_context_t *ctx, size_t key);
+
+
+/**
+ * Inserts or updates the element
+ * @param ctx pointer to the read-mostly map context
+ * @param key element key
+ * @param val pointer to the element value
+ * @return true on success
+ */
+bool uni_common_map_seqlock_set(uni_common_map_seqlock_context_t *ctx, size_t key, const void *val);
+
+
+/**
+ * Inserts or updates the elements within one write
+ * @param ctx pointer to the read-mostly map context
+ * @param keys pointer to the keys
+ * @param count number of keys
+ * @param vals pointer to the values, packed by the value element size
+ * @return number of stored elements
+ *
+ * @note readers see either none or all of the updates
+ */
+size_t uni_common_map_seqlock_set_batch(uni_common_map_seqlock_context_t *ctx, const size_t *keys, size_t count,
+                                        const void *vals);
+
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,224 @@
+#pragma once
+
+/**
+ * Lock-striped concurrent map (independent uni_common_map shards)
+ *
+ * behavior:
+ *  * key space is split across the shards by the key hash, every shard is a separate uni_common_map with its own
+ *    lock, so threads which touch different shards never wait for each other
+ *  * lock is test-and-test-and-set spinlock, waiter spins on the shared cache line and yields the CPU after
+ *    UNI_COMMON_MAP_SHARDED_SPIN attempts
+ *  * operations on the single key are linearizable, size and enum visit the shards one by one and are not a snapshot
+ *    of the whole map
+ *  * enum_shard lets the caller enumerate the shards from several threads in parallel
+ *
+ * data storage:
+ *  * caller-provided array of shards, every shard occupies its own cache lines, so the locks do not share a line
+ *  * every shard has its own caller-provided keys/values arrays, see uni_common_map.h, the shard capacity limits the
+ *    number of keys which hash into that shard
+ *  * values are returned by copy, pointers into the map are never handed out because the shard is unlocked on return
+ */
+
+//
+// Includes
+//
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_compiler.h"
+#include "uni_common_map.h"
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Defines
+//
+
+#if !defined(UNI_COMMON_MAP_SHARDED_SPIN)
+/**
+ * Number of busy-wait iterations on the locked shard before the waiter starts yielding
+ */
+#define UNI_COMMON_MAP_SHARDED_SPIN 64U
+#endif
+
+
+//
+// Typedefs
+//
+
+/**
+ * Map shard
+ */
+typedef struct {
+    /**
+     * Shard lock, non-zero while locked
+     */
+    _Atomic(uint32_t) lock;
+
+    /**
+     * Shard map, guarded by the lock
+     */
+    uni_common_map_context_t map;
+} UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE) uni_common_map_shard_t;
+
+
+/**
+ * Sharded map context structure
+ */
+typedef struct {
+    /**
+     * Pointer to the shards array
+     */
+    uni_common_map_shard_t *shards;
+
+    /**
+     * Number of shards
+     */
+    size_t shard_count;
+
+    /**
+     * Flags which stores the initialization state
+     */
+    bool initialized;
+} uni_common_map_sharded_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes sharded map
+ * @param ctx pointer to the sharded map context
+ * @param shards pointer to the array of shards
+ * @param configs pointer to the shard configurations, one per shard, see uni_common_map_init_ex()
+ * @param shard_count number of shards
+ * @return true on success
+ *
+ * @note all shards must use the same value element size
+ * @note must not race with the other functions
+ */
+bool uni_common_map_sharded_init(uni_common_map_sharded_context_t *ctx, uni_common_map_shard_t *shards,
+                                 const uni_common_map_config_t *configs, size_t shard_count);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns total capacity of the shards
+ * @param ctx pointer to the sharded map context
+ * @return number of slots, 0 on invalid context
+ */
+size_t uni_common_map_sharded_capacity(const uni_common_map_sharded_context_t *ctx);
+
+
+/**
+ * Checks that sharded map was initialized
+ * @param ctx pointer to the sharded map context
+ * @return true if map was properly initialized
+ */
+bool uni_common_map_sharded_initialized(const uni_common_map_sharded_context_t *ctx);
+
+
+/**
+ * Returns shard of the key
+ * @param ctx pointer to the sharded map context
+ * @param key map item key
+ * @return shard index, SIZE_MAX on invalid context
+ */
+size_t uni_common_map_sharded_shard(const uni_common_map_sharded_context_t *ctx, size_t key);
+
+
+/**
+ * Returns number of shards
+ * @param ctx pointer to the sharded map context
+ * @return number of shards, 0 on invalid context
+ */
+size_t uni_common_map_sharded_shard_count(const uni_common_map_sharded_context_t *ctx);
+
+
+/**
+ * Returns number of stored elements
+ * @param ctx pointer to the sharded map context
+ * @return sum of the shard sizes, every shard is counted under its lock
+ */
+size_t uni_common_map_sharded_size(uni_common_map_sharded_context_t *ctx);
+
+
+//
+// Functions/Process
+//
+
+/**
+ * Removes all elements
+ * @param ctx pointer to the sharded map context
+ * @return true on success
+ */
+bool uni_common_map_sharded_clear(uni_common_map_sharded_context_t *ctx);
+
+
+/**
+ * Enumerates all shards one by one
+ * @param ctx pointer to the sharded map context
+ * @param func pointer to the enumerator function
+ * @return true on success
+ *
+ * @note the shard is locked while its elements are enumerated, :func must not call the sharded map functions
+ */
+bool uni_common_map_sharded_enum(uni_common_map_sharded_context_t *ctx, uni_common_map_enum_func_t func);
+
+
+/**
+ * Enumerates the single shard
+ * @param ctx pointer to the sharded map context
+ * @param shard shard index
+ * @param func pointer to the enumerator function
+ * @return true on success
+ *
+ * @note different shards may be enumerated from different threads in parallel
+ * @note the shard is locked while its elements are enumerated, :func must not call the sharded map functions
+ */
+bool uni_common_map_sharded_enum_shard(uni_common_map_sharded_context_t *ctx, size_t shard, uni_common_map_enum_func_t func);
+
+
+/**
+ * Copies value of the element with the given key
+ * @param ctx pointer to the sharded map context
+ * @param key map item key
+ * @param val pointer to the value buffer, must be >= value element size, may be NULL to check the presence only
+ * @return true if element exists
+ */
+bool uni_common_map_sharded_get(uni_common_map_sharded_context_t *ctx, size_t key, void *val);
+
+
+/**
+ * Removes element with the given key
+ * @param ctx pointer to the sharded map context
+ * @param key key to remove
+ * @return true on success (element was removed)
+ */
+bool uni_common_map_sharded_remove(uni_common_map_sharded_context_t *ctx, size_t key);
+
+
+/**
+ * Inserts or updates the element
+ * @param ctx pointer to the sharded map context
+ * @param key element key
+ * @param val pointer to the element value
+ * @return true on success, false when the shard of the key is full
+ */
+bool uni_common_map_sharded_set(uni_common_map_sharded_context_t *ctx, size_t key, const void *val);
+
+
+#if defined(__cplusplus)
+}
+#endif
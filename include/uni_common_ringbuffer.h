@@ -13,6 +13,8 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "uni_common_compiler.h"
+
 
 //
 // Typedefs
@@ -41,16 +43,50 @@ typedef struct {
 
     /**
      * Current front position in bytes
+     *
+     * @note in power-of-two mode it is free-running counter of popped objects
      */
     size_t pos_front;
 
     /**
      * Current back position in bytes
+     *
+     * @note in power-of-two mode it is free-running counter of pushed objects
      */
     size_t pos_back;
+
+    /**
+     * Object index mask of power-of-two mode (capacity in objects - 1)
+     *
+     * @note equal to 0 in classic mode, where one object slot is always kept free
+     */
+    size_t mask;
+
+    /**
+     * Flag which shows that data array is mapped twice back to back (see uni_common_ringbuffer_mirror.h)
+     *
+     * @note when set, every region returned by reserve/peek/view is contiguous
+     */
+    bool mirrored;
 } uni_common_ringbuffer_context_t;
 
 
+/**
+ * Contiguous region of stored ringbuffer objects
+ */
+typedef struct {
+    /**
+     * pointer to the first object of region inside ringbuffer data array
+     */
+    const uint8_t *data;
+
+    /**
+     * number of objects in region
+     */
+    size_t count;
+} uni_common_ringbuffer_span_t;
+
+
 //
 // Defines
 //
@@ -63,6 +99,21 @@ uni_common_ringbuffer_context_t name##_ctx = {                \
     .size_total = sizeof(type)*(count+1),                 \
     .pos_front = 0U,                                      \
     .pos_back = 0U,                                       \
+    .mask = 0U,                                           \
+    .mirrored = false,                                    \
+}
+
+#define UNI_COMMON_RINGBUFFER_DEFINITION_POW2(name, type, count)                                            \
+UNI_COMMON_COMPILER_STATIC_ASSERT((count) >= 2 && ((count) & ((count) - 1)) == 0, "count must be power of two"); \
+type name##_buf[count] = {0};                                                                              \
+uni_common_ringbuffer_context_t name##_ctx = {                                                             \
+    .data = (uint8_t*)name##_buf,                                                                          \
+    .size_object = sizeof(type),                                                                           \
+    .size_total = sizeof(type)*(count),                                                                    \
+    .pos_front = 0U,                                                                                       \
+    .pos_back = 0U,                                                                                        \
+    .mask = (count) - 1U,                                                                                  \
+    .mirrored = false,                                                                                     \
 }
 
 #define UNI_COMMON_RINGBUFFER_DECLARATION(name) extern uni_common_ringbuffer_context_t name##_ctx
@@ -82,6 +133,20 @@ uni_common_ringbuffer_context_t name##_ctx = {                \
 bool uni_common_ringbuffer_init(uni_common_ringbuffer_context_t *ctx, uint8_t *data, uint32_t size_object, uint32_t size_total);
 
 
+/**
+ * Initializes the ringbuffer in power-of-two mode
+ * @param ctx pointer to the ringbuffer context
+ * @param data pointer to the data buffer
+ * @param size_object size of one object inside the ringbuffer
+ * @param size_total total size of ringbuffer, size_total / size_object must be power of two and at least 2
+ * @return true on success
+ *
+ * @note positions are free-running counters masked on access, so no division is done per object and
+ * all size_total / size_object slots are usable
+ */
+bool uni_common_ringbuffer_init_pow2(uni_common_ringbuffer_context_t *ctx, uint8_t *data, uint32_t size_object, uint32_t size_total);
+
+
 //
 // Functions/Getters
 //
@@ -92,6 +157,8 @@ bool uni_common_ringbuffer_init(uni_common_ringbuffer_context_t *ctx, uint8_t *d
  * @param index element index
  * @param data received buffer, must have size of one ringbuffer object
  * @return true on success
+ *
+ * @note O(1)
  */
 bool uni_common_ringbuffer_get(const uni_common_ringbuffer_context_t *ctx, size_t index, uint8_t *data);
 
@@ -108,6 +175,18 @@ bool uni_common_ringbuffer_get(const uni_common_ringbuffer_context_t *ctx, size_
 size_t uni_common_ringbuffer_find(const uni_common_ringbuffer_context_t *ctx, const uint8_t *data);
 
 
+/**
+ * Returns stored objects as contiguous regions of the data array, from the oldest to the newest
+ * @param ctx pointer to the ringbuffer context
+ * @param spans pointer to the array of two spans, the first one starts at the front, the second one (if any)
+ * continues from the start of data array
+ * @return number of non-empty spans: 0, 1 or 2
+ *
+ * @note spans are valid until the next modification of ringbuffer
+ */
+size_t uni_common_ringbuffer_view(const uni_common_ringbuffer_context_t *ctx, uni_common_ringbuffer_span_t *spans);
+
+
 /**
  * Check that ringbuffer is empty
  * @param ctx pointer to the ringbuffer context
@@ -147,9 +226,11 @@ bool uni_common_ringbuffer_clear(uni_common_ringbuffer_context_t *ctx);
 /**
  * Pops specified number of objects from ringbuffer
  * @param ctx pointer to the ringbuffer context
- * @param data receive buffer, must be >= count * ctx->size_object
+ * @param data receive buffer, must be >= count * ctx->size_object, NULL to drop objects without copy
  * @param count number of objects to pop
  * @return number of returned objects objects
+ *
+ * @note objects are copied with at most two memcpy calls (before and after the wrap point)
  */
 size_t uni_common_ringbuffer_pop(uni_common_ringbuffer_context_t *ctx, uint8_t *data, size_t count);
 
@@ -161,10 +242,73 @@ size_t uni_common_ringbuffer_pop(uni_common_ringbuffer_context_t *ctx, uint8_t *
  * @return number of pushed objects
  *
  * @note size of buffer must be greater or equal to ctx->size_object
+ * @note the oldest objects are overwritten when ringbuffer is full
  */
 size_t uni_common_ringbuffer_push(uni_common_ringbuffer_context_t *ctx, const uint8_t *data, size_t count);
 
 
+/**
+ * Pushes specified number of objects into ringbuffer
+ * @param ctx pointer to the ringbuffer context
+ * @param data pointer to the send buffer, must be >= count * ctx->size_object
+ * @param count number of objects to push
+ * @param overwrite true to overwrite the oldest objects when ringbuffer is full, false to push only to the free slots
+ * @return number of pushed objects, less than :count without :overwrite when ringbuffer has not enough free slots
+ *
+ * @note objects are copied with at most two memcpy calls (before and after the wrap point)
+ */
+size_t uni_common_ringbuffer_push_ex(uni_common_ringbuffer_context_t *ctx, const uint8_t *data, size_t count, bool overwrite);
+
+
+//
+// Functions/Zero-copy
+//
+
+/**
+ * Reserves contiguous region of free slots at the back of ringbuffer for the in-place write
+ * @param ctx pointer to the ringbuffer context
+ * @param count number of objects requested
+ * @param data pointer which receives start of the region inside ctx->data
+ * @return number of objects in the region, may be less than :count at the wrap point or when ringbuffer has not
+ * enough free slots
+ *
+ * @note the region becomes part of ringbuffer only after :uni_common_ringbuffer_commit
+ * @note never overwrites the stored objects
+ */
+size_t uni_common_ringbuffer_reserve(uni_common_ringbuffer_context_t *ctx, size_t count, uint8_t **data);
+
+
+/**
+ * Appends objects written into the reserved region to the ringbuffer
+ * @param ctx pointer to the ringbuffer context
+ * @param count number of written objects
+ * @return number of committed objects, limited by the region which :uni_common_ringbuffer_reserve can return
+ */
+size_t uni_common_ringbuffer_commit(uni_common_ringbuffer_context_t *ctx, size_t count);
+
+
+/**
+ * Returns contiguous region of stored objects at the front of ringbuffer for the in-place read
+ * @param ctx pointer to the ringbuffer context
+ * @param count number of objects requested
+ * @param data pointer which receives start of the region inside ctx->data
+ * @return number of objects in the region, may be less than :count at the wrap point or when ringbuffer has less
+ * objects
+ *
+ * @note objects stay in ringbuffer until :uni_common_ringbuffer_consume
+ */
+size_t uni_common_ringbuffer_peek(const uni_common_ringbuffer_context_t *ctx, size_t count, const uint8_t **data);
+
+
+/**
+ * Drops objects from the front of ringbuffer after the in-place read
+ * @param ctx pointer to the ringbuffer context
+ * @param count number of objects to drop
+ * @return number of dropped objects
+ */
+size_t uni_common_ringbuffer_consume(uni_common_ringbuffer_context_t *ctx, size_t count);
+
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,184 @@
+#pragma once
+
+/**
+ * Single-writer/multi-reader broadcast ringbuffer (disruptor-like)
+ *
+ * behavior:
+ *  * one thread pushes, any number of readers read every object through their own cursors, objects are never popped
+ *  * writer never waits for readers, it overwrites the oldest objects
+ *  * reader which was overtaken by the writer (lapped) skips to the oldest available object and the number of missed
+ *    objects is added to its cursor
+ *
+ * data storage:
+ *  * caller-provided data buffer of size_object-sized objects, object capacity must be power of two
+ *  * pos_back is free-running counter of published objects, cursors are free-running counters of read objects
+ *  * pos_claim is the end of the batch which is being written, together with pos_back it works as seqlock over the
+ *    whole ring: reader copies a run of objects and then drops the ones which the writer could have overwritten
+ *    during the copy, so both sides copy whole runs instead of the objects one by one
+ */
+
+//
+// Includes
+//
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_compiler.h"
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Typedefs
+//
+
+/**
+ * Broadcast ringbuffer context structure
+ */
+typedef struct {
+    /**
+     * Back position (counter of published objects), written by the writer
+     */
+    _Atomic(size_t) pos_back UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * Claim position (end of the batch which is being written), written by the writer before the data
+     */
+    _Atomic(size_t) pos_claim;
+
+    /**
+     * pointer to ringbuffer data array
+     */
+    uint8_t *data UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * size of one object in bytes
+     */
+    size_t size_object;
+
+    /**
+     * Object index mask (capacity in objects - 1)
+     */
+    size_t mask;
+} uni_common_ringbuffer_broadcast_context_t;
+
+
+/**
+ * Broadcast ringbuffer reader cursor
+ *
+ * @note every reader thread owns its cursor, cursors must not be shared
+ */
+typedef struct {
+    /**
+     * Position of the next object to read
+     */
+    size_t pos;
+
+    /**
+     * Number of objects which were overwritten before the reader got them
+     */
+    size_t lost;
+} uni_common_ringbuffer_broadcast_cursor_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes the broadcast ringbuffer
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param data pointer to the data buffer
+ * @param size_object size of one object inside the ringbuffer
+ * @param size_total total size of data buffer, size_total / size_object must be power of two
+ * @return true on success
+ *
+ * @note must not race with push/read
+ */
+bool uni_common_ringbuffer_broadcast_init(uni_common_ringbuffer_broadcast_context_t *ctx, uint8_t *data, size_t size_object,
+                                          size_t size_total);
+
+
+/**
+ * Initializes reader cursor
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param cursor pointer to the cursor
+ * @param oldest true to start from the oldest available object, false to start from the next pushed object
+ * @return true on success
+ */
+bool uni_common_ringbuffer_broadcast_cursor_init(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                                 uni_common_ringbuffer_broadcast_cursor_t *cursor, bool oldest);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns broadcast ringbuffer capacity
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @return number of objects which are kept for readers
+ */
+size_t uni_common_ringbuffer_broadcast_capacity(const uni_common_ringbuffer_broadcast_context_t *ctx);
+
+
+/**
+ * Number of objects which are not read by the cursor yet
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param cursor pointer to the cursor
+ * @return number of objects, greater than capacity when the cursor was lapped
+ */
+size_t uni_common_ringbuffer_broadcast_pending(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                               const uni_common_ringbuffer_broadcast_cursor_t *cursor);
+
+
+/**
+ * Checks that cursor was lapped by the writer and the next read will skip objects
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param cursor pointer to the cursor
+ * @return true if some unread objects were already overwritten
+ */
+bool uni_common_ringbuffer_broadcast_lapped(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                            const uni_common_ringbuffer_broadcast_cursor_t *cursor);
+
+
+//
+// Functions/Operations
+//
+
+/**
+ * Pushes specified number of objects, must be called only from the writer thread
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param data pointer to the send buffer, must be >= count * ctx->size_object
+ * @param count number of objects to push
+ * @return number of pushed objects
+ *
+ * @note the oldest objects are overwritten regardless of the reader cursors
+ */
+size_t uni_common_ringbuffer_broadcast_push(uni_common_ringbuffer_broadcast_context_t *ctx, const uint8_t *data, size_t count);
+
+
+/**
+ * Reads specified number of objects through the cursor
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param cursor pointer to the reader cursor
+ * @param data receive buffer, must be >= count * ctx->size_object
+ * @param count number of objects to read
+ * @return number of read objects
+ *
+ * @note when the cursor was lapped, it is moved to the oldest available object and cursor->lost is increased
+ * by the number of skipped objects
+ */
+size_t uni_common_ringbuffer_broadcast_read(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                            uni_common_ringbuffer_broadcast_cursor_t *cursor, uint8_t *data, size_t count);
+
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,288 @@
+#pragma once
+
+/**
+ * Crash-durable file backend of uni_common_ringbuffer
+ *
+ * behavior:
+ *  * data array and pos_front/pos_back live in the memory-mapped file, so the content survives the restart
+ *  * reopen is O(1): header is validated and positions are restored, nothing is replayed
+ *  * positions are persisted by commit, msync policy decides how much of the write-back it waits for
+ *
+ * data storage:
+ *  * file starts with the versioned header page, data array follows it
+ *  * header keeps two position slots with the sequence number and the checksum, commit writes the older one, so torn
+ *    header write falls back to the previous commit instead of the corrupted state
+ *  * memory is allocated by the backend, it must be released with :uni_common_ringbuffer_file_close
+ *
+ * supported platforms:
+ *  * Linux, on other platforms open returns false
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_ringbuffer.h"
+
+
+//
+// Defines
+//
+
+/**
+ * File magic ("UNIRBUF" followed by zero byte, little-endian)
+ */
+#define UNI_COMMON_RINGBUFFER_FILE_MAGIC 0x0046554252494E55ULL
+
+/**
+ * File layout version
+ */
+#define UNI_COMMON_RINGBUFFER_FILE_VERSION 1U
+
+
+//
+// Typedefs
+//
+
+/**
+ * Write-back policy
+ */
+typedef enum {
+    /**
+     * No msync, content survives the process crash, write-back is left to the kernel
+     */
+    UNI_COMMON_RINGBUFFER_FILE_SYNC_NONE = 0,
+
+    /**
+     * msync once per sync_period commits, at most sync_period commits are lost on the power failure
+     */
+    UNI_COMMON_RINGBUFFER_FILE_SYNC_PERIODIC,
+
+    /**
+     * msync of the data before and of the header after every commit
+     */
+    UNI_COMMON_RINGBUFFER_FILE_SYNC_COMMIT,
+} uni_common_ringbuffer_file_sync_t;
+
+
+/**
+ * Position slot of the file header
+ */
+typedef struct {
+    uint64_t pos_front;
+    uint64_t pos_back;
+
+    /**
+     * Commit sequence number, the valid slot with the greater one is used
+     */
+    uint64_t seq;
+
+    /**
+     * Checksum of the slot fields
+     */
+    uint64_t check;
+} uni_common_ringbuffer_file_slot_t;
+
+
+/**
+ * File header, stored at the beginning of the file
+ */
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+
+    /**
+     * Offset of the data array in bytes (page size of the creator)
+     */
+    uint32_t size_header;
+
+    uint32_t size_object;
+    uint32_t size_total;
+
+    /**
+     * Ringbuffer mode (object index mask of power-of-two mode, 0 for classic mode)
+     */
+    uint64_t mask;
+
+    uni_common_ringbuffer_file_slot_t slots[2];
+} uni_common_ringbuffer_file_header_t;
+
+
+/**
+ * File backend configuration
+ */
+typedef struct {
+    /**
+     * Path of the file, it is created when it does not exist
+     */
+    const char *path;
+
+    /**
+     * Size of one object inside the ringbuffer
+     */
+    uint32_t size_object;
+
+    /**
+     * Size of the data array, must be multiple of :size_object
+     */
+    uint32_t size_total;
+
+    /**
+     * Write-back policy
+     */
+    uni_common_ringbuffer_file_sync_t sync;
+
+    /**
+     * Number of commits between msyncs of the periodic policy, must be > 0 for it
+     */
+    uint32_t sync_period;
+} uni_common_ringbuffer_file_config_t;
+
+
+/**
+ * File backend context structure
+ */
+typedef struct {
+    /**
+     * Ringbuffer over the mapped data array, use it with the uni_common_ringbuffer_* functions
+     */
+    uni_common_ringbuffer_context_t ring;
+
+    /**
+     * Pointer to the mapped file header
+     */
+    uni_common_ringbuffer_file_header_t *header;
+
+    /**
+     * Size of the mapping in bytes
+     */
+    size_t size_map;
+
+    /**
+     * Sequence number of the last commit
+     */
+    uint64_t seq;
+
+    /**
+     * Write-back policy
+     */
+    uni_common_ringbuffer_file_sync_t sync;
+
+    /**
+     * Number of commits between msyncs of the periodic policy
+     */
+    uint32_t sync_period;
+
+    /**
+     * Commits left until the next msync of the periodic policy
+     */
+    uint32_t sync_countdown;
+
+    /**
+     * Number of done msyncs
+     */
+    size_t count_sync;
+
+    /**
+     * True when the content was restored from the existing file
+     */
+    bool restored;
+} uni_common_ringbuffer_file_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Opens or creates the ringbuffer file and maps it
+ * @param ctx pointer to the file backend context
+ * @param config pointer to the configuration
+ * @return true on success, false also when the existing file has different layout or parameters
+ *
+ * @note ringbuffer works in power-of-two mode when size_total / size_object is power of two, in classic mode otherwise
+ * @note existing file of the right size with the zero magic (crash during the creation) is initialized again
+ */
+bool uni_common_ringbuffer_file_open(uni_common_ringbuffer_file_context_t *ctx, const uni_common_ringbuffer_file_config_t *config);
+
+
+/**
+ * Commits the positions and unmaps the file
+ * @param ctx pointer to the file backend context
+ * @return true on success
+ */
+bool uni_common_ringbuffer_file_close(uni_common_ringbuffer_file_context_t *ctx);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns number of done msyncs
+ * @param ctx pointer to the file backend context
+ * @return number of msyncs
+ */
+size_t uni_common_ringbuffer_file_count_sync(const uni_common_ringbuffer_file_context_t *ctx);
+
+
+/**
+ * Checks that the content was restored from the existing file
+ * @param ctx pointer to the file backend context
+ * @return true if existing file was opened, false if new file was created
+ */
+bool uni_common_ringbuffer_file_is_restored(const uni_common_ringbuffer_file_context_t *ctx);
+
+
+//
+// Functions/Operations
+//
+
+/**
+ * Persists current ringbuffer positions according to the write-back policy
+ * @param ctx pointer to the file backend context
+ * @return true on success
+ *
+ * @note call it after the uni_common_ringbuffer_* operations on ctx->ring, objects pushed after the last commit are
+ * not visible after reopen
+ * @note overwriting push on ctx->ring reuses the slots which the last commit still covers, use
+ * :uni_common_ringbuffer_file_push to keep the content consistent after the crash
+ */
+bool uni_common_ringbuffer_file_commit(uni_common_ringbuffer_file_context_t *ctx);
+
+
+/**
+ * Pops objects and commits the positions
+ * @param ctx pointer to the file backend context
+ * @param data receive buffer, must be >= count * size_object, NULL to drop objects without copy
+ * @param count number of objects to pop
+ * @return number of returned objects
+ */
+size_t uni_common_ringbuffer_file_pop(uni_common_ringbuffer_file_context_t *ctx, uint8_t *data, size_t count);
+
+
+/**
+ * Pushes objects (overwriting the oldest ones) and commits the positions
+ * @param ctx pointer to the file backend context
+ * @param data pointer to the send buffer, must be >= count * size_object
+ * @param count number of objects to push
+ * @return number of pushed objects
+ *
+ * @note when the ringbuffer is full, the front moved past the dropped objects is committed before their slots are
+ * overwritten, so the crash at any point restores the objects in order without the mix of old and new ones
+ */
+size_t uni_common_ringbuffer_file_push(uni_common_ringbuffer_file_context_t *ctx, const uint8_t *data, size_t count);
+
+
+#if defined(__cplusplus)
+}
+#endif
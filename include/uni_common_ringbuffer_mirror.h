@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * Mirrored (double-mapped) backend of uni_common_ringbuffer
+ *
+ * behavior:
+ *  * the same memory pages are mapped twice, back to back, so the object at the end of data array continues
+ *    in the second mapping instead of wrapping to the start
+ *  * reserve/peek/view/push/pop never split regions, variable-length messages can be parsed in place
+ *
+ * data storage:
+ *  * memory is allocated by the backend (memfd on Linux) instead of the caller, it must be released with
+ *    :uni_common_ringbuffer_mirror_destroy
+ *  * size_total must be multiple of the page size
+ *
+ * supported platforms:
+ *  * Linux, on other platforms create returns false
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_ringbuffer.h"
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns granularity of the mirrored data array size
+ * @return page size in bytes, 0 if mirrored backend is not supported
+ */
+size_t uni_common_ringbuffer_mirror_granularity(void);
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Allocates mirrored data array and initializes the ringbuffer
+ * @param ctx pointer to the ringbuffer context
+ * @param size_object size of one object inside the ringbuffer
+ * @param size_total total size of ringbuffer, must be multiple of :uni_common_ringbuffer_mirror_granularity and
+ * of :size_object
+ * @return true on success
+ *
+ * @note ringbuffer works in power-of-two mode when size_total / size_object is power of two, in classic mode otherwise
+ */
+bool uni_common_ringbuffer_mirror_create(uni_common_ringbuffer_context_t *ctx, uint32_t size_object, uint32_t size_total);
+
+
+/**
+ * Releases mirrored data array
+ * @param ctx pointer to the ringbuffer context
+ * @return true on success
+ */
+bool uni_common_ringbuffer_mirror_destroy(uni_common_ringbuffer_context_t *ctx);
+
+
+#if defined(__cplusplus)
+}
+#endif
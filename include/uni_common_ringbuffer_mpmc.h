@@ -0,0 +1,156 @@
+#pragma once
+
+/**
+ * Lock-free multi-producer/multi-consumer bounded queue (D. Vyukov design)
+ *
+ * behavior:
+ *  * any number of threads push and pop concurrently, no locks are taken
+ *  * push never overwrites, it stops at the first object which does not fit (back-pressure)
+ *
+ * data storage:
+ *  * caller-provided data buffer of size_object-sized objects, object capacity must be power of two and at least 2
+ *  * caller-provided sequence array with one atomic counter per slot, the counter tells whether the slot is
+ *    ready for the producer or for the consumer of the given lap
+ *  * pos_front/pos_back are free-running object counters claimed with compare-and-swap, they live on separate
+ *    cache lines
+ */
+
+//
+// Includes
+//
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_compiler.h"
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Typedefs
+//
+
+/**
+ * MPMC queue context structure
+ */
+typedef struct {
+    /**
+     * Back position (counter of claimed push slots)
+     */
+    _Atomic(size_t) pos_back UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * Front position (counter of claimed pop slots)
+     */
+    _Atomic(size_t) pos_front UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * pointer to queue data array
+     */
+    uint8_t *data UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * pointer to the per-slot sequence array, must have capacity elements
+     */
+    _Atomic(size_t) *seqs;
+
+    /**
+     * size of one object in bytes
+     */
+    size_t size_object;
+
+    /**
+     * Object index mask (capacity in objects - 1)
+     */
+    size_t mask;
+} uni_common_ringbuffer_mpmc_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes the MPMC queue
+ * @param ctx pointer to the MPMC queue context
+ * @param data pointer to the data buffer
+ * @param seqs pointer to the sequence array, must have size_total / size_object elements
+ * @param size_object size of one object inside the queue
+ * @param size_total total size of data buffer, size_total / size_object must be power of two and at least 2
+ * @return true on success
+ *
+ * @note must not race with push/pop
+ */
+bool uni_common_ringbuffer_mpmc_init(uni_common_ringbuffer_mpmc_context_t *ctx, uint8_t *data, _Atomic(size_t) *seqs,
+                                     size_t size_object, size_t size_total);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns MPMC queue capacity
+ * @param ctx pointer to the MPMC queue context
+ * @return number of objects which can be stored
+ */
+size_t uni_common_ringbuffer_mpmc_capacity(const uni_common_ringbuffer_mpmc_context_t *ctx);
+
+
+/**
+ * Number of claimed elements in MPMC queue
+ * @param ctx pointer to the MPMC queue context
+ * @return number of elements, includes the ones which are being copied right now
+ *
+ * @note the value is approximate when it is called concurrently with push/pop
+ */
+size_t uni_common_ringbuffer_mpmc_length(const uni_common_ringbuffer_mpmc_context_t *ctx);
+
+
+//
+// Functions/Operations
+//
+
+/**
+ * Clears the MPMC queue
+ * @param ctx pointer to the MPMC queue context
+ * @return true on success
+ *
+ * @note must not race with push/pop
+ */
+bool uni_common_ringbuffer_mpmc_clear(uni_common_ringbuffer_mpmc_context_t *ctx);
+
+
+/**
+ * Pops specified number of objects from MPMC queue
+ * @param ctx pointer to the MPMC queue context
+ * @param data receive buffer, must be >= count * ctx->size_object
+ * @param count number of objects to pop
+ * @return number of returned objects, less than :count when queue became empty
+ *
+ * @note every object is claimed separately, so objects of concurrent pops may interleave
+ */
+size_t uni_common_ringbuffer_mpmc_pop(uni_common_ringbuffer_mpmc_context_t *ctx, uint8_t *data, size_t count);
+
+
+/**
+ * Pushes specified number of objects into MPMC queue
+ * @param ctx pointer to the MPMC queue context
+ * @param data pointer to the send buffer, must be >= count * ctx->size_object
+ * @param count number of objects to push
+ * @return number of pushed objects, less than :count when queue became full
+ *
+ * @note every object is claimed separately, so objects of concurrent pushes may interleave
+ */
+size_t uni_common_ringbuffer_mpmc_push(uni_common_ringbuffer_mpmc_context_t *ctx, const uint8_t *data, size_t count);
+
+
+#if defined(__cplusplus)
+}
+#endif
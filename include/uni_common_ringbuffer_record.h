@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+ * Variable-length record ringbuffer
+ *
+ * behavior:
+ *  * records of any size up to the buffer size are pushed and popped in FIFO order
+ *  * push either fails or drops the oldest records when there is not enough free space
+ *
+ * data storage:
+ *  * caller-provided byte buffer, every record is stored as a length header followed by the payload
+ *  * header and payload are padded to the alignment, so payload pointers returned by peek keep it
+ *  * records are never split, when the record does not fit before the end of buffer, the rest of buffer is marked as
+ *    padding and the record starts at the beginning
+ *  * pos_front/pos_back are byte offsets inside of the data array, size_used tells the empty and the full buffer apart
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+//
+// Typedefs
+//
+
+/**
+ * Record ringbuffer context structure
+ */
+typedef struct {
+    /**
+     * pointer to ringbuffer data array
+     */
+    uint8_t *data;
+
+    /**
+     * Total size of data array in bytes
+     *
+     * @note size_total % align must be == 0
+     */
+    size_t size_total;
+
+    /**
+     * Alignment of record headers and payloads in bytes
+     */
+    size_t align;
+
+    /**
+     * Current front position in bytes, [0, size_total)
+     */
+    size_t pos_front;
+
+    /**
+     * Current back position in bytes, [0, size_total)
+     */
+    size_t pos_back;
+
+    /**
+     * Number of bytes occupied by the records and the wrap padding
+     */
+    size_t size_used;
+
+    /**
+     * Number of stored records
+     */
+    size_t count;
+} uni_common_ringbuffer_record_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes the record ringbuffer
+ * @param ctx pointer to the record ringbuffer context
+ * @param data pointer to the data buffer, must be aligned to :align
+ * @param size_total size of the data buffer, must be multiple of :align
+ * @param align alignment of the payloads, must be power of two, values below sizeof(uint32_t) are raised to it
+ * @return true on success
+ */
+bool uni_common_ringbuffer_record_init(uni_common_ringbuffer_record_context_t *ctx, uint8_t *data, size_t size_total, size_t align);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Number of stored records
+ * @param ctx pointer to the record ringbuffer context
+ * @return number of records
+ */
+size_t uni_common_ringbuffer_record_count(const uni_common_ringbuffer_record_context_t *ctx);
+
+
+/**
+ * Check that record ringbuffer is empty
+ * @param ctx pointer to the record ringbuffer context
+ * @return true if ringbuffer is empty
+ */
+bool uni_common_ringbuffer_record_is_empty(const uni_common_ringbuffer_record_context_t *ctx);
+
+
+/**
+ * Returns the biggest record size which can ever be pushed
+ * @param ctx pointer to the record ringbuffer context
+ * @return size in bytes
+ */
+size_t uni_common_ringbuffer_record_size_max(const uni_common_ringbuffer_record_context_t *ctx);
+
+
+/**
+ * Number of used bytes, including headers, alignment and wrap padding
+ * @param ctx pointer to the record ringbuffer context
+ * @return used bytes
+ */
+size_t uni_common_ringbuffer_record_used(const uni_common_ringbuffer_record_context_t *ctx);
+
+
+//
+// Functions/Operations
+//
+
+/**
+ * Clears the record ringbuffer
+ * @param ctx pointer to the record ringbuffer context
+ * @return true on success
+ */
+bool uni_common_ringbuffer_record_clear(uni_common_ringbuffer_record_context_t *ctx);
+
+
+/**
+ * Returns the oldest record without removing it
+ * @param ctx pointer to the record ringbuffer context
+ * @param data pointer which receives start of the payload inside ctx->data
+ * @param size pointer which receives payload size
+ * @return true on success, false if ringbuffer is empty
+ *
+ * @note payload is valid until the next pop or push
+ */
+bool uni_common_ringbuffer_record_peek(const uni_common_ringbuffer_record_context_t *ctx, const uint8_t **data, size_t *size);
+
+
+/**
+ * Removes the oldest record
+ * @param ctx pointer to the record ringbuffer context
+ * @param data receive buffer, NULL to drop the record without copy
+ * @param data_size size of the receive buffer
+ * @param size pointer which receives payload size, may be NULL
+ * @return true on success, false if ringbuffer is empty or the record does not fit into :data_size (it stays
+ * in ringbuffer then)
+ */
+bool uni_common_ringbuffer_record_pop(uni_common_ringbuffer_record_context_t *ctx, uint8_t *data, size_t data_size, size_t *size);
+
+
+/**
+ * Appends record
+ * @param ctx pointer to the record ringbuffer context
+ * @param data pointer to the payload
+ * @param size payload size, must not exceed :uni_common_ringbuffer_record_size_max
+ * @param overwrite true to drop the oldest records when there is not enough free space
+ * @return true on success
+ */
+bool uni_common_ringbuffer_record_push(uni_common_ringbuffer_record_context_t *ctx, const uint8_t *data, size_t size, bool overwrite);
+
+
+#if defined(__cplusplus)
+}
+#endif
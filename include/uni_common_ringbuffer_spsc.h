@@ -0,0 +1,166 @@
+#pragma once
+
+/**
+ * Lock-free single-producer/single-consumer ringbuffer
+ *
+ * behavior:
+ *  * one thread pushes, another thread pops, no locks are taken
+ *  * push never overwrites, it returns the number of objects which fit into the free slots (back-pressure)
+ *
+ * data storage:
+ *  * caller-provided data buffer of size_object-sized objects, object capacity must be power of two
+ *  * pos_front/pos_back are free-running object counters, every slot is usable
+ *  * producer and consumer indices live on separate cache lines, every side keeps cached copy of the other side index
+ *    and reloads it only when the cached value says that ringbuffer is full/empty
+ */
+
+//
+// Includes
+//
+
+// stdatomic.h of C++23 pulls in <atomic> templates, so every header which needs it includes it outside of the
+// extern "C" block
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_compiler.h"
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Typedefs
+//
+
+/**
+ * SPSC ringbuffer context structure
+ */
+typedef struct {
+    /**
+     * Back position (counter of pushed objects), written by producer
+     */
+    _Atomic(size_t) pos_back UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * Producer copy of the front position
+     */
+    size_t pos_front_cached;
+
+    /**
+     * Front position (counter of popped objects), written by consumer
+     */
+    _Atomic(size_t) pos_front UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * Consumer copy of the back position
+     */
+    size_t pos_back_cached;
+
+    /**
+     * pointer to ringbuffer data array
+     */
+    uint8_t *data UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * size of one object in bytes
+     */
+    size_t size_object;
+
+    /**
+     * Object index mask (capacity in objects - 1)
+     */
+    size_t mask;
+} uni_common_ringbuffer_spsc_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes the SPSC ringbuffer
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @param data pointer to the data buffer
+ * @param size_object size of one object inside the ringbuffer
+ * @param size_total total size of ringbuffer, size_total / size_object must be power of two
+ * @return true on success
+ *
+ * @note must not race with push/pop
+ */
+bool uni_common_ringbuffer_spsc_init(uni_common_ringbuffer_spsc_context_t *ctx, uint8_t *data, size_t size_object, size_t size_total);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns SPSC ringbuffer capacity
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @return number of objects which can be stored
+ */
+size_t uni_common_ringbuffer_spsc_capacity(const uni_common_ringbuffer_spsc_context_t *ctx);
+
+
+/**
+ * Check that SPSC ringbuffer is empty
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @return true if ringbuffer is empty
+ *
+ * @note the value may be outdated at return when it is called concurrently with push/pop
+ */
+bool uni_common_ringbuffer_spsc_is_empty(const uni_common_ringbuffer_spsc_context_t *ctx);
+
+
+/**
+ * Number of stored elements in SPSC ringbuffer
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @return number of stored elements
+ *
+ * @note the value may be outdated at return when it is called concurrently with push/pop
+ */
+size_t uni_common_ringbuffer_spsc_length(const uni_common_ringbuffer_spsc_context_t *ctx);
+
+
+//
+// Functions/Operations
+//
+
+/**
+ * Clears the SPSC ringbuffer
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @return true on success
+ *
+ * @note must not race with push/pop
+ */
+bool uni_common_ringbuffer_spsc_clear(uni_common_ringbuffer_spsc_context_t *ctx);
+
+
+/**
+ * Pops specified number of objects from SPSC ringbuffer, must be called only from the consumer thread
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @param data receive buffer, must be >= count * ctx->size_object, NULL to drop objects without copy
+ * @param count number of objects to pop
+ * @return number of returned objects
+ */
+size_t uni_common_ringbuffer_spsc_pop(uni_common_ringbuffer_spsc_context_t *ctx, uint8_t *data, size_t count);
+
+
+/**
+ * Pushes specified number of objects into SPSC ringbuffer, must be called only from the producer thread
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @param data pointer to the send buffer, must be >= count * ctx->size_object
+ * @param count number of objects to push
+ * @return number of pushed objects, less than :count when there is not enough free slots
+ */
+size_t uni_common_ringbuffer_spsc_push(uni_common_ringbuffer_spsc_context_t *ctx, const uint8_t *data, size_t count);
+
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,200 @@
+#pragma once
+
+/**
+ * Blocking wait/notify layer for the SPSC ringbuffer consumer
+ *
+ * behavior:
+ *  * consumer which finds the ringbuffer empty spins, then yields, then parks on the futex
+ *  * producer wakes parked consumer only when at least wake_batch objects are available (or on flush), so the
+ *    syscall and the consumer wakeup are amortized over the batch
+ *  * park duration can be limited by park_ns, so the objects of the unfinished batch are picked up even without flush
+ *
+ * data storage:
+ *  * wraps caller-provided SPSC ringbuffer, the ringbuffer itself is not changed
+ *  * epoch is the futex word, producer increments it on every wakeup, so the consumer which parks after the wakeup
+ *    returns immediately
+ *
+ * platform:
+ *  * Linux uses futex and sched_yield, other platforms fall back to the spin on the epoch
+ */
+
+//
+// Includes
+//
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "uni_common_compiler.h"
+#include "uni_common_ringbuffer_spsc.h"
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Defines
+//
+
+/**
+ * Timeout value which waits forever
+ */
+#define UNI_COMMON_RINGBUFFER_WAIT_INFINITE UINT64_MAX
+
+
+//
+// Typedefs
+//
+
+/**
+ * Wait strategy configuration
+ */
+typedef struct {
+    /**
+     * Pointer to the SPSC ringbuffer
+     */
+    uni_common_ringbuffer_spsc_context_t *ring;
+
+    /**
+     * Number of busy-wait iterations before the consumer starts yielding
+     */
+    uint32_t spin_count;
+
+    /**
+     * Number of yields before the consumer parks
+     */
+    uint32_t yield_count;
+
+    /**
+     * Parked consumer is woken when at least this number of objects is available, must be > 0
+     */
+    size_t wake_batch;
+
+    /**
+     * Maximum duration of one park in nanoseconds, 0 to park until the wakeup
+     */
+    uint64_t park_ns;
+} uni_common_ringbuffer_wait_config_t;
+
+
+/**
+ * Wait strategy context structure
+ */
+typedef struct {
+    /**
+     * Wakeup counter (futex word), written by producer
+     */
+    _Atomic(uint32_t) epoch UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * Non-zero while the consumer is parked or is about to park
+     */
+    _Atomic(uint32_t) parked;
+
+    /**
+     * Number of wakeups sent by producer
+     */
+    size_t count_wake;
+
+    /**
+     * Number of parks done by consumer
+     */
+    size_t count_park UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+
+    /**
+     * Configuration, read-only after init
+     */
+    uni_common_ringbuffer_wait_config_t config UNI_COMMON_COMPILER_ALIGN(UNI_COMMON_COMPILER_CACHELINE);
+} uni_common_ringbuffer_wait_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes wait strategy with the default configuration
+ * @param ctx pointer to the wait strategy context
+ * @param ring pointer to the initialized SPSC ringbuffer
+ * @return true on success
+ *
+ * @note defaults are 256 spins, 16 yields, wakeup on every object and unlimited park
+ */
+bool uni_common_ringbuffer_wait_init(uni_common_ringbuffer_wait_context_t *ctx, uni_common_ringbuffer_spsc_context_t *ring);
+
+
+/**
+ * Initializes wait strategy with the extended configuration
+ * @param ctx pointer to the wait strategy context
+ * @param config pointer to the configuration, it is copied into the context
+ * @return true on success
+ */
+bool uni_common_ringbuffer_wait_init_ex(uni_common_ringbuffer_wait_context_t *ctx, const uni_common_ringbuffer_wait_config_t *config);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns number of consumer parks
+ * @param ctx pointer to the wait strategy context
+ * @return number of parks, must be called from the consumer thread
+ */
+size_t uni_common_ringbuffer_wait_count_park(const uni_common_ringbuffer_wait_context_t *ctx);
+
+
+/**
+ * Returns number of producer wakeups
+ * @param ctx pointer to the wait strategy context
+ * @return number of wakeups, must be called from the producer thread
+ */
+size_t uni_common_ringbuffer_wait_count_wake(const uni_common_ringbuffer_wait_context_t *ctx);
+
+
+//
+// Functions/Operations
+//
+
+/**
+ * Wakes the parked consumer if there is anything to pop, must be called only from the producer thread
+ * @param ctx pointer to the wait strategy context
+ * @return true if the consumer was woken
+ *
+ * @note call it after the last push of the burst when wake_batch > 1
+ */
+bool uni_common_ringbuffer_wait_flush(uni_common_ringbuffer_wait_context_t *ctx);
+
+
+/**
+ * Pops specified number of objects, waits for the first one when ringbuffer is empty
+ * @param ctx pointer to the wait strategy context
+ * @param data receive buffer, must be >= count * size_object, NULL to drop objects without copy
+ * @param count number of objects to pop
+ * @param timeout_ns maximum wait in nanoseconds, 0 to not wait, UNI_COMMON_RINGBUFFER_WAIT_INFINITE to wait forever
+ * @return number of returned objects, 0 on timeout
+ *
+ * @note must be called only from the consumer thread
+ */
+size_t uni_common_ringbuffer_wait_pop(uni_common_ringbuffer_wait_context_t *ctx, uint8_t *data, size_t count, uint64_t timeout_ns);
+
+
+/**
+ * Pushes specified number of objects and wakes the parked consumer when wake_batch objects are available
+ * @param ctx pointer to the wait strategy context
+ * @param data pointer to the send buffer, must be >= count * size_object
+ * @param count number of objects to push
+ * @return number of pushed objects, less than :count when there is not enough free slots
+ *
+ * @note must be called only from the producer thread
+ */
+size_t uni_common_ringbuffer_wait_push(uni_common_ringbuffer_wait_context_t *ctx, const uint8_t *data, size_t count);
+
+
+#if defined(__cplusplus)
+}
+#endif
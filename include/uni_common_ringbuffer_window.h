@@ -0,0 +1,236 @@
+#pragma once
+
+/**
+ * Sliding-window aggregates (min/max/sum/mean) of the last N samples
+ *
+ * behavior:
+ *  * push adds the newest sample and evicts the oldest one when the window is full
+ *  * pop evicts the oldest sample explicitly, e.g. for time-based windows
+ *  * every operation is amortized O(1) regardless of the window size
+ *
+ * data storage:
+ *  * caller-provided array of window values and two arrays of deque entries, all of them have capacity elements
+ *  * min/max are kept by monotonic deques: every entry is pushed and popped at most once
+ *  * sum is compensated (Neumaier) running sum, which is recalculated from the stored values once per capacity
+ *    evictions, so the error of subtraction does not accumulate
+ *
+ * data types:
+ *  * samples are doubles, NaN is not supported
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+//
+// Typedefs
+//
+
+/**
+ * Monotonic deque entry
+ */
+typedef struct {
+    /**
+     * Sample value
+     */
+    double value;
+
+    /**
+     * Sample position (free-running counter of pushed samples)
+     */
+    size_t pos;
+} uni_common_ringbuffer_window_entry_t;
+
+
+/**
+ * Monotonic deque
+ */
+typedef struct {
+    /**
+     * Pointer to the entries array, must have window capacity elements
+     */
+    uni_common_ringbuffer_window_entry_t *entries;
+
+    /**
+     * Index of the first entry
+     */
+    size_t head;
+
+    /**
+     * Number of entries
+     */
+    size_t count;
+} uni_common_ringbuffer_window_deque_t;
+
+
+/**
+ * Sliding window context structure
+ */
+typedef struct {
+    /**
+     * Pointer to the window values array
+     */
+    double *values;
+
+    /**
+     * Window capacity in samples
+     */
+    size_t capacity;
+
+    /**
+     * Position of the oldest sample (free-running)
+     */
+    size_t pos_front;
+
+    /**
+     * Position of the next sample (free-running)
+     */
+    size_t pos_back;
+
+    /**
+     * Index of the oldest sample in the values array
+     */
+    size_t slot_front;
+
+    /**
+     * Deque of the minimum candidates, values are increasing from the front to the back
+     */
+    uni_common_ringbuffer_window_deque_t deque_min;
+
+    /**
+     * Deque of the maximum candidates, values are decreasing from the front to the back
+     */
+    uni_common_ringbuffer_window_deque_t deque_max;
+
+    /**
+     * Running sum
+     */
+    double sum;
+
+    /**
+     * Compensation of the running sum
+     */
+    double sum_comp;
+
+    /**
+     * Evictions left until the sum is recalculated
+     */
+    size_t anchor_countdown;
+} uni_common_ringbuffer_window_context_t;
+
+
+//
+// Functions/Init
+//
+
+/**
+ * Initializes the sliding window
+ * @param ctx pointer to the sliding window context
+ * @param values pointer to the values array, must have :capacity elements
+ * @param entries_min pointer to the minimum deque entries array, must have :capacity elements
+ * @param entries_max pointer to the maximum deque entries array, must have :capacity elements
+ * @param capacity window size in samples, must be > 0
+ * @return true on success
+ */
+bool uni_common_ringbuffer_window_init(uni_common_ringbuffer_window_context_t *ctx, double *values,
+                                       uni_common_ringbuffer_window_entry_t *entries_min,
+                                       uni_common_ringbuffer_window_entry_t *entries_max, size_t capacity);
+
+
+//
+// Functions/Getters
+//
+
+/**
+ * Returns sliding window capacity
+ * @param ctx pointer to the sliding window context
+ * @return window size in samples
+ */
+size_t uni_common_ringbuffer_window_capacity(const uni_common_ringbuffer_window_context_t *ctx);
+
+
+/**
+ * Number of samples in the sliding window
+ * @param ctx pointer to the sliding window context
+ * @return number of samples
+ */
+size_t uni_common_ringbuffer_window_length(const uni_common_ringbuffer_window_context_t *ctx);
+
+
+/**
+ * Returns the maximum of the window samples
+ * @param ctx pointer to the sliding window context
+ * @param value pointer to the output value
+ * @return true on success, false if window is empty
+ */
+bool uni_common_ringbuffer_window_max(const uni_common_ringbuffer_window_context_t *ctx, double *value);
+
+
+/**
+ * Returns the mean of the window samples
+ * @param ctx pointer to the sliding window context
+ * @param value pointer to the output value
+ * @return true on success, false if window is empty
+ */
+bool uni_common_ringbuffer_window_mean(const uni_common_ringbuffer_window_context_t *ctx, double *value);
+
+
+/**
+ * Returns the minimum of the window samples
+ * @param ctx pointer to the sliding window context
+ * @param value pointer to the output value
+ * @return true on success, false if window is empty
+ */
+bool uni_common_ringbuffer_window_min(const uni_common_ringbuffer_window_context_t *ctx, double *value);
+
+
+/**
+ * Returns the sum of the window samples
+ * @param ctx pointer to the sliding window context
+ * @return sum, 0 for empty window
+ */
+double uni_common_ringbuffer_window_sum(const uni_common_ringbuffer_window_context_t *ctx);
+
+
+//
+// Functions/Operations
+//
+
+/**
+ * Clears the sliding window
+ * @param ctx pointer to the sliding window context
+ * @return true on success
+ */
+bool uni_common_ringbuffer_window_clear(uni_common_ringbuffer_window_context_t *ctx);
+
+
+/**
+ * Evicts the oldest sample
+ * @param ctx pointer to the sliding window context
+ * @return true on success, false if window is empty
+ */
+bool uni_common_ringbuffer_window_pop(uni_common_ringbuffer_window_context_t *ctx);
+
+
+/**
+ * Pushes the newest sample, the oldest one is evicted when the window is full
+ * @param ctx pointer to the sliding window context
+ * @param value sample value
+ * @return true on success
+ */
+bool uni_common_ringbuffer_window_push(uni_common_ringbuffer_window_context_t *ctx, double value);
+
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,685 @@
+//
+// Includes
+//
+
+// stdlib
+#include <string.h>
+
+// uni_common
+#include "uni_common_btreemap.h"
+#include "uni_common_math.h"
+
+
+
+//
+// Private functions
+//
+
+/**
+ * Returns pointer to the node
+ * @param ctx pointer to the ordered map context
+ * @param node node number
+ * @return pointer to the node
+ *
+ * @note input data must be valid
+ */
+static uni_common_btreemap_node_t *_uni_common_btreemap_node(const uni_common_btreemap_context_t *ctx, uint32_t node) {
+    return &((uni_common_btreemap_node_t *)ctx->nodes->data)[node];
+}
+
+
+/**
+ * Returns pointer to the value of the leaf entry
+ * @param ctx pointer to the ordered map context
+ * @param node leaf number
+ * @param pos entry position inside the leaf
+ * @return pointer to the value
+ *
+ * @note input data must be valid
+ */
+static uint8_t *_uni_common_btreemap_val(const uni_common_btreemap_context_t *ctx, uint32_t node, size_t pos) {
+    return &ctx->vals->data[((size_t)node * UNI_COMMON_BTREEMAP_ORDER + pos) * ctx->vals->size_item];
+}
+
+
+/**
+ * Takes node from the free list
+ * @param ctx pointer to the ordered map context
+ * @param leaf true for the leaf node
+ * @return node number, UNI_COMMON_BTREEMAP_NODE_NONE if there are no free nodes
+ *
+ * @note input data must be valid
+ */
+static uint32_t _uni_common_btreemap_node_alloc(uni_common_btreemap_context_t *ctx, bool leaf) {
+    uint32_t result = ctx->node_free;
+
+    if (result != UNI_COMMON_BTREEMAP_NODE_NONE) {
+        uni_common_btreemap_node_t *node = _uni_common_btreemap_node(ctx, result);
+        ctx->node_free = node->link_next;
+        ctx->node_free_count--;
+
+        node->count = 0U;
+        node->leaf = leaf ? 1U : 0U;
+        node->link_prev = UNI_COMMON_BTREEMAP_NODE_NONE;
+        node->link_next = UNI_COMMON_BTREEMAP_NODE_NONE;
+    }
+
+    return result;
+}
+
+
+/**
+ * Returns node to the free list
+ * @param ctx pointer to the ordered map context
+ * @param node node number
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_btreemap_node_free(uni_common_btreemap_context_t *ctx, uint32_t node) {
+    _uni_common_btreemap_node(ctx, node)->link_next = ctx->node_free;
+    ctx->node_free = node;
+    ctx->node_free_count++;
+}
+
+
+/**
+ * Clears given ordered map
+ * @param ctx pointer to the ordered map context
+ *
+ * @note free list is rebuilt in ascending order, so the following allocations are sequential
+ * @note input data must be valid
+ */
+static void _uni_common_btreemap_clear(uni_common_btreemap_context_t *ctx) {
+    for (size_t idx = 0U; idx < ctx->node_count; idx++) {
+        _uni_common_btreemap_node(ctx, (uint32_t)idx)->link_next =
+                idx + 1U < ctx->node_count ? (uint32_t)(idx + 1U) : UNI_COMMON_BTREEMAP_NODE_NONE;
+    }
+    ctx->node_free = 0U;
+    ctx->node_free_count = ctx->node_count;
+
+    ctx->root = _uni_common_btreemap_node_alloc(ctx, true);
+    ctx->height = 1U;
+    ctx->size = 0U;
+}
+
+
+/**
+ * Returns number of node keys which are less than or equal to the given one
+ * @param node pointer to the node
+ * @param key key to compare with
+ * @return number of keys
+ *
+ * @note branchless scan of the sorted keys, the node keys span a few adjacent cache lines
+ * @note input data must be valid
+ */
+static size_t _uni_common_btreemap_node_upper(const uni_common_btreemap_node_t *node, size_t key) {
+    size_t result = 0U;
+
+    for (size_t idx = 0U; idx < node->count; idx++) {
+        result += node->keys[idx] <= key ? 1U : 0U;
+    }
+
+    return result;
+}
+
+
+/**
+ * Returns position of the first node key which is greater than or equal to the given one
+ * @param node pointer to the node
+ * @param key key to compare with
+ * @return position, node count if all keys are less
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_btreemap_node_lower(const uni_common_btreemap_node_t *node, size_t key) {
+    size_t result = 0U;
+
+    for (size_t idx = 0U; idx < node->count; idx++) {
+        result += node->keys[idx] < key ? 1U : 0U;
+    }
+
+    return result;
+}
+
+
+/**
+ * Descends from the root to the leaf which may contain the given key
+ * @param ctx pointer to the ordered map context
+ * @param key key to search
+ * @param path_nodes pointer to the array of inner nodes on the path, may be NULL
+ * @param path_pos pointer to the array of child positions on the path, may be NULL
+ * @return leaf number
+ *
+ * @note input data must be valid
+ */
+static uint32_t _uni_common_btreemap_descend(const uni_common_btreemap_context_t *ctx, size_t key, uint32_t *path_nodes, size_t *path_pos) {
+    uint32_t result = ctx->root;
+
+    for (size_t level = 0U; level + 1U < ctx->height; level++) {
+        const uni_common_btreemap_node_t *node = _uni_common_btreemap_node(ctx, result);
+        size_t pos = _uni_common_btreemap_node_upper(node, key);
+        if (pos > 0U) {
+            pos--;
+        }
+
+        if (path_nodes != NULL) {
+            path_nodes[level] = result;
+            path_pos[level] = pos;
+        }
+        result = node->links[pos];
+    }
+
+    return result;
+}
+
+
+/**
+ * Inserts entry into the node which has free space
+ * @param ctx pointer to the ordered map context
+ * @param node node number
+ * @param pos entry position
+ * @param key entry key
+ * @param link child node of the inner node entry
+ * @param val pointer to the value of the leaf entry
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_btreemap_node_insert(uni_common_btreemap_context_t *ctx, uint32_t node, size_t pos, size_t key,
+                                             uint32_t link, const void *val) {
+    uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, node);
+    size_t tail = ptr->count - pos;
+
+    memmove(&ptr->keys[pos + 1U], &ptr->keys[pos], tail * sizeof(size_t));
+    ptr->keys[pos] = key;
+
+    if (ptr->leaf != 0U) {
+        size_t size_item = ctx->vals->size_item;
+        uint8_t *val_pos = _uni_common_btreemap_val(ctx, node, pos);
+        memmove(val_pos + size_item, val_pos, tail * size_item);
+        memcpy(val_pos, val, size_item);
+    } else {
+        memmove(&ptr->links[pos + 1U], &ptr->links[pos], tail * sizeof(uint32_t));
+        ptr->links[pos] = link;
+    }
+
+    ptr->count++;
+}
+
+
+/**
+ * Removes entry from the node
+ * @param ctx pointer to the ordered map context
+ * @param node node number
+ * @param pos entry position
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_btreemap_node_erase(uni_common_btreemap_context_t *ctx, uint32_t node, size_t pos) {
+    uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, node);
+    size_t tail = ptr->count - pos - 1U;
+
+    memmove(&ptr->keys[pos], &ptr->keys[pos + 1U], tail * sizeof(size_t));
+
+    if (ptr->leaf != 0U) {
+        size_t size_item = ctx->vals->size_item;
+        uint8_t *val_pos = _uni_common_btreemap_val(ctx, node, pos);
+        memmove(val_pos, val_pos + size_item, tail * size_item);
+    } else {
+        memmove(&ptr->links[pos], &ptr->links[pos + 1U], tail * sizeof(uint32_t));
+    }
+
+    ptr->count--;
+}
+
+
+/**
+ * Moves the entries starting from the given position into the new right sibling
+ * @param ctx pointer to the ordered map context
+ * @param node node number
+ * @param right new node number
+ * @param mid first entry to move
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_btreemap_node_split(uni_common_btreemap_context_t *ctx, uint32_t node, uint32_t right, size_t mid) {
+    uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, node);
+    uni_common_btreemap_node_t *ptr_right = _uni_common_btreemap_node(ctx, right);
+    size_t count = ptr->count - mid;
+
+    memcpy(ptr_right->keys, &ptr->keys[mid], count * sizeof(size_t));
+
+    if (ptr->leaf != 0U) {
+        memcpy(_uni_common_btreemap_val(ctx, right, 0U), _uni_common_btreemap_val(ctx, node, mid), count * ctx->vals->size_item);
+
+        ptr_right->link_prev = node;
+        ptr_right->link_next = ptr->link_next;
+        if (ptr->link_next != UNI_COMMON_BTREEMAP_NODE_NONE) {
+            _uni_common_btreemap_node(ctx, ptr->link_next)->link_prev = right;
+        }
+        ptr->link_next = right;
+    } else {
+        memcpy(ptr_right->links, &ptr->links[mid], count * sizeof(uint32_t));
+    }
+
+    ptr_right->count = (uint16_t)count;
+    ptr->count = (uint16_t)mid;
+}
+
+
+/**
+ * Inserts new key into the leaf and splits the full nodes up to the root
+ * @param ctx pointer to the ordered map context
+ * @param key key to insert
+ * @param val pointer to the value
+ * @param leaf leaf number
+ * @param pos entry position inside the leaf
+ * @param path_nodes pointer to the array of inner nodes on the path
+ * @param path_pos pointer to the array of child positions on the path
+ * @param rightmost true if the key is appended after the last key of the map
+ *
+ * @note there must be enough free nodes for the splits
+ * @note input data must be valid
+ */
+static void _uni_common_btreemap_insert(uni_common_btreemap_context_t *ctx, size_t key, const void *val, uint32_t leaf, size_t pos,
+                                        const uint32_t *path_nodes, const size_t *path_pos, bool rightmost) {
+    uint32_t node = leaf;
+    size_t level = ctx->height - 1U;
+    size_t key_ins = key;
+    uint32_t link_ins = UNI_COMMON_BTREEMAP_NODE_NONE;
+    bool done = false;
+
+    while (!done) {
+        uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, node);
+
+        if (ptr->count < UNI_COMMON_BTREEMAP_ORDER) {
+            _uni_common_btreemap_node_insert(ctx, node, pos, key_ins, link_ins, val);
+            done = true;
+        } else {
+            // appending keeps the left node full, otherwise both halves get the free space
+            size_t mid = rightmost ? UNI_COMMON_BTREEMAP_ORDER : UNI_COMMON_BTREEMAP_ORDER / 2U;
+            uint32_t right = _uni_common_btreemap_node_alloc(ctx, ptr->leaf != 0U);
+            _uni_common_btreemap_node_split(ctx, node, right, mid);
+
+            if (pos <= mid && !rightmost) {
+                _uni_common_btreemap_node_insert(ctx, node, pos, key_ins, link_ins, val);
+            } else {
+                _uni_common_btreemap_node_insert(ctx, right, pos - mid, key_ins, link_ins, val);
+            }
+
+            key_ins = _uni_common_btreemap_node(ctx, right)->keys[0];
+            link_ins = right;
+
+            if (level == 0U) {
+                uint32_t root = _uni_common_btreemap_node_alloc(ctx, false);
+                uni_common_btreemap_node_t *ptr_root = _uni_common_btreemap_node(ctx, root);
+                ptr_root->keys[0] = _uni_common_btreemap_node(ctx, node)->keys[0];
+                ptr_root->links[0] = node;
+                ptr_root->keys[1] = key_ins;
+                ptr_root->links[1] = right;
+                ptr_root->count = 2U;
+
+                ctx->root = root;
+                ctx->height++;
+                done = true;
+            } else {
+                level--;
+                node = path_nodes[level];
+                pos = path_pos[level] + 1U;
+            }
+        }
+    }
+}
+
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_btreemap_init(uni_common_btreemap_context_t *ctx, uni_common_array_t *nodes, uni_common_array_t *vals) {
+    bool result = false;
+
+    if (ctx != NULL && uni_common_array_valid(nodes) && uni_common_array_valid(vals)) {
+        uni_common_array_set_itemsize(nodes, sizeof(uni_common_btreemap_node_t));
+
+        size_t node_count = uni_common_math_min(uni_common_array_length(nodes), uni_common_array_length(vals) / UNI_COMMON_BTREEMAP_ORDER);
+        node_count = uni_common_math_min(node_count, (size_t)UINT32_MAX);
+
+        if (node_count > 0U) {
+            ctx->nodes = nodes;
+            ctx->vals = vals;
+            ctx->node_count = node_count;
+            _uni_common_btreemap_clear(ctx);
+            ctx->initialized = true;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_btreemap_height(const uni_common_btreemap_context_t *ctx) {
+    size_t result = 0U;
+
+    if (uni_common_btreemap_initialized(ctx)) {
+        result = ctx->height;
+    }
+
+    return result;
+}
+
+
+bool uni_common_btreemap_initialized(const uni_common_btreemap_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL) {
+        result = ctx->initialized;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_btreemap_size(const uni_common_btreemap_context_t *ctx) {
+    size_t result = 0U;
+
+    if (uni_common_btreemap_initialized(ctx)) {
+        result = ctx->size;
+    }
+
+    return result;
+}
+
+
+
+//
+// Functions/Process
+//
+
+bool uni_common_btreemap_clear(uni_common_btreemap_context_t *ctx) {
+    bool result = false;
+
+    if (uni_common_btreemap_initialized(ctx)) {
+        _uni_common_btreemap_clear(ctx);
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_btreemap_enum(uni_common_btreemap_context_t *ctx, uni_common_btreemap_enum_func_t func) {
+    bool result = false;
+
+    if (uni_common_btreemap_initialized(ctx) && func != NULL) {
+        uint32_t leaf = _uni_common_btreemap_descend(ctx, 0U, NULL, NULL);
+        while (leaf != UNI_COMMON_BTREEMAP_NODE_NONE) {
+            const uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, leaf);
+            for (size_t pos = 0U; pos < ptr->count; pos++) {
+                func(ptr->keys[pos], _uni_common_btreemap_val(ctx, leaf, pos));
+            }
+            leaf = ptr->link_next;
+        }
+        result = true;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_btreemap_enum_range(uni_common_btreemap_context_t *ctx, size_t lo, size_t hi, uni_common_btreemap_enum_func_t func) {
+    size_t result = 0U;
+
+    if (uni_common_btreemap_initialized(ctx) && func != NULL && lo < hi) {
+        uint32_t leaf = _uni_common_btreemap_descend(ctx, lo, NULL, NULL);
+        size_t pos = _uni_common_btreemap_node_lower(_uni_common_btreemap_node(ctx, leaf), lo);
+        bool done = false;
+
+        while (leaf != UNI_COMMON_BTREEMAP_NODE_NONE && !done) {
+            const uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, leaf);
+            for (; pos < ptr->count; pos++) {
+                if (ptr->keys[pos] >= hi) {
+                    done = true;
+                    break;
+                }
+                func(ptr->keys[pos], _uni_common_btreemap_val(ctx, leaf, pos));
+                result++;
+            }
+            leaf = ptr->link_next;
+            pos = 0U;
+        }
+    }
+
+    return result;
+}
+
+
+uint8_t *uni_common_btreemap_get(uni_common_btreemap_context_t *ctx, size_t key) {
+    uint8_t *result = NULL;
+
+    if (uni_common_btreemap_initialized(ctx)) {
+        uint32_t leaf = _uni_common_btreemap_descend(ctx, key, NULL, NULL);
+        const uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, leaf);
+        size_t pos = _uni_common_btreemap_node_lower(ptr, key);
+        if (pos < ptr->count && ptr->keys[pos] == key) {
+            result = _uni_common_btreemap_val(ctx, leaf, pos);
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_btreemap_load(uni_common_btreemap_context_t *ctx, const size_t *keys, size_t count, const void *vals) {
+    bool result = false;
+
+    if (uni_common_btreemap_initialized(ctx) && (count == 0U || (keys != NULL && vals != NULL))) {
+        bool sorted = true;
+        for (size_t idx = 1U; idx < count && sorted; idx++) {
+            sorted = keys[idx - 1U] < keys[idx];
+        }
+
+        // every level is a contiguous range of nodes, the one above has ORDER times less nodes
+        size_t nodes_needed = 0U;
+        size_t height = 0U;
+        size_t level_count = count;
+        do {
+            level_count = (level_count + UNI_COMMON_BTREEMAP_ORDER - 1U) / UNI_COMMON_BTREEMAP_ORDER;
+            level_count = uni_common_math_max(level_count, (size_t)1U);
+            nodes_needed += level_count;
+            height++;
+        } while (level_count > 1U);
+
+        if (sorted && nodes_needed <= ctx->node_count && height <= UNI_COMMON_BTREEMAP_HEIGHT_MAX) {
+            _uni_common_btreemap_clear(ctx);
+
+            // leaves, the root allocated by clear is the first one
+            size_t size_item = ctx->vals->size_item;
+            uint32_t level_first = ctx->root;
+            uint32_t leaf_prev = UNI_COMMON_BTREEMAP_NODE_NONE;
+            level_count = 0U;
+            for (size_t base = 0U; base < count || level_count == 0U; base += UNI_COMMON_BTREEMAP_ORDER) {
+                uint32_t leaf = level_count == 0U ? ctx->root : _uni_common_btreemap_node_alloc(ctx, true);
+                uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, leaf);
+                size_t chunk = uni_common_math_min(count - base, (size_t)UNI_COMMON_BTREEMAP_ORDER);
+
+                memcpy(ptr->keys, &keys[base], chunk * sizeof(size_t));
+                memcpy(_uni_common_btreemap_val(ctx, leaf, 0U), &((const uint8_t *)vals)[base * size_item], chunk * size_item);
+                ptr->count = (uint16_t)chunk;
+                ptr->link_prev = leaf_prev;
+                if (leaf_prev != UNI_COMMON_BTREEMAP_NODE_NONE) {
+                    _uni_common_btreemap_node(ctx, leaf_prev)->link_next = leaf;
+                }
+                leaf_prev = leaf;
+                level_count++;
+            }
+
+            // inner levels
+            ctx->height = 1U;
+            while (level_count > 1U) {
+                uint32_t next_first = UNI_COMMON_BTREEMAP_NODE_NONE;
+                size_t next_count = 0U;
+
+                for (size_t base = 0U; base < level_count; base += UNI_COMMON_BTREEMAP_ORDER) {
+                    uint32_t node = _uni_common_btreemap_node_alloc(ctx, false);
+                    uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, node);
+                    size_t chunk = uni_common_math_min(level_count - base, (size_t)UNI_COMMON_BTREEMAP_ORDER);
+
+                    for (size_t idx = 0U; idx < chunk; idx++) {
+                        uint32_t child = level_first + (uint32_t)(base + idx);
+                        ptr->keys[idx] = _uni_common_btreemap_node(ctx, child)->keys[0];
+                        ptr->links[idx] = child;
+                    }
+                    ptr->count = (uint16_t)chunk;
+
+                    if (next_first == UNI_COMMON_BTREEMAP_NODE_NONE) {
+                        next_first = node;
+                    }
+                    next_count++;
+                }
+
+                level_first = next_first;
+                level_count = next_count;
+                ctx->height++;
+            }
+
+            ctx->root = level_first;
+            ctx->size = count;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_btreemap_lower_bound(uni_common_btreemap_context_t *ctx, size_t key, size_t *key_found, uint8_t **val_found) {
+    bool result = false;
+
+    if (uni_common_btreemap_initialized(ctx)) {
+        uint32_t leaf = _uni_common_btreemap_descend(ctx, key, NULL, NULL);
+        size_t pos = _uni_common_btreemap_node_lower(_uni_common_btreemap_node(ctx, leaf), key);
+
+        // leaves are never empty except the root one, so the next leaf starts with the answer
+        if (pos == _uni_common_btreemap_node(ctx, leaf)->count) {
+            leaf = _uni_common_btreemap_node(ctx, leaf)->link_next;
+            pos = 0U;
+        }
+
+        if (leaf != UNI_COMMON_BTREEMAP_NODE_NONE && pos < _uni_common_btreemap_node(ctx, leaf)->count) {
+            if (key_found != NULL) {
+                *key_found = _uni_common_btreemap_node(ctx, leaf)->keys[pos];
+            }
+            if (val_found != NULL) {
+                *val_found = _uni_common_btreemap_val(ctx, leaf, pos);
+            }
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_btreemap_remove(uni_common_btreemap_context_t *ctx, size_t key) {
+    bool result = false;
+
+    if (uni_common_btreemap_initialized(ctx)) {
+        uint32_t path_nodes[UNI_COMMON_BTREEMAP_HEIGHT_MAX];
+        size_t path_pos[UNI_COMMON_BTREEMAP_HEIGHT_MAX];
+
+        uint32_t node = _uni_common_btreemap_descend(ctx, key, path_nodes, path_pos);
+        size_t pos = _uni_common_btreemap_node_lower(_uni_common_btreemap_node(ctx, node), key);
+
+        if (pos < _uni_common_btreemap_node(ctx, node)->count && _uni_common_btreemap_node(ctx, node)->keys[pos] == key) {
+            _uni_common_btreemap_node_erase(ctx, node, pos);
+            ctx->size--;
+
+            // empty nodes are detached from the parents, root inner node always keeps at least 2 children
+            size_t level = ctx->height - 1U;
+            while (level > 0U && _uni_common_btreemap_node(ctx, node)->count == 0U) {
+                uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, node);
+                if (ptr->leaf != 0U) {
+                    if (ptr->link_prev != UNI_COMMON_BTREEMAP_NODE_NONE) {
+                        _uni_common_btreemap_node(ctx, ptr->link_prev)->link_next = ptr->link_next;
+                    }
+                    if (ptr->link_next != UNI_COMMON_BTREEMAP_NODE_NONE) {
+                        _uni_common_btreemap_node(ctx, ptr->link_next)->link_prev = ptr->link_prev;
+                    }
+                }
+                _uni_common_btreemap_node_free(ctx, node);
+
+                level--;
+                node = path_nodes[level];
+                _uni_common_btreemap_node_erase(ctx, node, path_pos[level]);
+            }
+
+            while (ctx->height > 1U && _uni_common_btreemap_node(ctx, ctx->root)->count == 1U) {
+                uint32_t root = ctx->root;
+                ctx->root = _uni_common_btreemap_node(ctx, root)->links[0];
+                _uni_common_btreemap_node_free(ctx, root);
+                ctx->height--;
+            }
+
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_btreemap_set(uni_common_btreemap_context_t *ctx, size_t key, const void *val) {
+    bool result = false;
+
+    if (uni_common_btreemap_initialized(ctx) && val != NULL) {
+        uint32_t path_nodes[UNI_COMMON_BTREEMAP_HEIGHT_MAX];
+        size_t path_pos[UNI_COMMON_BTREEMAP_HEIGHT_MAX];
+
+        uint32_t leaf = _uni_common_btreemap_descend(ctx, key, path_nodes, path_pos);
+        const uni_common_btreemap_node_t *ptr = _uni_common_btreemap_node(ctx, leaf);
+        size_t pos = _uni_common_btreemap_node_lower(ptr, key);
+
+        // every full node from the leaf up splits, and the full root needs the new root as well
+        size_t nodes_needed = 0U;
+        if (ptr->count == UNI_COMMON_BTREEMAP_ORDER) {
+            nodes_needed = 1U;
+            for (size_t level = ctx->height - 1U; level > 0U; level--) {
+                if (_uni_common_btreemap_node(ctx, path_nodes[level - 1U])->count < UNI_COMMON_BTREEMAP_ORDER) {
+                    break;
+                }
+                nodes_needed++;
+            }
+            if (nodes_needed == ctx->height) {
+                nodes_needed++;
+            }
+        }
+
+        if (pos < ptr->count && ptr->keys[pos] == key) {
+            memcpy(_uni_common_btreemap_val(ctx, leaf, pos), val, ctx->vals->size_item);
+            result = true;
+        } else if (ctx->node_free_count >= nodes_needed && (ctx->height < UNI_COMMON_BTREEMAP_HEIGHT_MAX || nodes_needed <= ctx->height)) {
+            // lower bounds of the subtrees on the path are lowered when the key is the new minimum
+            bool rightmost = pos == ptr->count;
+            for (size_t level = 0U; level + 1U < ctx->height; level++) {
+                uni_common_btreemap_node_t *inner = _uni_common_btreemap_node(ctx, path_nodes[level]);
+                if (inner->keys[path_pos[level]] > key) {
+                    inner->keys[path_pos[level]] = key;
+                }
+                rightmost = rightmost && path_pos[level] + 1U == inner->count;
+            }
+
+            _uni_common_btreemap_insert(ctx, key, val, leaf, pos, path_nodes, path_pos, rightmost);
+            ctx->size++;
+            result = true;
+        }
+    }
+
+    return result;
+}
@@ -6,20 +6,152 @@
 #include <string.h>
 
 #include "uni_common_compiler.h"
+#include "uni_common_hash.h"
 #include "uni_common_lrumap.h"
 #include "uni_common_math.h"
 
 
 //
-// Static globals
+// Private functions
 //
 
-static const size_t _sizemax = SIZE_MAX;
 
+/**
+ * Returns link-to-previous of the given slot
+ * @param ctx pointer to the LRUmap context
+ * @param slot slot number
+ * @return previous slot number, SIZE_MAX if there is no previous slot
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_lrumap_link_prev(const uni_common_lrumap_context_t *ctx, size_t slot) {
+    size_t result;
+
+    if (ctx->arr_nodes != NULL) {
+        uint32_t link = ((const uni_common_lrumap_node_t *)ctx->arr_nodes->data)[slot].link_prev;
+        result = link == UINT32_MAX ? SIZE_MAX : link;
+    } else {
+        result = ((const size_t *)ctx->arr_link_prev->data)[slot];
+    }
+
+    return result;
+}
+
+
+/**
+ * Sets link-to-previous of the given slot
+ * @param ctx pointer to the LRUmap context
+ * @param slot slot number
+ * @param link previous slot number, SIZE_MAX if there is no previous slot
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_lrumap_link_prev_set(uni_common_lrumap_context_t *ctx, size_t slot, size_t link) {
+    if (ctx->arr_nodes != NULL) {
+        ((uni_common_lrumap_node_t *)ctx->arr_nodes->data)[slot].link_prev = (uint32_t)link;
+    } else {
+        ((size_t *)ctx->arr_link_prev->data)[slot] = link;
+    }
+}
+
+
+/**
+ * Returns link-to-next of the given slot
+ * @param ctx pointer to the LRUmap context
+ * @param slot slot number
+ * @return next slot number, SIZE_MAX if there is no next slot
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_lrumap_link_next(const uni_common_lrumap_context_t *ctx, size_t slot) {
+    size_t result;
+
+    if (ctx->arr_nodes != NULL) {
+        uint32_t link = ((const uni_common_lrumap_node_t *)ctx->arr_nodes->data)[slot].link_next;
+        result = link == UINT32_MAX ? SIZE_MAX : link;
+    } else {
+        result = ((const size_t *)ctx->arr_link_next->data)[slot];
+    }
+
+    return result;
+}
+
+
+/**
+ * Sets link-to-next of the given slot
+ * @param ctx pointer to the LRUmap context
+ * @param slot slot number
+ * @param link next slot number, SIZE_MAX if there is no next slot
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_lrumap_link_next_set(uni_common_lrumap_context_t *ctx, size_t slot, size_t link) {
+    if (ctx->arr_nodes != NULL) {
+        ((uni_common_lrumap_node_t *)ctx->arr_nodes->data)[slot].link_next = (uint32_t)link;
+    } else {
+        ((size_t *)ctx->arr_link_next->data)[slot] = link;
+    }
+}
+
+
+/**
+ * Returns key of the given slot
+ * @param ctx pointer to the LRUmap context
+ * @param slot slot number
+ * @return slot key, SIZE_MAX for unused slot
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_lrumap_key(const uni_common_lrumap_context_t *ctx, size_t slot) {
+    size_t result;
+
+    if (ctx->arr_nodes != NULL) {
+        result = ((const uni_common_lrumap_node_t *)ctx->arr_nodes->data)[slot].key;
+    } else {
+        result = ((const size_t *)ctx->arr_keys->data)[slot];
+    }
+
+    return result;
+}
+
+
+/**
+ * Sets key of the given slot
+ * @param ctx pointer to the LRUmap context
+ * @param slot slot number
+ * @param key slot key, SIZE_MAX for unused slot
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_lrumap_key_set(uni_common_lrumap_context_t *ctx, size_t slot, size_t key) {
+    if (ctx->arr_nodes != NULL) {
+        ((uni_common_lrumap_node_t *)ctx->arr_nodes->data)[slot].key = key;
+    } else {
+        ((size_t *)ctx->arr_keys->data)[slot] = key;
+    }
+}
 
-//
-// Private functions
-//
+
+
+/**
+ * Returns LRU-map capacity
+ * @param ctx pointer to the LRUmap context
+ * @return count of slots
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_lrumap_capacity(const uni_common_lrumap_context_t *ctx) {
+    size_t result = uni_common_array_length(ctx->arr_vals);
+    if (ctx->arr_nodes != NULL) {
+        result = uni_common_math_min(result, uni_common_array_length(ctx->arr_nodes));
+        result = uni_common_math_min(result, (size_t)UINT32_MAX);
+    } else {
+        result = uni_common_math_min(result, uni_common_array_length(ctx->arr_link_prev));
+        result = uni_common_math_min(result, uni_common_array_length(ctx->arr_link_next));
+        result = uni_common_math_min(result, uni_common_array_length(ctx->arr_keys));
+    }
+    return result;
+}
 
 
 /**
@@ -27,12 +159,31 @@ static const size_t _sizemax = SIZE_MAX;
  * @param ctx pointer to the LRUmap context
  */
 static void _uni_common_lrumap_clear(uni_common_lrumap_context_t *ctx) {
-    uni_common_array_fill(ctx->arr_link_prev, 0xFF);
-    uni_common_array_fill(ctx->arr_link_next, 0xFF);
-    uni_common_array_fill(ctx->arr_keys, 0xFF);
+    if (ctx->arr_nodes != NULL) {
+        uni_common_array_fill(ctx->arr_nodes, 0xFF);
+    } else {
+        uni_common_array_fill(ctx->arr_link_prev, 0xFF);
+        uni_common_array_fill(ctx->arr_link_next, 0xFF);
+        uni_common_array_fill(ctx->arr_keys, 0xFF);
+    }
+    if (ctx->arr_index != NULL) {
+        uni_common_array_fill(ctx->arr_index, 0xFF);
+    }
 
     ctx->slot_last = SIZE_MAX;
     ctx->slot_first = SIZE_MAX;
+    ctx->length = 0U;
+    if (ctx->arr_rank_tree != NULL) {
+        uni_common_array_fill(ctx->arr_rank_tree, 0x00);
+        ctx->rank_stamp_next = 0U;
+    }
+
+    // all slots are free: 0 -> 1 -> ... -> capacity-1
+    size_t capacity = _uni_common_lrumap_capacity(ctx);
+    for (size_t slot = 1U; slot < capacity; slot++) {
+        _uni_common_lrumap_link_next_set(ctx, slot - 1U, slot);
+    }
+    ctx->slot_free = capacity > 0U ? 0U : SIZE_MAX;
 }
 
 
@@ -49,23 +200,52 @@ static bool _uni_common_lrumap_empty(const uni_common_lrumap_context_t *ctx){
 
 
 /**
- * Gets array index for the given object ID
+ * Returns length of the key index
+ * @param ctx pointer to the LRU cache context
+ * @return count of index positions
+ *
+ * @note input data must be valid, index must be attached
+ */
+static size_t _uni_common_lrumap_index_length(const uni_common_lrumap_context_t *ctx) {
+    return ctx->arr_index->size / sizeof(size_t);
+}
+
+
+/**
+ * Probes key index for the given key
  * @param ctx pointer to the LRU cache context
  * @param key key of the object
- * @return index of the object, SIZE_MAX if element was not found
+ * @param pos_empty pointer which will contain first empty index position of the probe sequence, may be NULL
+ * @return index position which refers to the slot with the given key, SIZE_MAX if key was not found
  *
- * @note input data must be valid
+ * @note input data must be valid, index must be attached
  */
-static size_t _uni_common_lrumap_get_slot_bykey(uni_common_lrumap_context_t *ctx, size_t key) {
+static size_t _uni_common_lrumap_index_probe(const uni_common_lrumap_context_t *ctx, size_t key, size_t *pos_empty) {
     size_t result = SIZE_MAX;
-
-    size_t capacity = uni_common_lrumap_capacity(ctx);
-    for (size_t slot = 0; slot < capacity; slot++) {
-        size_t *slot_key = (size_t *)uni_common_array_get(ctx->arr_keys, slot);
-        if (*slot_key == key) {
-            result = slot;
+    size_t empty = SIZE_MAX;
+
+    const size_t *index = (const size_t *)ctx->arr_index->data;
+    size_t length = _uni_common_lrumap_index_length(ctx);
+    size_t pos = uni_common_hash_reduce(uni_common_hash_size(key), length);
+    for (size_t probe = 0U; probe < length; probe++) {
+        size_t slot = index[pos];
+        if (slot == SIZE_MAX) {
+            empty = pos;
+            break;
+        }
+        if (_uni_common_lrumap_key(ctx, slot) == key) {
+            result = pos;
             break;
         }
+
+        pos++;
+        if (pos == length) {
+            pos = 0U;
+        }
+    }
+
+    if (pos_empty != NULL) {
+        *pos_empty = empty;
     }
 
     return result;
@@ -73,25 +253,198 @@ static size_t _uni_common_lrumap_get_slot_bykey(uni_common_lrumap_context_t *ctx
 
 
 /**
- * Get first empty slot
- * @param ctx pointer to the LRU context
- * @return index of the first empty slot, SIZE_MAX if there is no empty slots
+ * Adds slot with the given key to the key index
+ * @param ctx pointer to the LRU cache context
+ * @param key key of the object, must not be present in index
+ * @param slot slot number
+ *
+ * @note input data must be valid, index must be attached
+ */
+static void _uni_common_lrumap_index_insert(uni_common_lrumap_context_t *ctx, size_t key, size_t slot) {
+    size_t pos = SIZE_MAX;
+    (void)_uni_common_lrumap_index_probe(ctx, key, &pos);
+    if (pos != SIZE_MAX) {
+        ((size_t *)ctx->arr_index->data)[pos] = slot;
+    }
+}
+
+
+/**
+ * Removes the given key from the key index, the rest of the probe sequence is shifted backward
+ * @param ctx pointer to the LRU cache context
+ * @param key key of the object
+ *
+ * @note must be called before the key is overwritten in keys array
+ * @note input data must be valid, index must be attached
+ */
+static void _uni_common_lrumap_index_remove(uni_common_lrumap_context_t *ctx, size_t key) {
+    size_t hole = _uni_common_lrumap_index_probe(ctx, key, NULL);
+
+    if (hole != SIZE_MAX) {
+        size_t *index = (size_t *)ctx->arr_index->data;
+        size_t length = _uni_common_lrumap_index_length(ctx);
+
+        size_t next = hole;
+        for (size_t probe = 1U; probe < length; probe++) {
+            next++;
+            if (next == length) {
+                next = 0U;
+            }
+
+            size_t slot = index[next];
+            if (slot == SIZE_MAX) {
+                break;
+            }
+
+            size_t home = uni_common_hash_reduce(uni_common_hash_size(_uni_common_lrumap_key(ctx, slot)), length);
+            size_t dist_hole = hole >= home ? hole - home : hole + length - home;
+            size_t dist_next = next >= home ? next - home : next + length - home;
+            if (dist_hole < dist_next) {
+                index[hole] = slot;
+                hole = next;
+            }
+        }
+
+        index[hole] = SIZE_MAX;
+    }
+}
+
+
+/**
+ * Returns length of the rank tree
+ * @param ctx pointer to the LRU cache context
+ * @return count of rank positions
+ *
+ * @note input data must be valid, rank tree must be attached
+ */
+static size_t _uni_common_lrumap_rank_length(const uni_common_lrumap_context_t *ctx) {
+    return uni_common_math_min(ctx->arr_rank_tree->size, ctx->arr_rank_slots->size) / sizeof(size_t);
+}
+
+
+/**
+ * Adds value to the rank tree counter of the given position
+ * @param ctx pointer to the LRU cache context
+ * @param stamp rank position
+ * @param add value to add, wraps around for negative values
+ *
+ * @note input data must be valid, rank tree must be attached
+ */
+static void _uni_common_lrumap_rank_add(uni_common_lrumap_context_t *ctx, size_t stamp, size_t add) {
+    size_t *tree = (size_t *)ctx->arr_rank_tree->data;
+    size_t length = _uni_common_lrumap_rank_length(ctx);
+
+    for (size_t node = stamp + 1U; node <= length; node += node & (~node + 1U)) {
+        tree[node - 1U] += add;
+    }
+}
+
+
+/**
+ * Renumbers rank positions of all list slots starting from 0 and rebuilds the rank tree
+ * @param ctx pointer to the LRU cache context
+ *
+ * @note input data must be valid, rank tree must be attached
+ */
+static void _uni_common_lrumap_rank_rebuild(uni_common_lrumap_context_t *ctx) {
+    size_t *tree = (size_t *)ctx->arr_rank_tree->data;
+    size_t *slots = (size_t *)ctx->arr_rank_slots->data;
+    size_t *stamps = (size_t *)ctx->arr_rank_stamps->data;
+    size_t length = _uni_common_lrumap_rank_length(ctx);
+
+    uni_common_array_fill(ctx->arr_rank_tree, 0x00);
+
+    size_t stamp = 0U;
+    size_t slot = ctx->slot_first;
+    while (slot != SIZE_MAX) {
+        slots[stamp] = slot;
+        stamps[slot] = stamp;
+        tree[stamp] = 1U;
+        stamp++;
+        slot = _uni_common_lrumap_link_next(ctx, slot);
+    }
+    ctx->rank_stamp_next = stamp;
+
+    // linear-time tree construction, every node pushes its sum to the parent
+    for (size_t node = 1U; node <= length; node++) {
+        size_t parent = node + (node & (~node + 1U));
+        if (parent <= length) {
+            tree[parent - 1U] += tree[node - 1U];
+        }
+    }
+}
+
+
+/**
+ * Assigns next rank position to the slot which was appended to the end of the list
+ * @param ctx pointer to the LRU cache context
+ * @param slot slot number
+ *
+ * @note input data must be valid, rank tree must be attached
+ */
+static void _uni_common_lrumap_rank_append(uni_common_lrumap_context_t *ctx, size_t slot) {
+    if (ctx->rank_stamp_next >= _uni_common_lrumap_rank_length(ctx)) {
+        _uni_common_lrumap_rank_rebuild(ctx);
+    } else {
+        size_t stamp = ctx->rank_stamp_next++;
+        ((size_t *)ctx->arr_rank_slots->data)[stamp] = slot;
+        ((size_t *)ctx->arr_rank_stamps->data)[slot] = stamp;
+        _uni_common_lrumap_rank_add(ctx, stamp, 1U);
+    }
+}
+
+
+/**
+ * Finds slot which is located at the given list position
+ * @param ctx pointer to the LRU cache context
+ * @param idx list position, must be less than LRU-map length
+ * @return slot number
+ *
+ * @note input data must be valid, rank tree must be attached
+ */
+static size_t _uni_common_lrumap_rank_select(const uni_common_lrumap_context_t *ctx, size_t idx) {
+    const size_t *tree = (const size_t *)ctx->arr_rank_tree->data;
+    size_t length = _uni_common_lrumap_rank_length(ctx);
+
+    size_t step = 1U;
+    while (step <= length / 2U) {
+        step <<= 1U;
+    }
+
+    // descend the implicit tree, keeping the count of positions left to skip
+    size_t stamp = 0U;
+    size_t remaining = idx + 1U;
+    for (; step > 0U; step >>= 1U) {
+        if (stamp + step <= length && tree[stamp + step - 1U] < remaining) {
+            stamp += step;
+            remaining -= tree[stamp - 1U];
+        }
+    }
+
+    return ((const size_t *)ctx->arr_rank_slots->data)[stamp];
+}
+
+
+/**
+ * Gets array index for the given object ID
+ * @param ctx pointer to the LRU cache context
+ * @param key key of the object
+ * @return index of the object, SIZE_MAX if element was not found
  *
  * @note input data must be valid
  */
-static size_t _uni_common_lrumap_get_slot_empty(uni_common_lrumap_context_t *ctx) {
+static size_t _uni_common_lrumap_get_slot_bykey(uni_common_lrumap_context_t *ctx, size_t key) {
     size_t result = SIZE_MAX;
 
-    if (_uni_common_lrumap_empty(ctx)) {
-        result = 0U;
+    if (ctx->arr_index != NULL) {
+        size_t pos = _uni_common_lrumap_index_probe(ctx, key, NULL);
+        if (pos != SIZE_MAX) {
+            result = ((const size_t *)ctx->arr_index->data)[pos];
+        }
     } else {
         size_t capacity = uni_common_lrumap_capacity(ctx);
         for (size_t slot = 0; slot < capacity; slot++) {
-            size_t slot_prev = *(size_t *)uni_common_array_get(ctx->arr_link_prev, slot);
-            size_t slot_next = *(size_t *)uni_common_array_get(ctx->arr_link_next, slot);
-
-            if (slot != ctx->slot_first && slot != ctx->slot_last && slot_prev == SIZE_MAX &&
-                slot_next == SIZE_MAX) {
+            if (_uni_common_lrumap_key(ctx, slot) == key) {
                 result = slot;
                 break;
             }
@@ -102,6 +455,25 @@ static size_t _uni_common_lrumap_get_slot_empty(uni_common_lrumap_context_t *ctx
 }
 
 
+/**
+ * Takes first slot from the free list
+ * @param ctx pointer to the LRU context
+ * @return index of the empty slot, SIZE_MAX if there is no empty slots
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_lrumap_get_slot_empty(uni_common_lrumap_context_t *ctx) {
+    size_t result = ctx->slot_free;
+
+    if (result != SIZE_MAX) {
+        ctx->slot_free = _uni_common_lrumap_link_next(ctx, result);
+        _uni_common_lrumap_link_next_set(ctx, result, SIZE_MAX);
+    }
+
+    return result;
+}
+
+
 /**
  * Removes the given slot from the LRU
  * @param ctx pointer to the LRU context
@@ -112,15 +484,15 @@ static size_t _uni_common_lrumap_get_slot_empty(uni_common_lrumap_context_t *ctx
  */
 static void _uni_common_lrumap_remove_slot(uni_common_lrumap_context_t *ctx, size_t slot) {
     // get indexes of prev and next els
-    size_t slot_prev = *(size_t *)uni_common_array_get(ctx->arr_link_prev, slot);
-    size_t slot_next = *(size_t *)uni_common_array_get(ctx->arr_link_next, slot);
+    size_t slot_prev = _uni_common_lrumap_link_prev(ctx, slot);
+    size_t slot_next = _uni_common_lrumap_link_next(ctx, slot);
 
     // connect previous one with the next one
     if (slot_prev != SIZE_MAX) {
-        uni_common_array_set(ctx->arr_link_next, slot_prev, (uint8_t *)&slot_next);
+        _uni_common_lrumap_link_next_set(ctx, slot_prev, slot_next);
     }
     if (slot_next != SIZE_MAX) {
-        uni_common_array_set(ctx->arr_link_prev, slot_next, (uint8_t *)&slot_prev);
+        _uni_common_lrumap_link_prev_set(ctx, slot_next, slot_prev);
     }
 
     // update first and last elements if needed
@@ -132,8 +504,39 @@ static void _uni_common_lrumap_remove_slot(uni_common_lrumap_context_t *ctx, siz
     }
 
     // mark current index as orphan
-    uni_common_array_set(ctx->arr_link_prev, slot, (const uint8_t *)&_sizemax);
-    uni_common_array_set(ctx->arr_link_next, slot, (const uint8_t *)&_sizemax);
+    _uni_common_lrumap_link_prev_set(ctx, slot, SIZE_MAX);
+    _uni_common_lrumap_link_next_set(ctx, slot, SIZE_MAX);
+
+    // release rank position
+    if (ctx->arr_rank_tree != NULL) {
+        _uni_common_lrumap_rank_add(ctx, ((const size_t *)ctx->arr_rank_stamps->data)[slot], SIZE_MAX);
+    }
+}
+
+
+/**
+ * Removes the given slot from the LRU and marks its key as non-existent
+ * @param ctx pointer to the LRU context
+ * @param slot slot number
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_lrumap_release_slot(uni_common_lrumap_context_t *ctx, size_t slot) {
+    // unlink slot
+    _uni_common_lrumap_remove_slot(ctx, slot);
+
+    // remove key from index
+    if (ctx->arr_index != NULL) {
+        _uni_common_lrumap_index_remove(ctx, _uni_common_lrumap_key(ctx, slot));
+    }
+
+    // mark key as non-existent
+    _uni_common_lrumap_key_set(ctx, slot, SIZE_MAX);
+
+    // put slot on top of the free list
+    _uni_common_lrumap_link_next_set(ctx, slot, ctx->slot_free);
+    ctx->slot_free = slot;
+    ctx->length--;
 }
 
 
@@ -149,7 +552,7 @@ static void _uni_common_lrumap_remove_slot(uni_common_lrumap_context_t *ctx, siz
  * @return true on success
  */
 static void _uni_common_lrumap_set_slot(uni_common_lrumap_context_t *ctx, size_t slot, size_t key, const void *val) {
-    uni_common_array_set(ctx->arr_keys, slot, (uint8_t *)&key);
+    _uni_common_lrumap_key_set(ctx, slot, key);
     uni_common_array_set(ctx->arr_vals, slot, val);
 }
 
@@ -170,11 +573,15 @@ static void _uni_common_lrumap_append_slot(uni_common_lrumap_context_t *ctx, siz
     if (ctx->slot_last == SIZE_MAX) {
         ctx->slot_last = slot;
     } else {
-        uni_common_array_set(ctx->arr_link_next, ctx->slot_last, (uint8_t *)&slot);
-        uni_common_array_set(ctx->arr_link_next, slot, (const uint8_t *)&_sizemax);
-        uni_common_array_set(ctx->arr_link_prev, slot, (uint8_t *)&ctx->slot_last);
+        _uni_common_lrumap_link_next_set(ctx, ctx->slot_last, slot);
+        _uni_common_lrumap_link_next_set(ctx, slot, SIZE_MAX);
+        _uni_common_lrumap_link_prev_set(ctx, slot, ctx->slot_last);
         ctx->slot_last = slot;
     }
+
+    if (ctx->arr_rank_tree != NULL) {
+        _uni_common_lrumap_rank_append(ctx, slot);
+    }
 }
 
 
@@ -204,6 +611,11 @@ bool uni_common_lrumap_init(uni_common_lrumap_context_t *ctx, uni_common_array_t
         ctx->arr_link_next = arr_link_next;
         ctx->arr_keys = arr_keys;
         ctx->arr_vals = arr_vals;
+        ctx->arr_nodes = NULL;
+        ctx->arr_index = NULL;
+        ctx->arr_rank_tree = NULL;
+        ctx->arr_rank_slots = NULL;
+        ctx->arr_rank_stamps = NULL;
 
         uni_common_array_set_itemsize(ctx->arr_link_next, sizeof(size_t));
         uni_common_array_set_itemsize(ctx->arr_link_prev, sizeof(size_t));
@@ -219,6 +631,87 @@ bool uni_common_lrumap_init(uni_common_lrumap_context_t *ctx, uni_common_array_t
 }
 
 
+bool uni_common_lrumap_init_compact(uni_common_lrumap_context_t *ctx, uni_common_array_t *arr_nodes, uni_common_array_t *arr_vals) {
+    bool result = false;
+
+    if (ctx != NULL && arr_nodes != NULL && arr_vals != NULL &&
+        uni_common_array_set_itemsize(arr_nodes, sizeof(uni_common_lrumap_node_t))) {
+        ctx->arr_link_prev = NULL;
+        ctx->arr_link_next = NULL;
+        ctx->arr_keys = NULL;
+        ctx->arr_vals = arr_vals;
+        ctx->arr_nodes = arr_nodes;
+        ctx->arr_index = NULL;
+        ctx->arr_rank_tree = NULL;
+        ctx->arr_rank_slots = NULL;
+        ctx->arr_rank_stamps = NULL;
+
+        _uni_common_lrumap_clear(ctx);
+
+        ctx->initialized = true;
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_lrumap_set_index(uni_common_lrumap_context_t *ctx, uni_common_array_t *arr_index) {
+    bool result = false;
+
+    if (uni_common_lrumap_initialized(ctx)) {
+        if (arr_index == NULL) {
+            ctx->arr_index = NULL;
+            result = true;
+        } else if (uni_common_array_set_itemsize(arr_index, sizeof(size_t)) &&
+                   uni_common_array_length(arr_index) > uni_common_lrumap_capacity(ctx)) {
+            ctx->arr_index = arr_index;
+            uni_common_array_fill(ctx->arr_index, 0xFF);
+
+            size_t slot = ctx->slot_first;
+            while (slot != SIZE_MAX) {
+                _uni_common_lrumap_index_insert(ctx, _uni_common_lrumap_key(ctx, slot), slot);
+                slot = _uni_common_lrumap_link_next(ctx, slot);
+            }
+
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_lrumap_set_rank(uni_common_lrumap_context_t *ctx, uni_common_array_t *arr_rank_tree,
+                                uni_common_array_t *arr_rank_slots, uni_common_array_t *arr_rank_stamps) {
+    bool result = false;
+
+    if (uni_common_lrumap_initialized(ctx)) {
+        size_t capacity = _uni_common_lrumap_capacity(ctx);
+        if (arr_rank_tree == NULL) {
+            ctx->arr_rank_tree = NULL;
+            ctx->arr_rank_slots = NULL;
+            ctx->arr_rank_stamps = NULL;
+            result = true;
+        } else if (arr_rank_slots != NULL && arr_rank_stamps != NULL &&
+                   uni_common_array_set_itemsize(arr_rank_tree, sizeof(size_t)) &&
+                   uni_common_array_set_itemsize(arr_rank_slots, sizeof(size_t)) &&
+                   uni_common_array_set_itemsize(arr_rank_stamps, sizeof(size_t)) &&
+                   uni_common_array_length(arr_rank_tree) > capacity &&
+                   uni_common_array_length(arr_rank_slots) == uni_common_array_length(arr_rank_tree) &&
+                   uni_common_array_length(arr_rank_stamps) >= capacity) {
+            ctx->arr_rank_tree = arr_rank_tree;
+            ctx->arr_rank_slots = arr_rank_slots;
+            ctx->arr_rank_stamps = arr_rank_stamps;
+            _uni_common_lrumap_rank_rebuild(ctx);
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
 //
 // Functions/Getters
 //
@@ -228,10 +721,7 @@ size_t uni_common_lrumap_capacity(const uni_common_lrumap_context_t *ctx) {
     size_t result = 0U;
 
     if (uni_common_lrumap_initialized(ctx)) {
-        result = uni_common_array_length(ctx->arr_link_prev);
-        result = uni_common_math_min(result, uni_common_array_length(ctx->arr_link_next));
-        result = uni_common_math_min(result, uni_common_array_length(ctx->arr_keys));
-        result = uni_common_math_min(result, uni_common_array_length(ctx->arr_vals));
+        result = _uni_common_lrumap_capacity(ctx);
     }
 
     return result;
@@ -264,11 +754,7 @@ size_t uni_common_lrumap_length(const uni_common_lrumap_context_t *ctx) {
     size_t result = 0U;
 
     if (uni_common_lrumap_initialized(ctx)) {
-        size_t slot = ctx->slot_first;
-        while (slot != SIZE_MAX) {
-            slot = *(size_t *)uni_common_array_get(ctx->arr_link_next, slot);
-            result++;
-        }
+        result = ctx->length;
     }
 
     return result;
@@ -297,10 +783,9 @@ bool uni_common_lrumap_enum(uni_common_lrumap_context_t *ctx, uni_common_lrumap_
     if (uni_common_lrumap_initialized(ctx) && func != NULL) {
         size_t slot = ctx->slot_first;
         while (slot != SIZE_MAX) {
-            size_t *slot_key = (size_t *)uni_common_array_get(ctx->arr_keys, slot);
-            func(*slot_key, uni_common_array_get(ctx->arr_vals, slot));
+            func(_uni_common_lrumap_key(ctx, slot), uni_common_array_get(ctx->arr_vals, slot));
 
-            slot = *(size_t *)uni_common_array_get(ctx->arr_link_next, slot);
+            slot = _uni_common_lrumap_link_next(ctx, slot);
         }
         result = true;
     }
@@ -312,7 +797,7 @@ bool uni_common_lrumap_enum(uni_common_lrumap_context_t *ctx, uni_common_lrumap_
 uint8_t *uni_common_lrumap_get(uni_common_lrumap_context_t *ctx, size_t key) {
     uint8_t *result = NULL;
 
-    if (uni_common_lrumap_initialized(ctx)) {
+    if (uni_common_lrumap_initialized(ctx) && key != SIZE_MAX) {
         size_t slot = _uni_common_lrumap_get_slot_bykey(ctx, key);
         if (slot != SIZE_MAX) {
             result = uni_common_array_get(ctx->arr_vals, slot);
@@ -351,29 +836,32 @@ uint8_t *uni_common_lrumap_get_last(uni_common_lrumap_context_t *ctx) {
 bool uni_common_lrumap_get_idx(uni_common_lrumap_context_t *ctx, size_t idx, size_t *key, void *val) {
     bool result = false;
 
-    if (uni_common_lrumap_initialized(ctx) && idx < uni_common_lrumap_capacity(ctx) && (key != NULL || val != NULL) && ctx->slot_first != SIZE_MAX) {
-        size_t slot = ctx->slot_first;
+    if (uni_common_lrumap_initialized(ctx) && idx < ctx->length && (key != NULL || val != NULL)) {
+        size_t slot = SIZE_MAX;
 
-        size_t i = 0;
-        while (i < idx) {
-            slot = *(size_t *)uni_common_array_get(ctx->arr_link_next, slot);
-            if (slot == SIZE_MAX) {
-                break;
+        if (ctx->arr_rank_tree != NULL) {
+            slot = _uni_common_lrumap_rank_select(ctx, idx);
+        } else if (idx < ctx->length / 2U) {
+            slot = ctx->slot_first;
+            for (size_t i = 0; i < idx; i++) {
+                slot = _uni_common_lrumap_link_next(ctx, slot);
             }
-            i++;
-        }
-
-        if (i == idx) {
-            if (key != NULL) {
-                memcpy(key, uni_common_array_get(ctx->arr_keys, slot), uni_common_array_itemsize(ctx->arr_keys));
+        } else {
+            slot = ctx->slot_last;
+            for (size_t i = ctx->length - 1U; i > idx; i--) {
+                slot = _uni_common_lrumap_link_prev(ctx, slot);
             }
+        }
 
-            if (val != NULL) {
-                memcpy(val, uni_common_array_get(ctx->arr_vals, slot), uni_common_array_itemsize(ctx->arr_vals));
-            }
+        if (key != NULL) {
+            *key = _uni_common_lrumap_key(ctx, slot);
+        }
 
-            result = true;
+        if (val != NULL) {
+            memcpy(val, uni_common_array_get(ctx->arr_vals, slot), uni_common_array_itemsize(ctx->arr_vals));
         }
+
+        result = true;
     }
 
     return result;
@@ -383,15 +871,10 @@ bool uni_common_lrumap_get_idx(uni_common_lrumap_context_t *ctx, size_t idx, siz
 bool uni_common_lrumap_remove(uni_common_lrumap_context_t *ctx, size_t key) {
     bool result = false;
 
-    if (uni_common_lrumap_initialized(ctx)) {
+    if (uni_common_lrumap_initialized(ctx) && key != SIZE_MAX) {
         size_t slot = _uni_common_lrumap_get_slot_bykey(ctx, key);
         if (slot != SIZE_MAX) {
-            // unlink slot
-            _uni_common_lrumap_remove_slot(ctx, slot);
-
-            // mark key as non-existent
-            uni_common_array_set(ctx->arr_keys, slot, (const uint8_t *)&_sizemax);
-
+            _uni_common_lrumap_release_slot(ctx, slot);
             result = true;
         }
     }
@@ -407,12 +890,7 @@ bool uni_common_lrumap_remove_first(uni_common_lrumap_context_t *ctx) {
         size_t slot_target = ctx->slot_first;
 
         if (slot_target != SIZE_MAX) {
-            // unlink slot
-            _uni_common_lrumap_remove_slot(ctx, slot_target);
-
-            // mark key as non-existent
-            uni_common_array_set(ctx->arr_keys, slot_target, (const uint8_t *)&_sizemax);
-
+            _uni_common_lrumap_release_slot(ctx, slot_target);
             result = true;
         }
     }
@@ -428,12 +906,7 @@ bool uni_common_lrumap_remove_last(uni_common_lrumap_context_t *ctx) {
         size_t slot_target = ctx->slot_last;
 
         if (slot_target != SIZE_MAX) {
-            // unlink slot
-            _uni_common_lrumap_remove_slot(ctx, slot_target);
-
-            // mark key as non-existent
-            uni_common_array_set(ctx->arr_keys, slot_target, (const uint8_t *)&_sizemax);
-
+            _uni_common_lrumap_release_slot(ctx, slot_target);
             result = true;
         }
     }
@@ -447,7 +920,7 @@ bool uni_common_lrumap_update(uni_common_lrumap_context_t *ctx, size_t key, cons
 
     size_t idx = SIZE_MAX;
 
-    if (uni_common_lrumap_initialized(ctx)) {
+    if (uni_common_lrumap_initialized(ctx) && key != SIZE_MAX) {
         // find if it exists
         idx = _uni_common_lrumap_get_slot_bykey(ctx, key);
         if (idx != SIZE_MAX) {
@@ -462,6 +935,10 @@ bool uni_common_lrumap_update(uni_common_lrumap_context_t *ctx, size_t key, cons
             if (idx != SIZE_MAX) {
                 _uni_common_lrumap_set_slot(ctx, idx, key, val);
                 _uni_common_lrumap_append_slot(ctx, idx);
+                ctx->length++;
+                if (ctx->arr_index != NULL) {
+                    _uni_common_lrumap_index_insert(ctx, key, idx);
+                }
                 result = true;
             }
         }
@@ -470,8 +947,14 @@ bool uni_common_lrumap_update(uni_common_lrumap_context_t *ctx, size_t key, cons
         if (!result) {
             idx = ctx->slot_first;
             if (idx != SIZE_MAX) {
+                if (ctx->arr_index != NULL) {
+                    _uni_common_lrumap_index_remove(ctx, _uni_common_lrumap_key(ctx, idx));
+                }
                 _uni_common_lrumap_set_slot(ctx, idx, key, val);
                 _uni_common_lrumap_refresh_slot(ctx, idx);
+                if (ctx->arr_index != NULL) {
+                    _uni_common_lrumap_index_insert(ctx, key, idx);
+                }
                 result = true;
             }
         }
@@ -5,10 +5,36 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "uni_common_bytes.h"
 #include "uni_common_compiler.h"
+#include "uni_common_hash.h"
 #include "uni_common_map.h"
 #include "uni_common_math.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define UNI_COMMON_MAP_SWISS_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define UNI_COMMON_MAP_SWISS_NEON
+#endif
+
+
+
+//
+// Defines
+//
+
+/**
+ * Control byte of the empty slot
+ */
+#define UNI_COMMON_MAP_SWISS_EMPTY 0x80U
+
+/**
+ * Control byte of the removed slot (tombstone)
+ */
+#define UNI_COMMON_MAP_SWISS_DELETED 0xFEU
+
 
 
 //
@@ -23,35 +49,508 @@
 static void _uni_common_map_clear(uni_common_map_context_t *ctx) {
     uni_common_array_fill(ctx->config.keys, 0xFF);
     uni_common_array_fill(ctx->config.vals, 0xFF);
-    ctx->state.capacity = 0U;
+    if (ctx->config.mode == UNI_COMMON_MAP_MODE_SWISS) {
+        uni_common_array_fill(ctx->config.ctrl, UNI_COMMON_MAP_SWISS_EMPTY);
+    }
+    if (ctx->config.occupancy != NULL) {
+        uni_common_array_fill(ctx->config.occupancy, 0x00);
+    }
     ctx->state.size = 0U;
+    ctx->state.tombstones = 0U;
 }
 
 
 /**
- * Gets array index for the given object ID
- * @param ctx pointer to the LRU cache context
+ * Marks the slot as used in the occupancy bitmap
+ * @param ctx pointer to the map context
+ * @param slot slot number
+ *
+ * @note does nothing when bitmap is not attached
+ * @note input data must be valid
+ */
+static void _uni_common_map_occupancy_set(uni_common_map_context_t *ctx, size_t slot) {
+    if (ctx->config.occupancy != NULL) {
+        ((uint64_t *)ctx->config.occupancy->data)[slot / 64U] |= 1ULL << (slot % 64U);
+    }
+}
+
+
+/**
+ * Marks the slot as free in the occupancy bitmap
+ * @param ctx pointer to the map context
+ * @param slot slot number
+ *
+ * @note does nothing when bitmap is not attached
+ * @note input data must be valid
+ */
+static void _uni_common_map_occupancy_reset(uni_common_map_context_t *ctx, size_t slot) {
+    if (ctx->config.occupancy != NULL) {
+        ((uint64_t *)ctx->config.occupancy->data)[slot / 64U] &= ~(1ULL << (slot % 64U));
+    }
+}
+
+
+/**
+ * Rebuilds the occupancy bitmap from the keys array
+ * @param ctx pointer to the map context
+ *
+ * @note does nothing when bitmap is not attached
+ * @note input data must be valid
+ */
+static void _uni_common_map_occupancy_rebuild(uni_common_map_context_t *ctx) {
+    if (ctx->config.occupancy != NULL) {
+        const size_t *keys = (const size_t *)ctx->config.keys->data;
+        uni_common_array_fill(ctx->config.occupancy, 0x00);
+        for (size_t slot = 0U; slot < ctx->state.capacity; slot++) {
+            if (keys[slot] != SIZE_MAX) {
+                _uni_common_map_occupancy_set(ctx, slot);
+            }
+        }
+    }
+}
+
+
+/**
+ * Returns home slot of the key in hash mode
+ * @param ctx pointer to the map context
+ * @param key key of the object
+ * @return slot where probing for the key starts
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_hash_home(const uni_common_map_context_t *ctx, size_t key) {
+    return uni_common_hash_reduce(uni_common_hash_size(key), ctx->state.capacity);
+}
+
+
+/**
+ * Probes hash table for the given key starting from the already calculated home slot
+ * @param ctx pointer to the map context
  * @param key key of the object
+ * @param home home slot of the key
+ * @param slot_empty pointer which will contain first empty slot of the probe sequence, SIZE_MAX if table is full
  * @return index of the object, SIZE_MAX if element was not found
  *
  * @note input data must be valid
  */
-static size_t _uni_common_map_get_slot_bykey(uni_common_map_context_t *ctx, size_t key) {
+static size_t _uni_common_map_hash_probe_from(const uni_common_map_context_t *ctx, size_t key, size_t home, size_t *slot_empty) {
     size_t result = SIZE_MAX;
+    size_t empty = SIZE_MAX;
 
-    size_t capacity = uni_common_map_capacity(ctx);
-    for (size_t slot = 0; slot < capacity; slot++) {
-        size_t *slot_key = (size_t *)uni_common_array_get(ctx->config.keys, slot);
-        if (*slot_key == key) {
+    const size_t *keys = (const size_t *)ctx->config.keys->data;
+    size_t capacity = ctx->state.capacity;
+    size_t slot = home;
+    for (size_t probe = 0U; probe < capacity; probe++) {
+        size_t slot_key = keys[slot];
+        if (slot_key == key) {
             result = slot;
             break;
         }
+        if (slot_key == SIZE_MAX) {
+            empty = slot;
+            break;
+        }
+
+        slot++;
+        if (slot == capacity) {
+            slot = 0U;
+        }
+    }
+
+    if (slot_empty != NULL) {
+        *slot_empty = empty;
+    }
+
+    return result;
+}
+
+
+/**
+ * Returns bit mask of the group slots which control bytes are equal to the given one
+ * @param group pointer to the first control byte of the group
+ * @param value control byte to compare with
+ * @return bit mask, bit N is set when slot N matches
+ *
+ * @note input data must be valid
+ */
+static uint32_t _uni_common_map_swiss_match(const uint8_t *group, uint8_t value) {
+    uint32_t result = 0U;
+
+#if defined(UNI_COMMON_MAP_SWISS_SSE2)
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    result = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)value)));
+#elif defined(UNI_COMMON_MAP_SWISS_NEON)
+    static const uint8_t weights[16] = {1U, 2U, 4U, 8U, 16U, 32U, 64U, 128U, 1U, 2U, 4U, 8U, 16U, 32U, 64U, 128U};
+    uint8x16_t bits = vandq_u8(vceqq_u8(vld1q_u8(group), vdupq_n_u8(value)), vld1q_u8(weights));
+    result = (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8U);
+#else
+    for (uint32_t idx = 0U; idx < UNI_COMMON_MAP_SWISS_GROUP; idx++) {
+        if (group[idx] == value) {
+            result |= 1U << idx;
+        }
+    }
+#endif
+
+    return result;
+}
+
+
+/**
+ * Returns bit mask of the group slots which are empty or removed
+ * @param group pointer to the first control byte of the group
+ * @return bit mask, bit N is set when slot N is free
+ *
+ * @note both markers have the top bit set, while the hash fragments of used slots have it clear
+ * @note input data must be valid
+ */
+static uint32_t _uni_common_map_swiss_match_free(const uint8_t *group) {
+    uint32_t result = 0U;
+
+#if defined(UNI_COMMON_MAP_SWISS_SSE2)
+    result = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#elif defined(UNI_COMMON_MAP_SWISS_NEON)
+    static const uint8_t weights[16] = {1U, 2U, 4U, 8U, 16U, 32U, 64U, 128U, 1U, 2U, 4U, 8U, 16U, 32U, 64U, 128U};
+    uint8x16_t bits = vandq_u8(vtstq_u8(vld1q_u8(group), vdupq_n_u8(0x80U)), vld1q_u8(weights));
+    result = (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8U);
+#else
+    for (uint32_t idx = 0U; idx < UNI_COMMON_MAP_SWISS_GROUP; idx++) {
+        if ((group[idx] & 0x80U) != 0U) {
+            result |= 1U << idx;
+        }
     }
+#endif
 
     return result;
 }
 
 
+/**
+ * Returns home group of the hash in swiss mode
+ * @param ctx pointer to the map context
+ * @param hash hash of the key
+ * @return index of the group where probing starts
+ *
+ * @note low 7 bits are the control byte, so the group is selected by the high bits
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_swiss_home(const uni_common_map_context_t *ctx, uint64_t hash) {
+    return uni_common_hash_reduce(hash, ctx->state.capacity / UNI_COMMON_MAP_SWISS_GROUP);
+}
+
+
+/**
+ * Looks up the key in swiss mode
+ * @param ctx pointer to the map context
+ * @param key key of the object
+ * @param hash hash of the key
+ * @return index of the object, SIZE_MAX if element was not found
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_swiss_find(const uni_common_map_context_t *ctx, size_t key, uint64_t hash) {
+    size_t result = SIZE_MAX;
+
+    const uint8_t *ctrl = ctx->config.ctrl->data;
+    const size_t *keys = (const size_t *)ctx->config.keys->data;
+    size_t groups = ctx->state.capacity / UNI_COMMON_MAP_SWISS_GROUP;
+    size_t group = _uni_common_map_swiss_home(ctx, hash);
+    uint8_t fragment = (uint8_t)(hash & 0x7FU);
+
+    for (size_t probe = 0U; probe < groups && result == SIZE_MAX; probe++) {
+        const uint8_t *group_ctrl = &ctrl[group * UNI_COMMON_MAP_SWISS_GROUP];
+
+        uint32_t match = _uni_common_map_swiss_match(group_ctrl, fragment);
+        while (match != 0U) {
+            size_t slot = group * UNI_COMMON_MAP_SWISS_GROUP + uni_common_bytes_ctz32(match);
+            if (keys[slot] == key) {
+                result = slot;
+                break;
+            }
+            match &= match - 1U;
+        }
+
+        // group with an empty slot was never full, so the key could not be pushed past it
+        if (_uni_common_map_swiss_match(group_ctrl, UNI_COMMON_MAP_SWISS_EMPTY) != 0U) {
+            break;
+        }
+
+        group++;
+        if (group == groups) {
+            group = 0U;
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Finds first free slot of the probe sequence in swiss mode
+ * @param ctx pointer to the map context
+ * @param hash hash of the key
+ * @return index of the slot, SIZE_MAX if table is full
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_swiss_find_free(const uni_common_map_context_t *ctx, uint64_t hash) {
+    size_t result = SIZE_MAX;
+
+    const uint8_t *ctrl = ctx->config.ctrl->data;
+    size_t groups = ctx->state.capacity / UNI_COMMON_MAP_SWISS_GROUP;
+    size_t group = _uni_common_map_swiss_home(ctx, hash);
+
+    for (size_t probe = 0U; probe < groups; probe++) {
+        uint32_t match = _uni_common_map_swiss_match_free(&ctrl[group * UNI_COMMON_MAP_SWISS_GROUP]);
+        if (match != 0U) {
+            result = group * UNI_COMMON_MAP_SWISS_GROUP + uni_common_bytes_ctz32(match);
+            break;
+        }
+
+        group++;
+        if (group == groups) {
+            group = 0U;
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Finds free slot for the new key in swiss mode and marks it with the hash fragment
+ * @param ctx pointer to the map context
+ * @param hash hash of the key
+ * @return index of the slot, SIZE_MAX if table is full
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_swiss_insert(uni_common_map_context_t *ctx, uint64_t hash) {
+    size_t result = _uni_common_map_swiss_find_free(ctx, hash);
+
+    if (result != SIZE_MAX) {
+        uint8_t *ctrl = ctx->config.ctrl->data;
+        if (ctrl[result] == UNI_COMMON_MAP_SWISS_DELETED) {
+            ctx->state.tombstones--;
+        }
+        ctrl[result] = (uint8_t)(hash & 0x7FU);
+    }
+
+    return result;
+}
+
+
+/**
+ * Swaps content of two slots
+ * @param ctx pointer to the map context
+ * @param slot_a first slot number
+ * @param slot_b second slot number
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_map_swap_slots(uni_common_map_context_t *ctx, size_t slot_a, size_t slot_b) {
+    size_t *keys = (size_t *)ctx->config.keys->data;
+    size_t key = keys[slot_a];
+    keys[slot_a] = keys[slot_b];
+    keys[slot_b] = key;
+
+    uint8_t *val_a = uni_common_array_get(ctx->config.vals, slot_a);
+    uint8_t *val_b = uni_common_array_get(ctx->config.vals, slot_b);
+    for (size_t idx = 0U; idx < ctx->config.vals->size_item; idx++) {
+        uint8_t byte = val_a[idx];
+        val_a[idx] = val_b[idx];
+        val_b[idx] = byte;
+    }
+}
+
+
+/**
+ * Drops all tombstones of swiss mode by rehashing the table in place
+ * @param ctx pointer to the map context
+ *
+ * @note used slots are marked as deleted first, then every marked key is moved to the first free slot of its
+ * probe sequence, swapping with the marked key which occupies it
+ * @note input data must be valid
+ */
+static void _uni_common_map_swiss_rehash(uni_common_map_context_t *ctx) {
+    uint8_t *ctrl = ctx->config.ctrl->data;
+    size_t *keys = (size_t *)ctx->config.keys->data;
+
+    for (size_t slot = 0U; slot < ctx->state.capacity; slot++) {
+        ctrl[slot] = (ctrl[slot] & 0x80U) != 0U ? UNI_COMMON_MAP_SWISS_EMPTY : UNI_COMMON_MAP_SWISS_DELETED;
+    }
+
+    for (size_t slot = 0U; slot < ctx->state.capacity; slot++) {
+        while (ctrl[slot] == UNI_COMMON_MAP_SWISS_DELETED) {
+            uint64_t hash = uni_common_hash_size(keys[slot]);
+            uint8_t fragment = (uint8_t)(hash & 0x7FU);
+            size_t target = _uni_common_map_swiss_find_free(ctx, hash);
+
+            if (target / UNI_COMMON_MAP_SWISS_GROUP == slot / UNI_COMMON_MAP_SWISS_GROUP) {
+                ctrl[slot] = fragment;
+            } else if (ctrl[target] == UNI_COMMON_MAP_SWISS_EMPTY) {
+                _uni_common_map_swap_slots(ctx, slot, target);
+                ctrl[target] = fragment;
+                ctrl[slot] = UNI_COMMON_MAP_SWISS_EMPTY;
+            } else {
+                // target holds another marked key, it is processed in the next iteration
+                _uni_common_map_swap_slots(ctx, slot, target);
+                ctrl[target] = fragment;
+            }
+        }
+    }
+
+    ctx->state.tombstones = 0U;
+    _uni_common_map_occupancy_rebuild(ctx);
+}
+
+
+/**
+ * Removes the given slot in swiss mode
+ * @param ctx pointer to the map context
+ * @param slot slot number
+ *
+ * @note slot becomes empty when its group has another empty slot (no probe sequence continues past such group),
+ * otherwise it becomes tombstone
+ * @note tombstones are dropped by the caller, the migration must not see the slots moved by the rehash
+ * @note input data must be valid
+ */
+static void _uni_common_map_swiss_remove_slot(uni_common_map_context_t *ctx, size_t slot) {
+    uint8_t *ctrl = ctx->config.ctrl->data;
+    const uint8_t *group_ctrl = &ctrl[slot - slot % UNI_COMMON_MAP_SWISS_GROUP];
+
+    ((size_t *)ctx->config.keys->data)[slot] = SIZE_MAX;
+    _uni_common_map_occupancy_reset(ctx, slot);
+    if (_uni_common_map_swiss_match(group_ctrl, UNI_COMMON_MAP_SWISS_EMPTY) != 0U) {
+        ctrl[slot] = UNI_COMMON_MAP_SWISS_EMPTY;
+    } else {
+        ctrl[slot] = UNI_COMMON_MAP_SWISS_DELETED;
+        ctx->state.tombstones++;
+    }
+}
+
+
+/**
+ * Hashes the batch keys and prefetches the lines which are probed first
+ * @param ctx pointer to the map context
+ * @param keys pointer to the batch keys
+ * @param count number of keys, must be <= UNI_COMMON_MAP_BATCH_CHUNK
+ * @param hashes pointer to the output hashes
+ *
+ * @note all lines are requested before the first one is used, so the memory latency of the batch overlaps
+ * @note input data must be valid
+ */
+static void _uni_common_map_batch_prefetch(const uni_common_map_context_t *ctx, const size_t *keys, size_t count, uint64_t *hashes) {
+    const size_t *slot_keys = (const size_t *)ctx->config.keys->data;
+    const uint8_t *slot_vals = ctx->config.vals->data;
+    size_t size_item = ctx->config.vals->size_item;
+
+    for (size_t idx = 0U; idx < count; idx++) {
+        hashes[idx] = uni_common_hash_size(keys[idx]);
+
+        if (ctx->config.mode == UNI_COMMON_MAP_MODE_HASH) {
+            size_t home = uni_common_hash_reduce(hashes[idx], ctx->state.capacity);
+            UNI_COMMON_COMPILER_PREFETCH(&slot_keys[home]);
+            UNI_COMMON_COMPILER_PREFETCH(&slot_vals[home * size_item]);
+        } else if (ctx->config.mode == UNI_COMMON_MAP_MODE_SWISS) {
+            size_t home = _uni_common_map_swiss_home(ctx, hashes[idx]) * UNI_COMMON_MAP_SWISS_GROUP;
+            UNI_COMMON_COMPILER_PREFETCH(&ctx->config.ctrl->data[home]);
+            UNI_COMMON_COMPILER_PREFETCH(&slot_keys[home]);
+        }
+    }
+}
+
+
+/**
+ * Removes the given slot from the hash table and shifts the rest of the probe sequence backward
+ * @param ctx pointer to the map context
+ * @param slot slot number
+ *
+ * @note no tombstones are left, so lookups never have to skip deleted slots
+ * @note input data must be valid
+ */
+static void _uni_common_map_hash_remove_slot(uni_common_map_context_t *ctx, size_t slot) {
+    size_t *keys = (size_t *)ctx->config.keys->data;
+    size_t capacity = ctx->state.capacity;
+
+    size_t hole = slot;
+    size_t next = slot;
+    for (size_t probe = 1U; probe < capacity; probe++) {
+        next++;
+        if (next == capacity) {
+            next = 0U;
+        }
+
+        size_t next_key = keys[next];
+        if (next_key == SIZE_MAX) {
+            break;
+        }
+
+        // element can be moved into the hole if the hole lies between its home and current position
+        size_t home = _uni_common_map_hash_home(ctx, next_key);
+        size_t dist_hole = hole >= home ? hole - home : hole + capacity - home;
+        size_t dist_next = next >= home ? next - home : next + capacity - home;
+        if (dist_hole < dist_next) {
+            keys[hole] = next_key;
+            uni_common_array_set(ctx->config.vals, hole, uni_common_array_get(ctx->config.vals, next));
+            hole = next;
+        }
+    }
+
+    keys[hole] = SIZE_MAX;
+    _uni_common_map_occupancy_reset(ctx, hole);
+}
+
+
+/**
+ * Gets array index for the given object ID
+ * @param ctx pointer to the LRU cache context
+ * @param key key of the object
+ * @param hash hash of the key, ignored in linear mode
+ * @return index of the object, SIZE_MAX if element was not found
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_get_slot_byhash(uni_common_map_context_t *ctx, size_t key, uint64_t hash) {
+    size_t result = SIZE_MAX;
+
+    if (ctx->config.mode == UNI_COMMON_MAP_MODE_HASH) {
+        result = _uni_common_map_hash_probe_from(ctx, key, uni_common_hash_reduce(hash, ctx->state.capacity), NULL);
+    } else if (ctx->config.mode == UNI_COMMON_MAP_MODE_SWISS) {
+        result = _uni_common_map_swiss_find(ctx, key, hash);
+    } else {
+        size_t capacity = uni_common_map_capacity(ctx);
+        for (size_t slot = 0; slot < capacity; slot++) {
+            size_t *slot_key = (size_t *)uni_common_array_get(ctx->config.keys, slot);
+            if (*slot_key == key) {
+                result = slot;
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Gets array index for the given object ID
+ * @param ctx pointer to the LRU cache context
+ * @param key key of the object
+ * @return index of the object, SIZE_MAX if element was not found
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_get_slot_bykey(uni_common_map_context_t *ctx, size_t key) {
+    uint64_t hash = 0U;
+
+    if (ctx->config.mode != UNI_COMMON_MAP_MODE_LINEAR) {
+        hash = uni_common_hash_size(key);
+    }
+
+    return _uni_common_map_get_slot_byhash(ctx, key, hash);
+}
+
+
 /**
  * Get first empty slot
  * @param ctx pointer to the LRU context
@@ -63,10 +562,24 @@ static size_t _uni_common_map_get_slot_empty(uni_common_map_context_t *ctx) {
     size_t result = SIZE_MAX;
 
     size_t capacity = uni_common_map_capacity(ctx);
-    for (size_t slot = 0; slot < capacity; slot++) {
-        if (*(size_t*)uni_common_array_get(ctx->config.keys, slot) == SIZE_MAX) {
-            result = slot;
-            break;
+    if (ctx->config.occupancy != NULL) {
+        const uint64_t *occupancy = (const uint64_t *)ctx->config.occupancy->data;
+        for (size_t word = 0U; word < UNI_COMMON_MAP_OCCUPANCY_WORDS(capacity); word++) {
+            uint64_t unused = ~occupancy[word];
+            if (unused != 0U) {
+                size_t slot = word * 64U + uni_common_bytes_ctz64(unused);
+                if (slot < capacity) {
+                    result = slot;
+                }
+                break;
+            }
+        }
+    } else {
+        for (size_t slot = 0; slot < capacity; slot++) {
+            if (*(size_t*)uni_common_array_get(ctx->config.keys, slot) == SIZE_MAX) {
+                result = slot;
+                break;
+            }
         }
     }
 
@@ -83,7 +596,14 @@ static size_t _uni_common_map_get_slot_empty(uni_common_map_context_t *ctx) {
  * @note input data must be valid
  */
 static void _uni_common_map_remove_slot(uni_common_map_context_t *ctx, size_t slot) {
-    *(size_t*)uni_common_array_get(ctx->config.keys, slot) = SIZE_MAX;
+    if (ctx->config.mode == UNI_COMMON_MAP_MODE_HASH) {
+        _uni_common_map_hash_remove_slot(ctx, slot);
+    } else if (ctx->config.mode == UNI_COMMON_MAP_MODE_SWISS) {
+        _uni_common_map_swiss_remove_slot(ctx, slot);
+    } else {
+        *(size_t*)uni_common_array_get(ctx->config.keys, slot) = SIZE_MAX;
+        _uni_common_map_occupancy_reset(ctx, slot);
+    }
 }
 
 
@@ -105,21 +625,258 @@ static void _uni_common_map_set_slot(uni_common_map_context_t *ctx, size_t slot,
 
 
 
+/**
+ * Inserts or updates the element
+ * @param ctx pointer to the map context
+ * @param key key value, must not be SIZE_MAX
+ * @param hash hash of the key, ignored in linear mode
+ * @param val data value
+ * @return true on success
+ *
+ * @note input data must be valid
+ */
+static bool _uni_common_map_set_key(uni_common_map_context_t *ctx, size_t key, uint64_t hash, const void *val) {
+    bool result = false;
+
+    size_t idx = SIZE_MAX;
+    bool newrecord = false;
+
+    // find if it exists
+    if (ctx->config.mode == UNI_COMMON_MAP_MODE_HASH) {
+        size_t idx_empty = SIZE_MAX;
+        idx = _uni_common_map_hash_probe_from(ctx, key, uni_common_hash_reduce(hash, ctx->state.capacity), &idx_empty);
+        if (idx == SIZE_MAX && ctx->state.size < ctx->state.capacity) {
+            idx = idx_empty;
+            newrecord = true;
+        }
+    } else if (ctx->config.mode == UNI_COMMON_MAP_MODE_SWISS) {
+        idx = _uni_common_map_swiss_find(ctx, key, hash);
+        if (idx == SIZE_MAX && ctx->state.size < ctx->state.capacity) {
+            idx = _uni_common_map_swiss_insert(ctx, hash);
+            newrecord = true;
+        }
+    } else {
+        idx = _uni_common_map_get_slot_bykey(ctx, key);
+        if (idx == SIZE_MAX && ctx->state.size < ctx->state.capacity) {
+            idx = _uni_common_map_get_slot_empty(ctx);
+            newrecord = true;
+        }
+    }
+
+    if(idx != SIZE_MAX){
+        _uni_common_map_set_slot(ctx, idx, key, val);
+        result = true;
+        if(newrecord) {
+            _uni_common_map_occupancy_set(ctx, idx);
+            ctx->state.size++;
+        }
+    }
+
+    return result;
+}
+
+
+
+/**
+ * Enumerates used slots of the table
+ * @param ctx pointer to the map context
+ * @param func pointer to the enumerator function
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_map_enum(const uni_common_map_context_t *ctx, uni_common_map_enum_func_t func) {
+    if (ctx->config.occupancy != NULL) {
+        const uint64_t *occupancy = (const uint64_t *)ctx->config.occupancy->data;
+        const size_t *keys = (const size_t *)ctx->config.keys->data;
+        for (size_t word = 0U; word < UNI_COMMON_MAP_OCCUPANCY_WORDS(ctx->state.capacity); word++) {
+            uint64_t used = occupancy[word];
+            while (used != 0U) {
+                size_t slot = word * 64U + uni_common_bytes_ctz64(used);
+                func(keys[slot], uni_common_array_get(ctx->config.vals, slot));
+                used &= used - 1U;
+            }
+        }
+    } else {
+        for(size_t idx = 0U; idx < ctx->state.capacity; idx++) {
+            size_t slot_key = *(size_t *)uni_common_array_get(ctx->config.keys, idx);
+            if (slot_key != SIZE_MAX) {
+                func(slot_key, uni_common_array_get(ctx->config.vals, idx));
+            }
+        }
+    }
+}
+
+
+/**
+ * Returns context of the table which is drained by the migration
+ * @param ctx pointer to the map context
+ * @return copy of the old table context, its state must be stored back after modification
+ *
+ * @note input data must be valid
+ */
+static uni_common_map_context_t _uni_common_map_migration_table(const uni_common_map_context_t *ctx) {
+    uni_common_map_context_t result = {
+        .config = ctx->migration.config,
+        .state = ctx->migration.state,
+    };
+
+    return result;
+}
+
+
+/**
+ * Checks that two arrays share some bytes
+ * @param lhs pointer to the first array, may be NULL
+ * @param rhs pointer to the second array, may be NULL
+ * @return true if both arrays are present and their buffers overlap
+ */
+static bool _uni_common_map_array_overlap(const uni_common_array_t *lhs, const uni_common_array_t *rhs) {
+    bool result = false;
+
+    if (lhs != NULL && rhs != NULL) {
+        uintptr_t lhs_begin = (uintptr_t)lhs->data;
+        uintptr_t rhs_begin = (uintptr_t)rhs->data;
+        result = lhs_begin < rhs_begin + rhs->size && rhs_begin < lhs_begin + lhs->size;
+    }
+
+    return result;
+}
+
+
+/**
+ * Checks that any array of one map configuration overlaps with any array of the other one
+ * @param lhs pointer to the first configuration
+ * @param rhs pointer to the second configuration
+ * @return true if some keys/vals/ctrl/occupancy buffers overlap
+ *
+ * @note input data must be valid
+ */
+static bool _uni_common_map_config_overlap(const uni_common_map_config_t *lhs, const uni_common_map_config_t *rhs) {
+    bool result = false;
+
+    const uni_common_array_t *lhs_arrays[4] = {lhs->keys, lhs->vals, lhs->ctrl, lhs->occupancy};
+    const uni_common_array_t *rhs_arrays[4] = {rhs->keys, rhs->vals, rhs->ctrl, rhs->occupancy};
+    for (size_t lhs_idx = 0U; lhs_idx < 4U && !result; lhs_idx++) {
+        for (size_t rhs_idx = 0U; rhs_idx < 4U && !result; rhs_idx++) {
+            result = _uni_common_map_array_overlap(lhs_arrays[lhs_idx], rhs_arrays[rhs_idx]);
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Looks up the key in the table which is drained by the migration
+ * @param ctx pointer to the map context, migration must be in progress
+ * @param key key of the object
+ * @return pointer to the element value, NULL if the old table does not contain the key
+ *
+ * @note input data must be valid
+ */
+static uint8_t *_uni_common_map_migration_get(const uni_common_map_context_t *ctx, size_t key) {
+    uint8_t *result = NULL;
+
+    uni_common_map_context_t old = _uni_common_map_migration_table(ctx);
+    size_t slot = _uni_common_map_get_slot_bykey(&old, key);
+    if (slot != SIZE_MAX) {
+        result = uni_common_array_get(old.config.vals, slot);
+    }
+
+    return result;
+}
+
+
+/**
+ * Moves entries of the old table into the new one
+ * @param ctx pointer to the map context
+ * @param slots maximum number of old table slots to visit
+ * @return number of moved entries
+ *
+ * @note every moved entry is removed from the old table, so visited slots stay empty
+ * @note slots are visited downwards from the empty one, so in hash mode the removed entry is always the last one of
+ * its probe sequence and the backward shift stops at once, it also never moves the rest of entries into the
+ * visited slots
+ * @note new table always has room, inserts of the new keys are limited by the total size
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_migrate_step(uni_common_map_context_t *ctx, size_t slots) {
+    size_t result = 0U;
+
+    if (ctx->migration.state.initialized) {
+        uni_common_map_context_t old = _uni_common_map_migration_table(ctx);
+        const size_t *keys = (const size_t *)old.config.keys->data;
+        size_t capacity = old.state.capacity;
+
+        for (size_t visited = 0U; visited < slots && ctx->migration.cursor < capacity; visited++) {
+            size_t slot = (ctx->migration.start + capacity - ctx->migration.cursor) % capacity;
+            size_t key = keys[slot];
+            if (key == SIZE_MAX) {
+                ctx->migration.cursor++;
+            } else {
+                uint64_t hash = 0U;
+                if (ctx->config.mode != UNI_COMMON_MAP_MODE_LINEAR) {
+                    hash = uni_common_hash_size(key);
+                }
+                _uni_common_map_set_key(ctx, key, hash, uni_common_array_get(old.config.vals, slot));
+                _uni_common_map_remove_slot(&old, slot);
+                old.state.size--;
+                result++;
+            }
+        }
+
+        if (ctx->migration.cursor == capacity) {
+            old.state.initialized = false;
+        }
+        ctx->migration.state = old.state;
+    }
+
+    return result;
+}
+
+
 //
 // Functions/Init
 //
 
 bool uni_common_map_init(uni_common_map_context_t *ctx, uni_common_array_t *keys, uni_common_array_t *vals) {
+    uni_common_map_config_t config = {
+        .keys = keys,
+        .vals = vals,
+        .mode = UNI_COMMON_MAP_MODE_LINEAR,
+    };
+
+    return uni_common_map_init_ex(ctx, &config);
+}
+
+
+bool uni_common_map_init_ex(uni_common_map_context_t *ctx, const uni_common_map_config_t *config) {
     bool result = false;
 
-    if (ctx != NULL && keys != NULL && vals != NULL) {
-        ctx->config.keys = keys;
-        ctx->config.vals = vals;
+    if (ctx != NULL && config != NULL && config->keys != NULL && config->vals != NULL &&
+        (config->mode == UNI_COMMON_MAP_MODE_LINEAR || config->mode == UNI_COMMON_MAP_MODE_HASH ||
+         (config->mode == UNI_COMMON_MAP_MODE_SWISS && config->ctrl != NULL))) {
+        ctx->config = *config;
         uni_common_array_set_itemsize(ctx->config.keys, sizeof(size_t));
-        _uni_common_map_clear(ctx);
         ctx->state.capacity = uni_common_math_min(uni_common_array_length(ctx->config.keys), uni_common_array_length((ctx->config.vals)));
-        ctx->state.initialized = true;
-        result = true;
+
+        if (ctx->config.occupancy != NULL) {
+            uni_common_array_set_itemsize(ctx->config.occupancy, sizeof(uint64_t));
+            ctx->state.capacity = uni_common_math_min(ctx->state.capacity, uni_common_array_length(ctx->config.occupancy) * 64U);
+        }
+
+        if (ctx->config.mode == UNI_COMMON_MAP_MODE_SWISS) {
+            uni_common_array_set_itemsize(ctx->config.ctrl, 1U);
+            ctx->state.capacity = uni_common_math_min(ctx->state.capacity, uni_common_array_length(ctx->config.ctrl));
+            ctx->state.capacity -= ctx->state.capacity % UNI_COMMON_MAP_SWISS_GROUP;
+        }
+
+        if (ctx->state.capacity != 0U || ctx->config.mode != UNI_COMMON_MAP_MODE_SWISS) {
+            _uni_common_map_clear(ctx);
+            ctx->migration.state.initialized = false;
+            ctx->state.initialized = true;
+            result = true;
+        }
     }
 
     return result;
@@ -151,11 +908,25 @@ bool uni_common_map_initialized(const uni_common_map_context_t *ctx) {
 }
 
 
+bool uni_common_map_migrating(const uni_common_map_context_t *ctx) {
+    bool result = false;
+
+    if (uni_common_map_initialized(ctx)) {
+        result = ctx->migration.state.initialized;
+    }
+
+    return result;
+}
+
+
 size_t uni_common_map_size(const uni_common_map_context_t *ctx) {
     size_t result = 0U;
 
     if (uni_common_map_initialized(ctx)) {
         result = ctx->state.size;
+        if (ctx->migration.state.initialized) {
+            result += ctx->migration.state.size;
+        }
     }
 
     return result;
@@ -171,6 +942,7 @@ bool uni_common_map_clear(uni_common_map_context_t *ctx) {
 
     if (uni_common_map_initialized(ctx)) {
         _uni_common_map_clear(ctx);
+        ctx->migration.state.initialized = false;
         result = true;
     }
 
@@ -182,11 +954,10 @@ bool uni_common_map_enum(uni_common_map_context_t *ctx, uni_common_map_enum_func
     bool result = false;
 
     if (uni_common_map_initialized(ctx) && func != NULL) {
-        for(size_t idx = 0U; idx < ctx->state.capacity; idx++) {
-            size_t slot_key = *(size_t *)uni_common_array_get(ctx->config.keys, idx);
-            if (slot_key != SIZE_MAX) {
-                func(slot_key, uni_common_array_get(ctx->config.vals, idx));
-            }
+        _uni_common_map_enum(ctx, func);
+        if (ctx->migration.state.initialized) {
+            uni_common_map_context_t old = _uni_common_map_migration_table(ctx);
+            _uni_common_map_enum(&old, func);
         }
         result = true;
     }
@@ -198,10 +969,12 @@ bool uni_common_map_enum(uni_common_map_context_t *ctx, uni_common_map_enum_func
 uint8_t *uni_common_map_get(uni_common_map_context_t *ctx, size_t key) {
     uint8_t *result = NULL;
 
-    if (uni_common_map_initialized(ctx)) {
+    if (uni_common_map_initialized(ctx) && key != SIZE_MAX) {
         size_t slot = _uni_common_map_get_slot_bykey(ctx, key);
         if (slot != SIZE_MAX) {
             result = uni_common_array_get(ctx->config.vals, slot);
+        } else if (ctx->migration.state.initialized) {
+            result = _uni_common_map_migration_get(ctx, key);
         }
     }
 
@@ -212,12 +985,26 @@ uint8_t *uni_common_map_get(uni_common_map_context_t *ctx, size_t key) {
 bool uni_common_map_remove(uni_common_map_context_t *ctx, size_t key) {
     bool result = false;
 
-    if (uni_common_map_initialized(ctx)) {
+    if (uni_common_map_initialized(ctx) && key != SIZE_MAX) {
+        _uni_common_map_migrate_step(ctx, UNI_COMMON_MAP_MIGRATE_STEP);
+
         size_t slot = _uni_common_map_get_slot_bykey(ctx, key);
         if (slot != SIZE_MAX) {
             _uni_common_map_remove_slot(ctx, slot);
             ctx->state.size--;
+            if (ctx->config.mode == UNI_COMMON_MAP_MODE_SWISS && ctx->state.tombstones > ctx->state.capacity / 16U) {
+                _uni_common_map_swiss_rehash(ctx);
+            }
             result = true;
+        } else if (ctx->migration.state.initialized) {
+            uni_common_map_context_t old = _uni_common_map_migration_table(ctx);
+            slot = _uni_common_map_get_slot_bykey(&old, key);
+            if (slot != SIZE_MAX) {
+                _uni_common_map_remove_slot(&old, slot);
+                old.state.size--;
+                ctx->migration.state = old.state;
+                result = true;
+            }
         }
     }
 
@@ -228,25 +1015,129 @@ bool uni_common_map_remove(uni_common_map_context_t *ctx, size_t key) {
 bool uni_common_map_set(uni_common_map_context_t *ctx, size_t key, const void *val) {
     bool result = false;
 
-    size_t idx = SIZE_MAX;
-    bool newrecord = false;
+    if (uni_common_map_initialized(ctx) && key != SIZE_MAX) {
+        _uni_common_map_migrate_step(ctx, UNI_COMMON_MAP_MIGRATE_STEP);
 
-    if (uni_common_map_initialized(ctx)) {
-        // find if it exists
-        idx = _uni_common_map_get_slot_bykey(ctx, key);
-        if (idx == SIZE_MAX && ctx->state.size < ctx->state.capacity) {
-            idx = _uni_common_map_get_slot_empty(ctx);
-            newrecord = true;
+        uint64_t hash = 0U;
+        if (ctx->config.mode != UNI_COMMON_MAP_MODE_LINEAR) {
+            hash = uni_common_hash_size(key);
         }
 
-        if(idx != SIZE_MAX){
-            _uni_common_map_set_slot(ctx, idx, key, val);
-            result = true;
-            if(newrecord) {
-                ctx->state.size++;
+        if (!ctx->migration.state.initialized) {
+            result = _uni_common_map_set_key(ctx, key, hash, val);
+        } else {
+            // key is kept in the old table until the cursor reaches it, new keys must leave room for the old ones
+            uni_common_map_context_t old = _uni_common_map_migration_table(ctx);
+            size_t slot = _uni_common_map_get_slot_bykey(&old, key);
+            if (slot != SIZE_MAX) {
+                uni_common_array_set(old.config.vals, slot, val);
+                result = true;
+            } else if (_uni_common_map_get_slot_byhash(ctx, key, hash) != SIZE_MAX ||
+                       ctx->state.size + old.state.size < ctx->state.capacity) {
+                result = _uni_common_map_set_key(ctx, key, hash, val);
             }
         }
     }
 
     return result;
 }
+
+
+size_t uni_common_map_get_batch(uni_common_map_context_t *ctx, const size_t *keys, size_t count, uint8_t **vals) {
+    size_t result = 0U;
+
+    if (uni_common_map_initialized(ctx) && keys != NULL && vals != NULL) {
+        uint64_t hashes[UNI_COMMON_MAP_BATCH_CHUNK];
+
+        for (size_t base = 0U; base < count; base += UNI_COMMON_MAP_BATCH_CHUNK) {
+            size_t chunk = uni_common_math_min(count - base, (size_t)UNI_COMMON_MAP_BATCH_CHUNK);
+            _uni_common_map_batch_prefetch(ctx, &keys[base], chunk, hashes);
+
+            for (size_t idx = 0U; idx < chunk; idx++) {
+                size_t key = keys[base + idx];
+                size_t slot = SIZE_MAX;
+                if (key != SIZE_MAX) {
+                    slot = _uni_common_map_get_slot_byhash(ctx, key, hashes[idx]);
+                }
+
+                vals[base + idx] = NULL;
+                if (slot != SIZE_MAX) {
+                    vals[base + idx] = uni_common_array_get(ctx->config.vals, slot);
+                    result++;
+                } else if (key != SIZE_MAX && ctx->migration.state.initialized) {
+                    vals[base + idx] = _uni_common_map_migration_get(ctx, key);
+                    result += vals[base + idx] != NULL ? 1U : 0U;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_set_batch(uni_common_map_context_t *ctx, const size_t *keys, size_t count, const void *vals) {
+    size_t result = 0U;
+
+    if (uni_common_map_initialized(ctx) && keys != NULL && vals != NULL && ctx->migration.state.initialized) {
+        size_t size_item = ctx->config.vals->size_item;
+        for (size_t idx = 0U; idx < count; idx++) {
+            if (uni_common_map_set(ctx, keys[idx], &((const uint8_t *)vals)[idx * size_item])) {
+                result++;
+            }
+        }
+    } else if (uni_common_map_initialized(ctx) && keys != NULL && vals != NULL) {
+        uint64_t hashes[UNI_COMMON_MAP_BATCH_CHUNK];
+        size_t size_item = ctx->config.vals->size_item;
+
+        for (size_t base = 0U; base < count; base += UNI_COMMON_MAP_BATCH_CHUNK) {
+            size_t chunk = uni_common_math_min(count - base, (size_t)UNI_COMMON_MAP_BATCH_CHUNK);
+            _uni_common_map_batch_prefetch(ctx, &keys[base], chunk, hashes);
+
+            // keys are applied in order, so the last value of the duplicated key wins as with the scalar loop
+            for (size_t idx = 0U; idx < chunk; idx++) {
+                size_t key = keys[base + idx];
+                if (key != SIZE_MAX && _uni_common_map_set_key(ctx, key, hashes[idx], &((const uint8_t *)vals)[(base + idx) * size_item])) {
+                    result++;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_migrate(uni_common_map_context_t *ctx, const uni_common_map_context_t *table) {
+    bool result = false;
+
+    if (uni_common_map_initialized(ctx) && !ctx->migration.state.initialized && uni_common_map_initialized(table) &&
+        !table->migration.state.initialized && table->state.size == 0U && table->state.capacity >= ctx->state.size &&
+        !_uni_common_map_config_overlap(&table->config, &ctx->config) && table->config.vals->size_item == ctx->config.vals->size_item) {
+        ctx->migration.config = ctx->config;
+        ctx->migration.state = ctx->state;
+        ctx->migration.cursor = 0U;
+        ctx->migration.start = ctx->state.capacity - 1U;
+        if (ctx->config.mode == UNI_COMMON_MAP_MODE_HASH) {
+            ctx->migration.start = uni_common_math_min(_uni_common_map_get_slot_empty(ctx), ctx->migration.start);
+        }
+        ctx->config = table->config;
+        ctx->state = table->state;
+
+        _uni_common_map_migrate_step(ctx, UNI_COMMON_MAP_MIGRATE_STEP);
+        result = true;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_migrate_step(uni_common_map_context_t *ctx, size_t slots) {
+    size_t result = 0U;
+
+    if (uni_common_map_initialized(ctx)) {
+        result = _uni_common_map_migrate_step(ctx, slots);
+    }
+
+    return result;
+}
@@ -0,0 +1,238 @@
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_map_seqlock.h"
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Tells the CPU that the thread is in the busy-wait loop
+ */
+static void _uni_common_map_seqlock_relax(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+
+/**
+ * Waits until the map is stable and starts the read section
+ * @param ctx pointer to the read-mostly map context
+ * @return even sequence value which must be passed to _uni_common_map_seqlock_read_end()
+ * @note input data must be valid
+ */
+static size_t _uni_common_map_seqlock_read_begin(const uni_common_map_seqlock_context_t *ctx) {
+    size_t result = atomic_load_explicit(&ctx->sequence, memory_order_acquire);
+
+    while ((result & 1U) != 0U) {
+        _uni_common_map_seqlock_relax();
+        result = atomic_load_explicit(&ctx->sequence, memory_order_acquire);
+    }
+
+    return result;
+}
+
+
+/**
+ * Finishes the read section
+ * @param ctx pointer to the read-mostly map context
+ * @param sequence value returned by _uni_common_map_seqlock_read_begin()
+ * @return true if no write happened during the section and the read data is consistent
+ * @note input data must be valid
+ */
+static bool _uni_common_map_seqlock_read_end(const uni_common_map_seqlock_context_t *ctx, size_t sequence) {
+    // data loads must not be reordered after the sequence check
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&ctx->sequence, memory_order_relaxed) == sequence;
+}
+
+
+/**
+ * Takes the writer side, spins while the other writer is active
+ * @param ctx pointer to the read-mostly map context
+ * @note input data must be valid
+ */
+static void _uni_common_map_seqlock_write_begin(uni_common_map_seqlock_context_t *ctx) {
+    size_t sequence = atomic_load_explicit(&ctx->sequence, memory_order_relaxed);
+
+    for (;;) {
+        if ((sequence & 1U) == 0U &&
+            atomic_compare_exchange_weak_explicit(&ctx->sequence, &sequence, sequence + 1U, memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+        _uni_common_map_seqlock_relax();
+        sequence = atomic_load_explicit(&ctx->sequence, memory_order_relaxed);
+    }
+
+    // odd sequence must be visible before any data store
+    atomic_thread_fence(memory_order_release);
+}
+
+
+/**
+ * Releases the writer side and publishes the changes
+ * @param ctx pointer to the read-mostly map context
+ * @note input data must be valid
+ */
+static void _uni_common_map_seqlock_write_end(uni_common_map_seqlock_context_t *ctx) {
+    atomic_fetch_add_explicit(&ctx->sequence, 1U, memory_order_release);
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_map_seqlock_init(uni_common_map_seqlock_context_t *ctx, const uni_common_map_config_t *config) {
+    bool result = false;
+
+    if (ctx != NULL) {
+        atomic_store_explicit(&ctx->sequence, 0U, memory_order_relaxed);
+        result = uni_common_map_init_ex(&ctx->map, config);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_map_seqlock_capacity(const uni_common_map_seqlock_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        result = uni_common_map_capacity(&ctx->map);
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_seqlock_initialized(const uni_common_map_seqlock_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL) {
+        result = uni_common_map_initialized(&ctx->map);
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_seqlock_size(const uni_common_map_seqlock_context_t *ctx) {
+    size_t result = 0U;
+
+    if (uni_common_map_seqlock_initialized(ctx)) {
+        size_t sequence = 0U;
+        do {
+            sequence = _uni_common_map_seqlock_read_begin(ctx);
+            result = uni_common_map_size(&ctx->map);
+        } while (!_uni_common_map_seqlock_read_end(ctx, sequence));
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_seqlock_version(const uni_common_map_seqlock_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        result = _uni_common_map_seqlock_read_begin(ctx) / 2U;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Process
+//
+
+bool uni_common_map_seqlock_clear(uni_common_map_seqlock_context_t *ctx) {
+    bool result = false;
+
+    if (uni_common_map_seqlock_initialized(ctx)) {
+        _uni_common_map_seqlock_write_begin(ctx);
+        result = uni_common_map_clear(&ctx->map);
+        _uni_common_map_seqlock_write_end(ctx);
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_seqlock_get(const uni_common_map_seqlock_context_t *ctx, size_t key, void *val) {
+    bool result = false;
+
+    if (uni_common_map_seqlock_initialized(ctx)) {
+        // lookup does not modify the map, the context is not const only because of the returned value pointer
+        uni_common_map_context_t *map = (uni_common_map_context_t *)&ctx->map;
+        size_t size_val = uni_common_array_itemsize(map->config.vals);
+
+        size_t sequence = 0U;
+        do {
+            sequence = _uni_common_map_seqlock_read_begin(ctx);
+            const uint8_t *slot_val = uni_common_map_get(map, key);
+            result = slot_val != NULL;
+            if (result && val != NULL) {
+                (void) memcpy(val, slot_val, size_val);
+            }
+        } while (!_uni_common_map_seqlock_read_end(ctx, sequence));
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_seqlock_remove(uni_common_map_seqlock_context_t *ctx, size_t key) {
+    bool result = false;
+
+    if (uni_common_map_seqlock_initialized(ctx)) {
+        _uni_common_map_seqlock_write_begin(ctx);
+        result = uni_common_map_remove(&ctx->map, key);
+        _uni_common_map_seqlock_write_end(ctx);
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_seqlock_set(uni_common_map_seqlock_context_t *ctx, size_t key, const void *val) {
+    bool result = false;
+
+    if (uni_common_map_seqlock_initialized(ctx)) {
+        _uni_common_map_seqlock_write_begin(ctx);
+        result = uni_common_map_set(&ctx->map, key, val);
+        _uni_common_map_seqlock_write_end(ctx);
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_seqlock_set_batch(uni_common_map_seqlock_context_t *ctx, const size_t *keys, size_t count,
+                                        const void *vals) {
+    size_t result = 0U;
+
+    if (uni_common_map_seqlock_initialized(ctx)) {
+        _uni_common_map_seqlock_write_begin(ctx);
+        result = uni_common_map_set_batch(&ctx->map, keys, count, vals);
+        _uni_common_map_seqlock_write_end(ctx);
+    }
+
+    return result;
+}
@@ -0,0 +1,283 @@
+//
+// Includes
+//
+
+#if defined(__linux__)
+    #include <sched.h>
+#endif
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_hash.h"
+#include "uni_common_map_sharded.h"
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Tells the CPU that the thread is in the busy-wait loop
+ */
+static void _uni_common_map_sharded_relax(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+
+/**
+ * Gives the rest of the time slice to the other threads
+ */
+static void _uni_common_map_sharded_yield(void) {
+#if defined(__linux__)
+    (void) sched_yield();
+#else
+    _uni_common_map_sharded_relax();
+#endif
+}
+
+
+/**
+ * Locks the shard
+ * @param shard pointer to the shard
+ * @note input data must be valid
+ */
+static void _uni_common_map_sharded_lock(uni_common_map_shard_t *shard) {
+    uint32_t spin = 0U;
+
+    // exchange only when the lock looks free, so the waiters do not steal the line from the owner
+    while (atomic_load_explicit(&shard->lock, memory_order_relaxed) != 0U ||
+           atomic_exchange_explicit(&shard->lock, 1U, memory_order_acquire) != 0U) {
+        if (spin < UNI_COMMON_MAP_SHARDED_SPIN) {
+            _uni_common_map_sharded_relax();
+            spin++;
+        } else {
+            _uni_common_map_sharded_yield();
+        }
+    }
+}
+
+
+/**
+ * Unlocks the shard
+ * @param shard pointer to the shard
+ * @note input data must be valid
+ */
+static void _uni_common_map_sharded_unlock(uni_common_map_shard_t *shard) {
+    atomic_store_explicit(&shard->lock, 0U, memory_order_release);
+}
+
+
+/**
+ * Returns shard of the key
+ * @param ctx pointer to the sharded map context
+ * @param key map item key
+ * @return pointer to the shard
+ *
+ * @note shard is taken from the low half of the hash, the shard map reduces the high half, so the keys of one shard
+ * are still spread over the whole shard table
+ * @note input data must be valid
+ */
+static uni_common_map_shard_t *_uni_common_map_sharded_get_shard(const uni_common_map_sharded_context_t *ctx, size_t key) {
+    uint64_t hash = uni_common_hash_size(key);
+    return &ctx->shards[uni_common_hash_reduce(hash << 32U, ctx->shard_count)];
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_map_sharded_init(uni_common_map_sharded_context_t *ctx, uni_common_map_shard_t *shards,
+                                 const uni_common_map_config_t *configs, size_t shard_count) {
+    bool result = false;
+
+    if (ctx != NULL && shards != NULL && configs != NULL && shard_count != 0U && shard_count <= UINT32_MAX) {
+        ctx->initialized = false;
+
+        result = true;
+        for (size_t idx = 0U; idx < shard_count && result; idx++) {
+            atomic_store_explicit(&shards[idx].lock, 0U, memory_order_relaxed);
+            result = uni_common_map_init_ex(&shards[idx].map, &configs[idx]) &&
+                     uni_common_array_itemsize(configs[idx].vals) == uni_common_array_itemsize(configs[0].vals);
+        }
+
+        if (result) {
+            ctx->shards = shards;
+            ctx->shard_count = shard_count;
+            ctx->initialized = true;
+            atomic_thread_fence(memory_order_release);
+        }
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_map_sharded_capacity(const uni_common_map_sharded_context_t *ctx) {
+    size_t result = 0U;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        for (size_t idx = 0U; idx < ctx->shard_count; idx++) {
+            result += uni_common_map_capacity(&ctx->shards[idx].map);
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_sharded_initialized(const uni_common_map_sharded_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL) {
+        result = ctx->initialized;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_sharded_shard(const uni_common_map_sharded_context_t *ctx, size_t key) {
+    size_t result = SIZE_MAX;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        result = (size_t)(_uni_common_map_sharded_get_shard(ctx, key) - ctx->shards);
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_sharded_shard_count(const uni_common_map_sharded_context_t *ctx) {
+    size_t result = 0U;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        result = ctx->shard_count;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_map_sharded_size(uni_common_map_sharded_context_t *ctx) {
+    size_t result = 0U;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        for (size_t idx = 0U; idx < ctx->shard_count; idx++) {
+            uni_common_map_shard_t *shard = &ctx->shards[idx];
+            _uni_common_map_sharded_lock(shard);
+            result += uni_common_map_size(&shard->map);
+            _uni_common_map_sharded_unlock(shard);
+        }
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Process
+//
+
+bool uni_common_map_sharded_clear(uni_common_map_sharded_context_t *ctx) {
+    bool result = false;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        result = true;
+        for (size_t idx = 0U; idx < ctx->shard_count; idx++) {
+            uni_common_map_shard_t *shard = &ctx->shards[idx];
+            _uni_common_map_sharded_lock(shard);
+            result = uni_common_map_clear(&shard->map) && result;
+            _uni_common_map_sharded_unlock(shard);
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_sharded_enum(uni_common_map_sharded_context_t *ctx, uni_common_map_enum_func_t func) {
+    bool result = false;
+
+    if (uni_common_map_sharded_initialized(ctx) && func != NULL) {
+        result = true;
+        for (size_t idx = 0U; idx < ctx->shard_count; idx++) {
+            result = uni_common_map_sharded_enum_shard(ctx, idx, func) && result;
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_sharded_enum_shard(uni_common_map_sharded_context_t *ctx, size_t shard, uni_common_map_enum_func_t func) {
+    bool result = false;
+
+    if (uni_common_map_sharded_initialized(ctx) && shard < ctx->shard_count && func != NULL) {
+        _uni_common_map_sharded_lock(&ctx->shards[shard]);
+        result = uni_common_map_enum(&ctx->shards[shard].map, func);
+        _uni_common_map_sharded_unlock(&ctx->shards[shard]);
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_sharded_get(uni_common_map_sharded_context_t *ctx, size_t key, void *val) {
+    bool result = false;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        uni_common_map_shard_t *shard = _uni_common_map_sharded_get_shard(ctx, key);
+
+        _uni_common_map_sharded_lock(shard);
+        const uint8_t *slot_val = uni_common_map_get(&shard->map, key);
+        if (slot_val != NULL) {
+            if (val != NULL) {
+                (void) memcpy(val, slot_val, uni_common_array_itemsize(shard->map.config.vals));
+            }
+            result = true;
+        }
+        _uni_common_map_sharded_unlock(shard);
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_sharded_remove(uni_common_map_sharded_context_t *ctx, size_t key) {
+    bool result = false;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        uni_common_map_shard_t *shard = _uni_common_map_sharded_get_shard(ctx, key);
+
+        _uni_common_map_sharded_lock(shard);
+        result = uni_common_map_remove(&shard->map, key);
+        _uni_common_map_sharded_unlock(shard);
+    }
+
+    return result;
+}
+
+
+bool uni_common_map_sharded_set(uni_common_map_sharded_context_t *ctx, size_t key, const void *val) {
+    bool result = false;
+
+    if (uni_common_map_sharded_initialized(ctx)) {
+        uni_common_map_shard_t *shard = _uni_common_map_sharded_get_shard(ctx, key);
+
+        _uni_common_map_sharded_lock(shard);
+        result = uni_common_map_set(&shard->map, key, val);
+        _uni_common_map_sharded_unlock(shard);
+    }
+
+    return result;
+}
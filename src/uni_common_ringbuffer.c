@@ -5,15 +5,55 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "uni_common_bytes.h"
 #include "uni_common_compiler.h"
 #include "uni_common_math.h"
 #include "uni_common_ringbuffer.h"
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define UNI_COMMON_RINGBUFFER_FIND_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define UNI_COMMON_RINGBUFFER_FIND_SSE2
+#endif
+
 
 //
 // Functions/Private
 //
 
+/**
+ * Checks that ringbuffer works in power-of-two mode
+ * @param ctx pointer to the ringbuffer context
+ * @return true if positions are free-running object counters
+ *
+ * @note ringbuffer must be valid
+ */
+static bool _uni_common_ringbuffer_is_pow2(const uni_common_ringbuffer_context_t *ctx) {
+    return ctx->mask != 0U;
+}
+
+
+/**
+ * Converts position into the byte offset inside the data array
+ * @param ctx pointer to the ringbuffer context
+ * @param pos position to convert
+ * @return byte offset
+ *
+ * @note ringbuffer must be valid
+ */
+static size_t _uni_common_ringbuffer_pos_offset(const uni_common_ringbuffer_context_t *ctx, size_t pos) {
+    size_t result = pos;
+
+    if (_uni_common_ringbuffer_is_pow2(ctx)) {
+        result = (pos & ctx->mask) * ctx->size_object;
+    }
+
+    return result;
+}
+
+
 /**
  * Increment position by one object
  * @param ctx pointer to the ringbuffer object
@@ -23,7 +63,15 @@
  * @note ringbuffer must be valid
  */
 static size_t _uni_common_ringbuffer_pos_increment(const uni_common_ringbuffer_context_t *ctx, size_t pos) {
-    return (pos + ctx->size_object) % ctx->size_total;
+    size_t result;
+
+    if (_uni_common_ringbuffer_is_pow2(ctx)) {
+        result = pos + 1U;
+    } else {
+        result = (pos + ctx->size_object) % ctx->size_total;
+    }
+
+    return result;
 }
 
 /**
@@ -56,7 +104,16 @@ static size_t _uni_common_ringbuffer_count_bytes(const uni_common_ringbuffer_con
  * @note ringbuffer must be valid
  */
 static size_t _uni_common_ringbuffer_count_objects(const uni_common_ringbuffer_context_t *ctx, size_t pos_front) {
-    return _uni_common_ringbuffer_count_bytes(ctx, pos_front) / ctx->size_object;
+    size_t result;
+
+    if (_uni_common_ringbuffer_is_pow2(ctx)) {
+        // unsigned subtraction stays correct when the counters wrap around
+        result = ctx->pos_back - pos_front;
+    } else {
+        result = _uni_common_ringbuffer_count_bytes(ctx, pos_front) / ctx->size_object;
+    }
+
+    return result;
 }
 
 
@@ -71,6 +128,440 @@ static bool _uni_common_ringbuffer_is_empty(const uni_common_ringbuffer_context_
 }
 
 
+/**
+ * Checks that ringbuffer is full
+ * @param ctx pointer to the ringbuffer
+ * @return true if the next push overwrites the oldest object
+ *
+ * @note ringbuffer must be valid
+ */
+static bool _uni_common_ringbuffer_is_full(const uni_common_ringbuffer_context_t *ctx) {
+    bool result;
+
+    if (_uni_common_ringbuffer_is_pow2(ctx)) {
+        result = ctx->pos_back - ctx->pos_front > ctx->mask;
+    } else {
+        result = _uni_common_ringbuffer_pos_increment(ctx, ctx->pos_back) == ctx->pos_front;
+    }
+
+    return result;
+}
+
+
+/**
+ * Calculates number of objects which can be stored without overwrite
+ * @param ctx pointer to the ringbuffer context
+ * @return capacity in objects
+ *
+ * @note ringbuffer must be valid
+ */
+static size_t _uni_common_ringbuffer_capacity(const uni_common_ringbuffer_context_t *ctx) {
+    size_t result;
+
+    if (_uni_common_ringbuffer_is_pow2(ctx)) {
+        result = ctx->mask + 1U;
+    } else {
+        result = ctx->size_total / ctx->size_object - 1U;
+    }
+
+    return result;
+}
+
+
+/**
+ * Advances position by the given number of objects
+ * @param ctx pointer to the ringbuffer context
+ * @param pos position to advance
+ * @param count number of objects, must not exceed the object count of data array
+ * @return advanced position
+ *
+ * @note ringbuffer must be valid
+ */
+static size_t _uni_common_ringbuffer_pos_advance(const uni_common_ringbuffer_context_t *ctx, size_t pos, size_t count) {
+    size_t result;
+
+    if (_uni_common_ringbuffer_is_pow2(ctx)) {
+        result = pos + count;
+    } else {
+        result = (pos + count * ctx->size_object) % ctx->size_total;
+    }
+
+    return result;
+}
+
+
+/**
+ * Calculates number of bytes between offset and the end of addressable data
+ * @param ctx pointer to the ringbuffer context
+ * @param offset byte offset inside the data array
+ * @return number of bytes which can be accessed without wrap
+ *
+ * @note mirrored data array is followed by its second mapping, so access never wraps within one size_total
+ * @note ringbuffer must be valid
+ */
+static size_t _uni_common_ringbuffer_bytes_contiguous(const uni_common_ringbuffer_context_t *ctx, size_t offset) {
+    return (ctx->mirrored ? 2U * ctx->size_total : ctx->size_total) - offset;
+}
+
+
+/**
+ * Calculates number of objects between position and the end of data array
+ * @param ctx pointer to the ringbuffer context
+ * @param pos position of the first object
+ * @return number of objects which can be accessed without wrap
+ *
+ * @note ringbuffer must be valid
+ */
+static size_t _uni_common_ringbuffer_count_contiguous(const uni_common_ringbuffer_context_t *ctx, size_t pos) {
+    return _uni_common_ringbuffer_bytes_contiguous(ctx, _uni_common_ringbuffer_pos_offset(ctx, pos)) / ctx->size_object;
+}
+
+
+/**
+ * Calculates number of free objects which can be written at back without wrap
+ * @param ctx pointer to the ringbuffer context
+ * @return number of objects
+ *
+ * @note ringbuffer must be valid
+ */
+static size_t _uni_common_ringbuffer_count_writable(const uni_common_ringbuffer_context_t *ctx) {
+    size_t count_free = _uni_common_ringbuffer_capacity(ctx) - _uni_common_ringbuffer_count_objects(ctx, ctx->pos_front);
+    return uni_common_math_min(count_free, _uni_common_ringbuffer_count_contiguous(ctx, ctx->pos_back));
+}
+
+
+/**
+ * Calculates number of stored objects which can be read at front without wrap
+ * @param ctx pointer to the ringbuffer context
+ * @return number of objects
+ *
+ * @note ringbuffer must be valid
+ */
+static size_t _uni_common_ringbuffer_count_readable(const uni_common_ringbuffer_context_t *ctx) {
+    size_t count_used = _uni_common_ringbuffer_count_objects(ctx, ctx->pos_front);
+    return uni_common_math_min(count_used, _uni_common_ringbuffer_count_contiguous(ctx, ctx->pos_front));
+}
+
+
+/**
+ * Searches object in contiguous array of objects without vector instructions
+ * @param data pointer to the first object
+ * @param count number of objects
+ * @param size_object size of one object in bytes
+ * @param needle pointer to the object to search
+ * @return index of the first matching object, SIZE_MAX if there is no such object
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_find_scalar(const uint8_t *data, size_t count, size_t size_object, const uint8_t *needle) {
+    size_t result = SIZE_MAX;
+
+    switch (size_object) {
+        case 1U: {
+            for (size_t idx = 0U; idx < count; idx++) {
+                if (data[idx] == needle[0]) {
+                    result = idx;
+                    break;
+                }
+            }
+            break;
+        }
+        case 2U: {
+            uint16_t key, item;
+            (void) memcpy(&key, needle, sizeof(key));
+            for (size_t idx = 0U; idx < count; idx++) {
+                (void) memcpy(&item, &data[idx * sizeof(item)], sizeof(item));
+                if (item == key) {
+                    result = idx;
+                    break;
+                }
+            }
+            break;
+        }
+        case 4U: {
+            uint32_t key, item;
+            (void) memcpy(&key, needle, sizeof(key));
+            for (size_t idx = 0U; idx < count; idx++) {
+                (void) memcpy(&item, &data[idx * sizeof(item)], sizeof(item));
+                if (item == key) {
+                    result = idx;
+                    break;
+                }
+            }
+            break;
+        }
+        case 8U: {
+            uint64_t key, item;
+            (void) memcpy(&key, needle, sizeof(key));
+            for (size_t idx = 0U; idx < count; idx++) {
+                (void) memcpy(&item, &data[idx * sizeof(item)], sizeof(item));
+                if (item == key) {
+                    result = idx;
+                    break;
+                }
+            }
+            break;
+        }
+        default: {
+            for (size_t idx = 0U; idx < count; idx++) {
+                if (memcmp(&data[idx * size_object], needle, size_object) == 0) {
+                    result = idx;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+
+#if defined(UNI_COMMON_RINGBUFFER_FIND_AVX2)
+/**
+ * Searches 1/2/4/8/16-byte object in contiguous array of objects, 32 bytes per comparison
+ * @param data pointer to the first object
+ * @param count number of objects
+ * @param size_object size of one object in bytes, must be 1, 2, 4, 8 or 16
+ * @param needle pointer to the object to search
+ * @return index of the first matching object, SIZE_MAX if there is no such object
+ *
+ * @note input data must be valid
+ */
+UNI_COMMON_COMPILER_INLINE_ALWAYS size_t _uni_common_ringbuffer_find_vector_fixed(const uint8_t *data, size_t count,
+                                                                                const uint8_t *needle, const size_t size_object) {
+    size_t result = SIZE_MAX;
+    size_t per_vector = 32U / size_object;
+    size_t idx = 0U;
+
+    // every object is broadcast to all lanes of its size
+    __m256i key;
+    switch (size_object) {
+        case 1U: key = _mm256_set1_epi8((char)needle[0]); break;
+        case 2U: { int16_t val; (void) memcpy(&val, needle, sizeof(val)); key = _mm256_set1_epi16(val); break; }
+        case 4U: { int32_t val; (void) memcpy(&val, needle, sizeof(val)); key = _mm256_set1_epi32(val); break; }
+        case 8U: { int64_t val; (void) memcpy(&val, needle, sizeof(val)); key = _mm256_set1_epi64x(val); break; }
+        default: key = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)needle)); break;
+    }
+
+    for (; idx + per_vector <= count; idx += per_vector) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)&data[idx * size_object]);
+        __m256i equal;
+        switch (size_object) {
+            case 1U: equal = _mm256_cmpeq_epi8(block, key); break;
+            case 2U: equal = _mm256_cmpeq_epi16(block, key); break;
+            case 4U: equal = _mm256_cmpeq_epi32(block, key); break;
+            default: equal = _mm256_cmpeq_epi64(block, key); break;
+        }
+
+        // one bit per byte, bits of matching object are all set
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(equal);
+        if (size_object == 16U) {
+            mask = ((mask & 0xFFFFU) == 0xFFFFU ? 0x1U : 0U) | ((mask >> 16U) == 0xFFFFU ? 0x10000U : 0U);
+        }
+
+        if (mask != 0U) {
+            result = idx + uni_common_bytes_ctz32(mask) / size_object;
+            break;
+        }
+    }
+
+    if (result == SIZE_MAX) {
+        size_t result_tail = _uni_common_ringbuffer_find_scalar(&data[idx * size_object], count - idx, size_object, needle);
+        if (result_tail != SIZE_MAX) {
+            result = idx + result_tail;
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Searches 1/2/4/8/16-byte object in contiguous array of objects
+ * @param data pointer to the first object
+ * @param count number of objects
+ * @param size_object size of one object in bytes, must be 1, 2, 4, 8 or 16
+ * @param needle pointer to the object to search
+ * @return index of the first matching object, SIZE_MAX if there is no such object
+ *
+ * @note every size gets its own copy of the loop, so the compare selection is resolved at compile time
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_find_vector(const uint8_t *data, size_t count, size_t size_object, const uint8_t *needle) {
+    size_t result;
+
+    switch (size_object) {
+        case 1U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 1U); break;
+        case 2U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 2U); break;
+        case 4U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 4U); break;
+        case 8U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 8U); break;
+        default: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 16U); break;
+    }
+
+    return result;
+}
+#elif defined(UNI_COMMON_RINGBUFFER_FIND_SSE2)
+/**
+ * Searches 1/2/4/8/16-byte object in contiguous array of objects, 16 bytes per comparison
+ * @param data pointer to the first object
+ * @param count number of objects
+ * @param size_object size of one object in bytes, must be 1, 2, 4, 8 or 16
+ * @param needle pointer to the object to search
+ * @return index of the first matching object, SIZE_MAX if there is no such object
+ *
+ * @note input data must be valid
+ */
+UNI_COMMON_COMPILER_INLINE_ALWAYS size_t _uni_common_ringbuffer_find_vector_fixed(const uint8_t *data, size_t count,
+                                                                                const uint8_t *needle, const size_t size_object) {
+    size_t result = SIZE_MAX;
+    size_t per_vector = 16U / size_object;
+    size_t idx = 0U;
+
+    // every object is broadcast to all lanes of its size
+    __m128i key;
+    switch (size_object) {
+        case 1U: key = _mm_set1_epi8((char)needle[0]); break;
+        case 2U: { int16_t val; (void) memcpy(&val, needle, sizeof(val)); key = _mm_set1_epi16(val); break; }
+        case 4U: { int32_t val; (void) memcpy(&val, needle, sizeof(val)); key = _mm_set1_epi32(val); break; }
+        case 8U: { int64_t val; (void) memcpy(&val, needle, sizeof(val)); key = _mm_set1_epi64x(val); break; }
+        default: key = _mm_loadu_si128((const __m128i *)needle); break;
+    }
+
+    for (; idx + per_vector <= count; idx += per_vector) {
+        __m128i block = _mm_loadu_si128((const __m128i *)&data[idx * size_object]);
+        __m128i equal;
+        switch (size_object) {
+            case 1U: equal = _mm_cmpeq_epi8(block, key); break;
+            case 2U: equal = _mm_cmpeq_epi16(block, key); break;
+            case 8U: {
+                // SSE2 has no 64-bit compare, both 32-bit halves must match
+                equal = _mm_cmpeq_epi32(block, key);
+                equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+                break;
+            }
+            default: equal = _mm_cmpeq_epi32(block, key); break;
+        }
+
+        // one bit per byte, bits of matching object are all set
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(equal);
+        if (size_object == 16U) {
+            mask = mask == 0xFFFFU ? 0x1U : 0U;
+        }
+
+        if (mask != 0U) {
+            result = idx + uni_common_bytes_ctz32(mask) / size_object;
+            break;
+        }
+    }
+
+    if (result == SIZE_MAX) {
+        size_t result_tail = _uni_common_ringbuffer_find_scalar(&data[idx * size_object], count - idx, size_object, needle);
+        if (result_tail != SIZE_MAX) {
+            result = idx + result_tail;
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Searches 1/2/4/8/16-byte object in contiguous array of objects
+ * @param data pointer to the first object
+ * @param count number of objects
+ * @param size_object size of one object in bytes, must be 1, 2, 4, 8 or 16
+ * @param needle pointer to the object to search
+ * @return index of the first matching object, SIZE_MAX if there is no such object
+ *
+ * @note every size gets its own copy of the loop, so the compare selection is resolved at compile time
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_find_vector(const uint8_t *data, size_t count, size_t size_object, const uint8_t *needle) {
+    size_t result;
+
+    switch (size_object) {
+        case 1U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 1U); break;
+        case 2U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 2U); break;
+        case 4U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 4U); break;
+        case 8U: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 8U); break;
+        default: result = _uni_common_ringbuffer_find_vector_fixed(data, count, needle, 16U); break;
+    }
+
+    return result;
+}
+#endif
+
+
+/**
+ * Searches object in contiguous array of objects
+ * @param data pointer to the first object
+ * @param count number of objects
+ * @param size_object size of one object in bytes
+ * @param needle pointer to the object to search
+ * @return index of the first matching object, SIZE_MAX if there is no such object
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_find_span(const uint8_t *data, size_t count, size_t size_object, const uint8_t *needle) {
+    size_t result;
+
+#if defined(UNI_COMMON_RINGBUFFER_FIND_AVX2) || defined(UNI_COMMON_RINGBUFFER_FIND_SSE2)
+    if (size_object == 1U || size_object == 2U || size_object == 4U || size_object == 8U || size_object == 16U) {
+        result = _uni_common_ringbuffer_find_vector(data, count, size_object, needle);
+    } else {
+        result = _uni_common_ringbuffer_find_scalar(data, count, size_object, needle);
+    }
+#else
+    result = _uni_common_ringbuffer_find_scalar(data, count, size_object, needle);
+#endif
+
+    return result;
+}
+
+
+/**
+ * Copies objects into the data array, splitting the copy at the wrap point
+ * @param ctx pointer to the ringbuffer context
+ * @param pos position of the first object
+ * @param data pointer to the source buffer
+ * @param count number of objects, must not exceed the object count of data array
+ *
+ * @note ringbuffer must be valid
+ */
+static void _uni_common_ringbuffer_copy_in(uni_common_ringbuffer_context_t *ctx, size_t pos, const uint8_t *data, size_t count) {
+    size_t offset = _uni_common_ringbuffer_pos_offset(ctx, pos);
+    size_t size = count * ctx->size_object;
+    size_t size_first = uni_common_math_min(size, _uni_common_ringbuffer_bytes_contiguous(ctx, offset));
+
+    (void) memcpy(&ctx->data[offset], data, size_first);
+    if (size_first < size) {
+        (void) memcpy(ctx->data, &data[size_first], size - size_first);
+    }
+}
+
+
+/**
+ * Copies objects out of the data array, splitting the copy at the wrap point
+ * @param ctx pointer to the ringbuffer context
+ * @param pos position of the first object
+ * @param data pointer to the destination buffer
+ * @param count number of objects, must not exceed the object count of data array
+ *
+ * @note ringbuffer must be valid
+ */
+static void _uni_common_ringbuffer_copy_out(const uni_common_ringbuffer_context_t *ctx, size_t pos, uint8_t *data, size_t count) {
+    size_t offset = _uni_common_ringbuffer_pos_offset(ctx, pos);
+    size_t size = count * ctx->size_object;
+    size_t size_first = uni_common_math_min(size, _uni_common_ringbuffer_bytes_contiguous(ctx, offset));
+
+    (void) memcpy(data, &ctx->data[offset], size_first);
+    if (size_first < size) {
+        (void) memcpy(&data[size_first], ctx->data, size - size_first);
+    }
+}
+
+
 //
 // Functions/Init
 //
@@ -84,6 +575,8 @@ bool uni_common_ringbuffer_init(uni_common_ringbuffer_context_t *ctx, uint8_t *d
 
         ctx->size_object = size_object;
         ctx->size_total = size_total;
+        ctx->mask = 0U;
+        ctx->mirrored = false;
 
         uni_common_ringbuffer_clear(ctx);
         result = true;
@@ -93,6 +586,29 @@ bool uni_common_ringbuffer_init(uni_common_ringbuffer_context_t *ctx, uint8_t *d
 }
 
 
+bool uni_common_ringbuffer_init_pow2(uni_common_ringbuffer_context_t *ctx, uint8_t *data, uint32_t size_object,
+                                     uint32_t size_total) {
+    bool result = false;
+
+    if (ctx != NULL && data != NULL && size_object != 0U && (size_total % size_object == 0U)) {
+        size_t capacity = size_total / size_object;
+        if (capacity >= 2U && (capacity & (capacity - 1U)) == 0U) {
+            ctx->data = data;
+
+            ctx->size_object = size_object;
+            ctx->size_total = size_total;
+            ctx->mask = capacity - 1U;
+            ctx->mirrored = false;
+
+            uni_common_ringbuffer_clear(ctx);
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
 //
 // Functions/Getters
 //
@@ -101,13 +617,10 @@ bool uni_common_ringbuffer_get(const uni_common_ringbuffer_context_t *ctx, size_
     bool result = false;
     if (ctx != NULL && data != NULL && index < uni_common_ringbuffer_length(ctx)) {
         // calculate position
-        size_t pos = ctx->pos_front;
-        for (size_t i = 0; i < index; i++) {
-            pos = _uni_common_ringbuffer_pos_increment(ctx, pos);
-        }
+        size_t pos = _uni_common_ringbuffer_pos_advance(ctx, ctx->pos_front, index);
 
         // copy data
-        (void) memcpy(data, &ctx->data[pos], ctx->size_object);
+        (void) memcpy(data, &ctx->data[_uni_common_ringbuffer_pos_offset(ctx, pos)], ctx->size_object);
 
         result = true;
     }
@@ -117,21 +630,41 @@ bool uni_common_ringbuffer_get(const uni_common_ringbuffer_context_t *ctx, size_
 
 size_t uni_common_ringbuffer_find(const uni_common_ringbuffer_context_t *ctx, const uint8_t *data) {
     size_t result = SIZE_MAX;
-    size_t counter = 0U;
 
     if (ctx != NULL && data != NULL) {
-        size_t pos_current = ctx->pos_front;
-
-        while (!_uni_common_ringbuffer_is_empty(ctx, pos_current)) {
-            // compare data
-            if (memcmp(data, &ctx->data[pos_current], ctx->size_object) == 0) {
-                result = counter;
-                break;
+        uni_common_ringbuffer_span_t spans[2] = {{NULL, 0U}, {NULL, 0U}};
+        uni_common_ringbuffer_view(ctx, spans);
+
+        // scan the spans directly, the second one continues the first one
+        result = _uni_common_ringbuffer_find_span(spans[0].data, spans[0].count, ctx->size_object, data);
+        if (result == SIZE_MAX) {
+            result = _uni_common_ringbuffer_find_span(spans[1].data, spans[1].count, ctx->size_object, data);
+            if (result != SIZE_MAX) {
+                result += spans[0].count;
             }
+        }
+    }
 
-            // increment
-            pos_current = _uni_common_ringbuffer_pos_increment(ctx, pos_current);
-            counter++;
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_view(const uni_common_ringbuffer_context_t *ctx, uni_common_ringbuffer_span_t *spans) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && spans != NULL) {
+        size_t count_used = _uni_common_ringbuffer_count_objects(ctx, ctx->pos_front);
+        size_t count_first = _uni_common_ringbuffer_count_readable(ctx);
+
+        spans[0].data = &ctx->data[_uni_common_ringbuffer_pos_offset(ctx, ctx->pos_front)];
+        spans[0].count = count_first;
+        spans[1].data = ctx->data;
+        spans[1].count = count_used - count_first;
+
+        if (spans[1].count != 0U) {
+            result = 2U;
+        } else if (spans[0].count != 0U) {
+            result = 1U;
         }
     }
 
@@ -154,7 +687,7 @@ bool uni_common_ringbuffer_is_full(const uni_common_ringbuffer_context_t *ctx) {
     bool result = false;
 
     if (ctx != NULL) {
-        result = _uni_common_ringbuffer_pos_increment(ctx, ctx->pos_back) == ctx->pos_front;
+        result = _uni_common_ringbuffer_is_full(ctx);
     }
 
     return result;
@@ -193,23 +726,13 @@ size_t uni_common_ringbuffer_pop(uni_common_ringbuffer_context_t *ctx, uint8_t *
     size_t result = 0;
 
     if (ctx != NULL) {
-        while (result < count && !_uni_common_ringbuffer_is_empty(ctx, ctx->pos_front)) {
-            // copy object
-            if (data != NULL) {
-                (void) memcpy(data, &ctx->data[ctx->pos_front], ctx->size_object);
-            }
-
-            // update pos_front
-            ctx->pos_front = _uni_common_ringbuffer_pos_increment(ctx, ctx->pos_front);
+        result = uni_common_math_min(count, _uni_common_ringbuffer_count_objects(ctx, ctx->pos_front));
 
-            // update counter
-            result++;
-
-            // update pointer for the next copy
-            if (data != NULL) {
-                data = &data[ctx->size_object];
-            }
+        if (data != NULL) {
+            _uni_common_ringbuffer_copy_out(ctx, ctx->pos_front, data, result);
         }
+
+        ctx->pos_front = _uni_common_ringbuffer_pos_advance(ctx, ctx->pos_front, result);
     }
 
     return result;
@@ -217,27 +740,82 @@ size_t uni_common_ringbuffer_pop(uni_common_ringbuffer_context_t *ctx, uint8_t *
 
 
 size_t uni_common_ringbuffer_push(uni_common_ringbuffer_context_t *ctx, const uint8_t *data, size_t count) {
+    return uni_common_ringbuffer_push_ex(ctx, data, count, true);
+}
+
+
+size_t uni_common_ringbuffer_push_ex(uni_common_ringbuffer_context_t *ctx, const uint8_t *data, size_t count, bool overwrite) {
     size_t result = 0U;
 
     if (ctx != NULL && ctx->data != NULL && data != NULL) {
-        while (result < count) {
-            // copy object
-            (void) memcpy(&ctx->data[ctx->pos_back], data, ctx->size_object);
+        size_t capacity = _uni_common_ringbuffer_capacity(ctx);
+        size_t count_free = capacity - _uni_common_ringbuffer_count_objects(ctx, ctx->pos_front);
 
-            // calculate next back position
-            size_t pos_back_next = _uni_common_ringbuffer_pos_increment(ctx, ctx->pos_back);
+        result = overwrite ? count : uni_common_math_min(count, count_free);
 
-            // update pos_front to the previous back position if it necessary
-            if (pos_back_next == ctx->pos_front) {
-                ctx->pos_front = _uni_common_ringbuffer_pos_increment(ctx, ctx->pos_front);
-            }
+        // only the last :capacity objects of the oversized push survive
+        size_t count_write = result;
+        if (count_write > capacity) {
+            data = &data[(count_write - capacity) * ctx->size_object];
+            count_write = capacity;
+        }
 
-            // update back position, buffer pointer and counter
-            ctx->pos_back = pos_back_next;
-            data = &data[ctx->size_object];
-            result++;
+        _uni_common_ringbuffer_copy_in(ctx, ctx->pos_back, data, count_write);
+        ctx->pos_back = _uni_common_ringbuffer_pos_advance(ctx, ctx->pos_back, count_write);
+
+        // drop the oldest objects which were overwritten
+        if (count_write > count_free) {
+            ctx->pos_front = _uni_common_ringbuffer_pos_advance(ctx, ctx->pos_front, count_write - count_free);
         }
     }
 
     return result;
 }
+
+
+size_t uni_common_ringbuffer_reserve(uni_common_ringbuffer_context_t *ctx, size_t count, uint8_t **data) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && data != NULL) {
+        result = uni_common_math_min(count, _uni_common_ringbuffer_count_writable(ctx));
+        *data = &ctx->data[_uni_common_ringbuffer_pos_offset(ctx, ctx->pos_back)];
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_commit(uni_common_ringbuffer_context_t *ctx, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL) {
+        result = uni_common_math_min(count, _uni_common_ringbuffer_count_writable(ctx));
+        ctx->pos_back = _uni_common_ringbuffer_pos_advance(ctx, ctx->pos_back, result);
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_peek(const uni_common_ringbuffer_context_t *ctx, size_t count, const uint8_t **data) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && data != NULL) {
+        result = uni_common_math_min(count, _uni_common_ringbuffer_count_readable(ctx));
+        *data = &ctx->data[_uni_common_ringbuffer_pos_offset(ctx, ctx->pos_front)];
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_consume(uni_common_ringbuffer_context_t *ctx, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL) {
+        result = uni_common_math_min(count, _uni_common_ringbuffer_count_objects(ctx, ctx->pos_front));
+        ctx->pos_front = _uni_common_ringbuffer_pos_advance(ctx, ctx->pos_front, result);
+    }
+
+    return result;
+}
@@ -0,0 +1,225 @@
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_ringbuffer_broadcast.h"
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Copies objects out of the ring
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param pos position of the first object
+ * @param data receive buffer
+ * @param count number of objects, must not exceed capacity
+ * @note ringbuffer must be valid
+ */
+static void _uni_common_ringbuffer_broadcast_copy_out(const uni_common_ringbuffer_broadcast_context_t *ctx, size_t pos,
+                                                      uint8_t *data, size_t count) {
+    size_t offset = pos & ctx->mask;
+    size_t count_first = ctx->mask + 1U - offset;
+    if (count_first > count) {
+        count_first = count;
+    }
+
+    (void) memcpy(data, &ctx->data[offset * ctx->size_object], count_first * ctx->size_object);
+    if (count_first < count) {
+        (void) memcpy(&data[count_first * ctx->size_object], ctx->data, (count - count_first) * ctx->size_object);
+    }
+}
+
+
+/**
+ * Copies objects into the ring
+ * @param ctx pointer to the broadcast ringbuffer context
+ * @param pos position of the first object
+ * @param data send buffer
+ * @param count number of objects, must not exceed capacity
+ * @note ringbuffer must be valid
+ */
+static void _uni_common_ringbuffer_broadcast_copy_in(uni_common_ringbuffer_broadcast_context_t *ctx, size_t pos,
+                                                     const uint8_t *data, size_t count) {
+    size_t offset = pos & ctx->mask;
+    size_t count_first = ctx->mask + 1U - offset;
+    if (count_first > count) {
+        count_first = count;
+    }
+
+    (void) memcpy(&ctx->data[offset * ctx->size_object], data, count_first * ctx->size_object);
+    if (count_first < count) {
+        (void) memcpy(ctx->data, &data[count_first * ctx->size_object], (count - count_first) * ctx->size_object);
+    }
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_broadcast_init(uni_common_ringbuffer_broadcast_context_t *ctx, uint8_t *data, size_t size_object,
+                                          size_t size_total) {
+    bool result = false;
+
+    if (ctx != NULL && data != NULL && size_object != 0U && (size_total % size_object == 0U)) {
+        size_t capacity = size_total / size_object;
+        if (capacity != 0U && (capacity & (capacity - 1U)) == 0U) {
+            ctx->data = data;
+            ctx->size_object = size_object;
+            ctx->mask = capacity - 1U;
+
+            atomic_store_explicit(&ctx->pos_claim, 0U, memory_order_relaxed);
+            atomic_store_explicit(&ctx->pos_back, 0U, memory_order_release);
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_broadcast_cursor_init(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                                 uni_common_ringbuffer_broadcast_cursor_t *cursor, bool oldest) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->data != NULL && cursor != NULL) {
+        size_t pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_acquire);
+
+        cursor->pos = pos_back;
+        if (oldest) {
+            cursor->pos = pos_back > ctx->mask ? pos_back - ctx->mask - 1U : 0U;
+        }
+        cursor->lost = 0U;
+        result = true;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_broadcast_capacity(const uni_common_ringbuffer_broadcast_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL) {
+        result = ctx->mask + 1U;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_broadcast_pending(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                               const uni_common_ringbuffer_broadcast_cursor_t *cursor) {
+    size_t result = 0U;
+
+    if (ctx != NULL && cursor != NULL) {
+        result = atomic_load_explicit(&ctx->pos_back, memory_order_acquire) - cursor->pos;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_broadcast_lapped(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                            const uni_common_ringbuffer_broadcast_cursor_t *cursor) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->data != NULL && cursor != NULL) {
+        result = uni_common_ringbuffer_broadcast_pending(ctx, cursor) > ctx->mask + 1U;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Operations
+//
+
+size_t uni_common_ringbuffer_broadcast_push(uni_common_ringbuffer_broadcast_context_t *ctx, const uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && data != NULL) {
+        size_t capacity = ctx->mask + 1U;
+        size_t pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_relaxed);
+
+        while (result < count) {
+            size_t count_batch = count - result;
+            if (count_batch > capacity) {
+                count_batch = capacity;
+            }
+
+            // claim is stored before the data, so reader which saw any new byte also sees the claim
+            atomic_store_explicit(&ctx->pos_claim, pos_back + count_batch, memory_order_relaxed);
+            atomic_thread_fence(memory_order_release);
+
+            _uni_common_ringbuffer_broadcast_copy_in(ctx, pos_back, &data[result * ctx->size_object], count_batch);
+
+            pos_back += count_batch;
+            atomic_store_explicit(&ctx->pos_back, pos_back, memory_order_release);
+            result += count_batch;
+        }
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_broadcast_read(const uni_common_ringbuffer_broadcast_context_t *ctx,
+                                            uni_common_ringbuffer_broadcast_cursor_t *cursor, uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && cursor != NULL && data != NULL) {
+        size_t capacity = ctx->mask + 1U;
+
+        while (result < count) {
+            size_t pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_acquire);
+            if (cursor->pos == pos_back) {
+                break;
+            }
+
+            // lapped, skip to the oldest object which is still available
+            if (pos_back - cursor->pos > capacity) {
+                cursor->lost += pos_back - capacity - cursor->pos;
+                cursor->pos = pos_back - capacity;
+            }
+
+            size_t count_run = pos_back - cursor->pos;
+            if (count_run > count - result) {
+                count_run = count - result;
+            }
+
+            _uni_common_ringbuffer_broadcast_copy_out(ctx, cursor->pos, &data[result * ctx->size_object], count_run);
+            atomic_thread_fence(memory_order_acquire);
+
+            // objects older than claim - capacity could be overwritten during the copy, they are dropped as lost
+            size_t pos_claim = atomic_load_explicit(&ctx->pos_claim, memory_order_relaxed);
+            if (pos_claim - cursor->pos > capacity) {
+                size_t count_torn = pos_claim - capacity - cursor->pos;
+                if (count_torn > count_run) {
+                    count_torn = count_run;
+                }
+
+                cursor->lost += count_torn;
+                cursor->pos += count_torn;
+                count_run -= count_torn;
+                (void) memmove(&data[result * ctx->size_object], &data[(result + count_torn) * ctx->size_object],
+                               count_run * ctx->size_object);
+            }
+
+            cursor->pos += count_run;
+            result += count_run;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,357 @@
+//
+// Includes
+//
+
+#if defined(__linux__)
+    #if !defined(_GNU_SOURCE)
+        #define _GNU_SOURCE
+    #endif
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_hash.h"
+#include "uni_common_ringbuffer_file.h"
+
+
+//
+// Functions/Private
+//
+
+#if defined(__linux__)
+/**
+ * Calculates checksum of the header slot
+ * @param slot pointer to the slot
+ * @return checksum
+ * @note input data must be valid
+ */
+static uint64_t _uni_common_ringbuffer_file_slot_check(const uni_common_ringbuffer_file_slot_t *slot) {
+    uint64_t result = uni_common_hash_size((size_t)(UNI_COMMON_RINGBUFFER_FILE_MAGIC ^ slot->seq));
+
+    result = uni_common_hash_size((size_t)(result ^ slot->pos_front));
+    result = uni_common_hash_size((size_t)(result ^ slot->pos_back));
+
+    return result;
+}
+
+
+/**
+ * Checks that the slot positions are consistent with the ringbuffer mode
+ * @param ctx pointer to the file backend context
+ * @param slot pointer to the slot
+ * @return true if slot is valid
+ * @note input data must be valid
+ */
+static bool _uni_common_ringbuffer_file_slot_valid(const uni_common_ringbuffer_file_context_t *ctx,
+                                                   const uni_common_ringbuffer_file_slot_t *slot) {
+    bool result = slot->seq != 0U && slot->check == _uni_common_ringbuffer_file_slot_check(slot);
+
+    if (result) {
+        if (ctx->ring.mask != 0U) {
+            result = slot->pos_back - slot->pos_front <= ctx->ring.mask + 1U;
+        } else {
+            result = slot->pos_front < ctx->ring.size_total && slot->pos_back < ctx->ring.size_total &&
+                     slot->pos_front % ctx->ring.size_object == 0U && slot->pos_back % ctx->ring.size_object == 0U;
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Writes ringbuffer positions into the older header slot
+ * @param ctx pointer to the file backend context
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_file_slot_write(uni_common_ringbuffer_file_context_t *ctx) {
+    ctx->seq++;
+
+    uni_common_ringbuffer_file_slot_t *slot = &ctx->header->slots[ctx->seq & 1U];
+    slot->pos_front = ctx->ring.pos_front;
+    slot->pos_back = ctx->ring.pos_back;
+    slot->seq = ctx->seq;
+    slot->check = _uni_common_ringbuffer_file_slot_check(slot);
+}
+
+
+/**
+ * Flushes the mapped range to the file
+ * @param ctx pointer to the file backend context
+ * @param offset offset of the range, must be multiple of the page size
+ * @param size size of the range
+ * @return true on success
+ * @note input data must be valid
+ */
+static bool _uni_common_ringbuffer_file_msync(uni_common_ringbuffer_file_context_t *ctx, size_t offset, size_t size) {
+    ctx->count_sync++;
+    return msync((uint8_t *)ctx->header + offset, size, MS_SYNC) == 0;
+}
+
+
+/**
+ * Validates header of the existing file and restores the ringbuffer positions
+ * @param ctx pointer to the file backend context
+ * @param config pointer to the configuration
+ * @param page page size
+ * @return true on success
+ * @note input data must be valid, ctx->ring must be initialized
+ */
+static bool _uni_common_ringbuffer_file_restore(uni_common_ringbuffer_file_context_t *ctx,
+                                                const uni_common_ringbuffer_file_config_t *config, size_t page) {
+    bool result = false;
+
+    const uni_common_ringbuffer_file_header_t *header = ctx->header;
+    if (header->magic == UNI_COMMON_RINGBUFFER_FILE_MAGIC && header->version == UNI_COMMON_RINGBUFFER_FILE_VERSION &&
+        header->size_header == page && header->size_object == config->size_object &&
+        header->size_total == config->size_total && header->mask == ctx->ring.mask) {
+        const uni_common_ringbuffer_file_slot_t *slot = NULL;
+        for (size_t idx = 0U; idx < 2U; idx++) {
+            if (_uni_common_ringbuffer_file_slot_valid(ctx, &header->slots[idx]) &&
+                (slot == NULL || header->slots[idx].seq > slot->seq)) {
+                slot = &header->slots[idx];
+            }
+        }
+
+        if (slot != NULL) {
+            ctx->ring.pos_front = (size_t)slot->pos_front;
+            ctx->ring.pos_back = (size_t)slot->pos_back;
+            ctx->seq = slot->seq;
+            result = true;
+        }
+    }
+
+    return result;
+}
+#endif
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_file_open(uni_common_ringbuffer_file_context_t *ctx, const uni_common_ringbuffer_file_config_t *config) {
+    bool result = false;
+
+#if defined(__linux__)
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (ctx != NULL && config != NULL && config->path != NULL && config->size_object != 0U && config->size_total != 0U &&
+        config->size_total % config->size_object == 0U && page > 0 && sizeof(uni_common_ringbuffer_file_header_t) <= (size_t)page &&
+        (config->sync != UNI_COMMON_RINGBUFFER_FILE_SYNC_PERIODIC || config->sync_period != 0U)) {
+        size_t size_map = (size_t)page + config->size_total;
+
+        int fd = open(config->path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd >= 0) {
+            struct stat st;
+            bool created = false;
+            bool sized = false;
+            if (fstat(fd, &st) == 0) {
+                if (st.st_size == 0) {
+                    created = true;
+                    sized = ftruncate(fd, (off_t)size_map) == 0;
+                } else {
+                    sized = (size_t)st.st_size == size_map;
+                }
+            }
+
+            void *map = MAP_FAILED;
+            if (sized) {
+                map = mmap(NULL, size_map, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+
+            // mapping keeps the file alive
+            (void) close(fd);
+
+            if (map != MAP_FAILED) {
+                // crash between ftruncate and the end of the first header write leaves the zero magic, header is
+                // created again
+                const uni_common_ringbuffer_file_header_t *header = (const uni_common_ringbuffer_file_header_t *)map;
+                if (header->magic == 0U) {
+                    created = true;
+                }
+
+                (void) memset(ctx, 0, sizeof(*ctx));
+                ctx->header = (uni_common_ringbuffer_file_header_t *)map;
+                ctx->size_map = size_map;
+                ctx->sync = config->sync;
+                ctx->sync_period = config->sync_period;
+                ctx->sync_countdown = config->sync_period;
+
+                uint8_t *data = (uint8_t *)map + page;
+                size_t capacity = config->size_total / config->size_object;
+                if (capacity >= 2U && (capacity & (capacity - 1U)) == 0U) {
+                    result = uni_common_ringbuffer_init_pow2(&ctx->ring, data, config->size_object, config->size_total);
+                } else {
+                    result = uni_common_ringbuffer_init(&ctx->ring, data, config->size_object, config->size_total);
+                }
+
+                if (result && created) {
+                    ctx->header->version = UNI_COMMON_RINGBUFFER_FILE_VERSION;
+                    ctx->header->size_header = (uint32_t)page;
+                    ctx->header->size_object = config->size_object;
+                    ctx->header->size_total = config->size_total;
+                    ctx->header->mask = ctx->ring.mask;
+                    _uni_common_ringbuffer_file_slot_write(ctx);
+
+                    // magic is the last one, so the partially written header is recognized as not initialized
+                    atomic_signal_fence(memory_order_release);
+                    ctx->header->magic = UNI_COMMON_RINGBUFFER_FILE_MAGIC;
+
+                    if (ctx->sync != UNI_COMMON_RINGBUFFER_FILE_SYNC_NONE) {
+                        result = _uni_common_ringbuffer_file_msync(ctx, 0U, (size_t)page);
+                    }
+                } else if (result) {
+                    result = _uni_common_ringbuffer_file_restore(ctx, config, (size_t)page);
+                    ctx->restored = result;
+                }
+
+                if (!result) {
+                    (void) munmap(map, size_map);
+                    (void) memset(ctx, 0, sizeof(*ctx));
+                }
+            }
+        }
+    }
+#else
+    (void) ctx;
+    (void) config;
+#endif
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_file_close(uni_common_ringbuffer_file_context_t *ctx) {
+    bool result = false;
+
+#if defined(__linux__)
+    if (ctx != NULL && ctx->header != NULL) {
+        result = uni_common_ringbuffer_file_commit(ctx);
+        if (ctx->sync == UNI_COMMON_RINGBUFFER_FILE_SYNC_PERIODIC) {
+            result = _uni_common_ringbuffer_file_msync(ctx, 0U, ctx->size_map) && result;
+        }
+
+        result = munmap(ctx->header, ctx->size_map) == 0 && result;
+        (void) memset(ctx, 0, sizeof(*ctx));
+    }
+#else
+    (void) ctx;
+#endif
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_file_count_sync(const uni_common_ringbuffer_file_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        result = ctx->count_sync;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_file_is_restored(const uni_common_ringbuffer_file_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL) {
+        result = ctx->restored;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Operations
+//
+
+bool uni_common_ringbuffer_file_commit(uni_common_ringbuffer_file_context_t *ctx) {
+    bool result = false;
+
+#if defined(__linux__)
+    if (ctx != NULL && ctx->header != NULL) {
+        result = true;
+
+        switch (ctx->sync) {
+            case UNI_COMMON_RINGBUFFER_FILE_SYNC_COMMIT:
+                // data must reach the file before the header which refers to it
+                result = _uni_common_ringbuffer_file_msync(ctx, ctx->header->size_header, ctx->ring.size_total);
+                _uni_common_ringbuffer_file_slot_write(ctx);
+                result = _uni_common_ringbuffer_file_msync(ctx, 0U, ctx->header->size_header) && result;
+                break;
+            case UNI_COMMON_RINGBUFFER_FILE_SYNC_PERIODIC:
+                _uni_common_ringbuffer_file_slot_write(ctx);
+                ctx->sync_countdown--;
+                if (ctx->sync_countdown == 0U) {
+                    ctx->sync_countdown = ctx->sync_period;
+                    result = _uni_common_ringbuffer_file_msync(ctx, 0U, ctx->size_map);
+                }
+                break;
+            default:
+                _uni_common_ringbuffer_file_slot_write(ctx);
+                break;
+        }
+    }
+#else
+    (void) ctx;
+#endif
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_file_pop(uni_common_ringbuffer_file_context_t *ctx, uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->header != NULL) {
+        result = uni_common_ringbuffer_pop(&ctx->ring, data, count);
+        if (result != 0U) {
+            (void) uni_common_ringbuffer_file_commit(ctx);
+        }
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_file_push(uni_common_ringbuffer_file_context_t *ctx, const uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->header != NULL && data != NULL) {
+        for (;;) {
+            result += uni_common_ringbuffer_push_ex(&ctx->ring, &data[result * ctx->ring.size_object], count - result, false);
+            if (result == count) {
+                break;
+            }
+
+            // the oldest objects are dropped and the new front is committed before their slots are overwritten, so
+            // the committed header never covers the slots which already hold the newer objects
+            size_t count_drop = count - result;
+            if (count_drop > uni_common_ringbuffer_length(&ctx->ring)) {
+                count_drop = uni_common_ringbuffer_length(&ctx->ring);
+            }
+            (void) uni_common_ringbuffer_pop(&ctx->ring, NULL, count_drop);
+            (void) uni_common_ringbuffer_file_commit(ctx);
+        }
+
+        if (result != 0U) {
+            (void) uni_common_ringbuffer_file_commit(ctx);
+        }
+    }
+
+    return result;
+}
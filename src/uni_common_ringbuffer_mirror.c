@@ -0,0 +1,127 @@
+//
+// Includes
+//
+
+#if defined(__linux__)
+    #if !defined(_GNU_SOURCE)
+        #define _GNU_SOURCE
+    #endif
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_ringbuffer_mirror.h"
+
+
+//
+// Functions/Private
+//
+
+#if defined(__linux__)
+/**
+ * Maps memory file twice, back to back
+ * @param size size of one mapping, must be multiple of the page size
+ * @return pointer to the first mapping, NULL on failure
+ */
+static uint8_t *_uni_common_ringbuffer_mirror_map(size_t size) {
+    uint8_t *result = NULL;
+
+    int fd = memfd_create("uni_common_ringbuffer", MFD_CLOEXEC);
+    if (fd >= 0) {
+        if (ftruncate(fd, (off_t)size) == 0) {
+            // reserve contiguous address range first, then replace both halves with the file mappings
+            void *base = mmap(NULL, 2U * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base != MAP_FAILED) {
+                void *first = mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                void *second = mmap((uint8_t *)base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+
+                if (first == base && second == (uint8_t *)base + size) {
+                    result = (uint8_t *)base;
+                } else {
+                    (void) munmap(base, 2U * size);
+                }
+            }
+        }
+
+        // mappings keep the file alive
+        (void) close(fd);
+    }
+
+    return result;
+}
+#endif
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_mirror_granularity(void) {
+    size_t result = 0U;
+
+#if defined(__linux__)
+    long page = sysconf(_SC_PAGESIZE);
+    if (page > 0) {
+        result = (size_t)page;
+    }
+#endif
+
+    return result;
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_mirror_create(uni_common_ringbuffer_context_t *ctx, uint32_t size_object, uint32_t size_total) {
+    bool result = false;
+
+#if defined(__linux__)
+    size_t granularity = uni_common_ringbuffer_mirror_granularity();
+
+    if (ctx != NULL && size_object != 0U && size_total != 0U && granularity != 0U && size_total % granularity == 0U &&
+        size_total % size_object == 0U) {
+        uint8_t *data = _uni_common_ringbuffer_mirror_map(size_total);
+        if (data != NULL) {
+            size_t capacity = size_total / size_object;
+            if (capacity >= 2U && (capacity & (capacity - 1U)) == 0U) {
+                result = uni_common_ringbuffer_init_pow2(ctx, data, size_object, size_total);
+            } else {
+                result = uni_common_ringbuffer_init(ctx, data, size_object, size_total);
+            }
+
+            if (result) {
+                ctx->mirrored = true;
+            } else {
+                (void) munmap(data, 2U * (size_t)size_total);
+            }
+        }
+    }
+#else
+    (void) ctx;
+    (void) size_object;
+    (void) size_total;
+#endif
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_mirror_destroy(uni_common_ringbuffer_context_t *ctx) {
+    bool result = false;
+
+#if defined(__linux__)
+    if (ctx != NULL && ctx->data != NULL && ctx->mirrored) {
+        result = munmap(ctx->data, 2U * ctx->size_total) == 0;
+        (void) memset(ctx, 0, sizeof(*ctx));
+    }
+#else
+    (void) ctx;
+#endif
+
+    return result;
+}
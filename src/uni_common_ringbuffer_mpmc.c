@@ -0,0 +1,199 @@
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_math.h"
+#include "uni_common_ringbuffer_mpmc.h"
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Claims one slot for push
+ * @param ctx pointer to the MPMC queue context
+ * @param pos pointer to the claimed position
+ * @return true on success, false if queue is full
+ *
+ * @note input data must be valid
+ */
+static bool _uni_common_ringbuffer_mpmc_claim_back(uni_common_ringbuffer_mpmc_context_t *ctx, size_t *pos) {
+    bool result = false;
+    size_t pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_relaxed);
+
+    for (;;) {
+        size_t seq = atomic_load_explicit(&ctx->seqs[pos_back & ctx->mask], memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)(seq - pos_back);
+
+        if (diff == 0) {
+            // slot is free in this lap, try to take it
+            if (atomic_compare_exchange_weak_explicit(&ctx->pos_back, &pos_back, pos_back + 1U, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *pos = pos_back;
+                result = true;
+                break;
+            }
+        } else if (diff < 0) {
+            // slot still holds object of the previous lap
+            break;
+        } else {
+            // other producer took the slot
+            pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_relaxed);
+        }
+    }
+
+    return result;
+}
+
+
+/**
+ * Claims one slot for pop
+ * @param ctx pointer to the MPMC queue context
+ * @param pos pointer to the claimed position
+ * @return true on success, false if queue is empty
+ *
+ * @note input data must be valid
+ */
+static bool _uni_common_ringbuffer_mpmc_claim_front(uni_common_ringbuffer_mpmc_context_t *ctx, size_t *pos) {
+    bool result = false;
+    size_t pos_front = atomic_load_explicit(&ctx->pos_front, memory_order_relaxed);
+
+    for (;;) {
+        size_t seq = atomic_load_explicit(&ctx->seqs[pos_front & ctx->mask], memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)(seq - (pos_front + 1U));
+
+        if (diff == 0) {
+            // slot is filled in this lap, try to take it
+            if (atomic_compare_exchange_weak_explicit(&ctx->pos_front, &pos_front, pos_front + 1U, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *pos = pos_front;
+                result = true;
+                break;
+            }
+        } else if (diff < 0) {
+            // slot is not filled yet
+            break;
+        } else {
+            // other consumer took the slot
+            pos_front = atomic_load_explicit(&ctx->pos_front, memory_order_relaxed);
+        }
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_mpmc_init(uni_common_ringbuffer_mpmc_context_t *ctx, uint8_t *data, _Atomic(size_t) *seqs,
+                                     size_t size_object, size_t size_total) {
+    bool result = false;
+
+    if (ctx != NULL && data != NULL && seqs != NULL && size_object != 0U && (size_total % size_object == 0U)) {
+        size_t capacity = size_total / size_object;
+        if (capacity >= 2U && (capacity & (capacity - 1U)) == 0U) {
+            ctx->data = data;
+            ctx->seqs = seqs;
+            ctx->size_object = size_object;
+            ctx->mask = capacity - 1U;
+
+            result = uni_common_ringbuffer_mpmc_clear(ctx);
+        }
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_mpmc_capacity(const uni_common_ringbuffer_mpmc_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL) {
+        result = ctx->mask + 1U;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_mpmc_length(const uni_common_ringbuffer_mpmc_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        size_t pos_front = atomic_load_explicit(&ctx->pos_front, memory_order_acquire);
+        size_t pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_acquire);
+
+        // front is loaded first, so the difference never underflows, but it may count pushes which were
+        // claimed after the objects were popped
+        result = uni_common_math_min(pos_back - pos_front, ctx->mask + 1U);
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Operations
+//
+
+bool uni_common_ringbuffer_mpmc_clear(uni_common_ringbuffer_mpmc_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->seqs != NULL) {
+        for (size_t idx = 0U; idx <= ctx->mask; idx++) {
+            atomic_store_explicit(&ctx->seqs[idx], idx, memory_order_relaxed);
+        }
+        atomic_store_explicit(&ctx->pos_front, 0U, memory_order_relaxed);
+        atomic_store_explicit(&ctx->pos_back, 0U, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        result = true;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_mpmc_pop(uni_common_ringbuffer_mpmc_context_t *ctx, uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && data != NULL) {
+        size_t pos = 0U;
+        while (result < count && _uni_common_ringbuffer_mpmc_claim_front(ctx, &pos)) {
+            (void) memcpy(&data[result * ctx->size_object], &ctx->data[(pos & ctx->mask) * ctx->size_object], ctx->size_object);
+
+            // hand the slot over to the producer of the next lap
+            atomic_store_explicit(&ctx->seqs[pos & ctx->mask], pos + ctx->mask + 1U, memory_order_release);
+            result++;
+        }
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_mpmc_push(uni_common_ringbuffer_mpmc_context_t *ctx, const uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && data != NULL) {
+        size_t pos = 0U;
+        while (result < count && _uni_common_ringbuffer_mpmc_claim_back(ctx, &pos)) {
+            (void) memcpy(&ctx->data[(pos & ctx->mask) * ctx->size_object], &data[result * ctx->size_object], ctx->size_object);
+
+            // hand the slot over to the consumer of this lap
+            atomic_store_explicit(&ctx->seqs[pos & ctx->mask], pos + 1U, memory_order_release);
+            result++;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,309 @@
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_math.h"
+#include "uni_common_ringbuffer_record.h"
+
+
+//
+// Defines
+//
+
+/**
+ * Header value which marks the rest of data array as padding
+ */
+#define UNI_COMMON_RINGBUFFER_RECORD_PADDING UINT32_MAX
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Rounds size up to the alignment
+ * @param ctx pointer to the record ringbuffer context
+ * @param size size to round
+ * @return rounded size
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_record_align(const uni_common_ringbuffer_record_context_t *ctx, size_t size) {
+    return (size + ctx->align - 1U) & ~(ctx->align - 1U);
+}
+
+
+/**
+ * Returns size of the record header (uint32_t rounded up to the alignment)
+ * @param ctx pointer to the record ringbuffer context
+ * @return header size in bytes
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_record_header(const uni_common_ringbuffer_record_context_t *ctx) {
+    return _uni_common_ringbuffer_record_align(ctx, sizeof(uint32_t));
+}
+
+
+/**
+ * Returns number of free bytes
+ * @param ctx pointer to the record ringbuffer context
+ * @return free bytes
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_record_free(const uni_common_ringbuffer_record_context_t *ctx) {
+    return ctx->size_total - ctx->size_used;
+}
+
+
+/**
+ * Returns number of bytes which push of the record consumes at the current back position
+ * @param ctx pointer to the record ringbuffer context
+ * @param size_record size of the record including header and alignment
+ * @return record size plus the wrap padding if the record does not fit before the end of data array
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_record_needed(const uni_common_ringbuffer_record_context_t *ctx, size_t size_record) {
+    size_t size_tail = ctx->size_total - ctx->pos_back;
+    return size_record <= size_tail ? size_record : size_tail + size_record;
+}
+
+
+/**
+ * Moves the position forward
+ * @param ctx pointer to the record ringbuffer context
+ * @param pos position to move
+ * @param size number of bytes, position must not go past the end of data array
+ * @return new position, 0 when the end of data array was reached
+ *
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_record_advance(const uni_common_ringbuffer_record_context_t *ctx, size_t pos, size_t size) {
+    pos += size;
+    return pos == ctx->size_total ? 0U : pos;
+}
+
+
+/**
+ * Skips padding at the front position
+ * @param ctx pointer to the record ringbuffer context
+ * @return byte offset of the front record header
+ *
+ * @note ringbuffer must not be empty
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_record_front(uni_common_ringbuffer_record_context_t *ctx) {
+    uint32_t header;
+    (void) memcpy(&header, &ctx->data[ctx->pos_front], sizeof(header));
+    if (header == UNI_COMMON_RINGBUFFER_RECORD_PADDING) {
+        ctx->size_used -= ctx->size_total - ctx->pos_front;
+        ctx->pos_front = 0U;
+    }
+
+    return ctx->pos_front;
+}
+
+
+/**
+ * Drops the oldest record
+ * @param ctx pointer to the record ringbuffer context
+ *
+ * @note ringbuffer must not be empty
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_record_drop(uni_common_ringbuffer_record_context_t *ctx) {
+    size_t offset = _uni_common_ringbuffer_record_front(ctx);
+
+    uint32_t header;
+    (void) memcpy(&header, &ctx->data[offset], sizeof(header));
+    size_t size_record = _uni_common_ringbuffer_record_header(ctx) + _uni_common_ringbuffer_record_align(ctx, header);
+    ctx->pos_front = _uni_common_ringbuffer_record_advance(ctx, offset, size_record);
+    ctx->size_used -= size_record;
+    ctx->count--;
+
+    // keep the positions equal when the last record is gone
+    if (ctx->count == 0U) {
+        ctx->pos_front = ctx->pos_back;
+        ctx->size_used = 0U;
+    }
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_record_init(uni_common_ringbuffer_record_context_t *ctx, uint8_t *data, size_t size_total, size_t align) {
+    bool result = false;
+
+    if (ctx != NULL && data != NULL && align != 0U && (align & (align - 1U)) == 0U) {
+        align = uni_common_math_max(align, sizeof(uint32_t));
+        if (size_total % align == 0U && size_total >= 2U * align) {
+            ctx->data = data;
+            ctx->size_total = size_total;
+            ctx->align = align;
+
+            result = uni_common_ringbuffer_record_clear(ctx);
+        }
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_record_count(const uni_common_ringbuffer_record_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        result = ctx->count;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_record_is_empty(const uni_common_ringbuffer_record_context_t *ctx) {
+    return uni_common_ringbuffer_record_count(ctx) == 0U;
+}
+
+
+size_t uni_common_ringbuffer_record_size_max(const uni_common_ringbuffer_record_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL) {
+        result = uni_common_math_min(ctx->size_total - _uni_common_ringbuffer_record_header(ctx),
+                                     (size_t)UNI_COMMON_RINGBUFFER_RECORD_PADDING - 1U);
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_record_used(const uni_common_ringbuffer_record_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        result = ctx->size_used;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Operations
+//
+
+bool uni_common_ringbuffer_record_clear(uni_common_ringbuffer_record_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL) {
+        ctx->pos_front = 0U;
+        ctx->pos_back = 0U;
+        ctx->size_used = 0U;
+        ctx->count = 0U;
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_record_peek(const uni_common_ringbuffer_record_context_t *ctx, const uint8_t **data, size_t *size) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->data != NULL && data != NULL && size != NULL && ctx->count != 0U) {
+        // padding is skipped without modification of the context
+        size_t offset = ctx->pos_front;
+        uint32_t header;
+        (void) memcpy(&header, &ctx->data[offset], sizeof(header));
+        if (header == UNI_COMMON_RINGBUFFER_RECORD_PADDING) {
+            offset = 0U;
+            (void) memcpy(&header, ctx->data, sizeof(header));
+        }
+
+        *data = &ctx->data[offset + _uni_common_ringbuffer_record_header(ctx)];
+        *size = header;
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_record_pop(uni_common_ringbuffer_record_context_t *ctx, uint8_t *data, size_t data_size, size_t *size) {
+    bool result = false;
+
+    const uint8_t *payload = NULL;
+    size_t payload_size = 0U;
+    if (uni_common_ringbuffer_record_peek(ctx, &payload, &payload_size) && (data == NULL || payload_size <= data_size)) {
+        if (data != NULL) {
+            (void) memcpy(data, payload, payload_size);
+        }
+        if (size != NULL) {
+            *size = payload_size;
+        }
+
+        _uni_common_ringbuffer_record_drop(ctx);
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_record_push(uni_common_ringbuffer_record_context_t *ctx, const uint8_t *data, size_t size, bool overwrite) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->data != NULL && (data != NULL || size == 0U) && size <= uni_common_ringbuffer_record_size_max(ctx)) {
+        size_t size_header = _uni_common_ringbuffer_record_header(ctx);
+        size_t size_record = size_header + _uni_common_ringbuffer_record_align(ctx, size);
+
+        if (overwrite) {
+            while (ctx->count != 0U && _uni_common_ringbuffer_record_free(ctx) < _uni_common_ringbuffer_record_needed(ctx, size_record)) {
+                _uni_common_ringbuffer_record_drop(ctx);
+            }
+        }
+
+        // empty ringbuffer restarts from the beginning of data array, so the biggest record always fits
+        if (ctx->count == 0U) {
+            ctx->pos_back = 0U;
+            ctx->pos_front = 0U;
+            ctx->size_used = 0U;
+        }
+
+        if (_uni_common_ringbuffer_record_free(ctx) >= _uni_common_ringbuffer_record_needed(ctx, size_record)) {
+            // record which does not fit before the end of data array leaves the tail as padding
+            size_t size_tail = ctx->size_total - ctx->pos_back;
+            if (size_record > size_tail) {
+                uint32_t padding = UNI_COMMON_RINGBUFFER_RECORD_PADDING;
+                (void) memcpy(&ctx->data[ctx->pos_back], &padding, sizeof(padding));
+                ctx->pos_back = 0U;
+                ctx->size_used += size_tail;
+            }
+
+            size_t offset = ctx->pos_back;
+            uint32_t header = (uint32_t)size;
+            (void) memcpy(&ctx->data[offset], &header, sizeof(header));
+            if (size != 0U) {
+                (void) memcpy(&ctx->data[offset + size_header], data, size);
+            }
+
+            ctx->pos_back = _uni_common_ringbuffer_record_advance(ctx, offset, size_record);
+            ctx->size_used += size_record;
+            ctx->count++;
+            result = true;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,190 @@
+//
+// Includes
+//
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_math.h"
+#include "uni_common_ringbuffer_spsc.h"
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Copies objects into the data array, splitting the copy at the wrap point
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @param pos position of the first object
+ * @param data pointer to the source buffer
+ * @param count number of objects, must not exceed the capacity
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_spsc_copy_in(uni_common_ringbuffer_spsc_context_t *ctx, size_t pos, const uint8_t *data,
+                                                size_t count) {
+    size_t size_total = (ctx->mask + 1U) * ctx->size_object;
+    size_t offset = (pos & ctx->mask) * ctx->size_object;
+    size_t size = count * ctx->size_object;
+    size_t size_first = uni_common_math_min(size, size_total - offset);
+
+    (void) memcpy(&ctx->data[offset], data, size_first);
+    if (size_first < size) {
+        (void) memcpy(ctx->data, &data[size_first], size - size_first);
+    }
+}
+
+
+/**
+ * Copies objects out of the data array, splitting the copy at the wrap point
+ * @param ctx pointer to the SPSC ringbuffer context
+ * @param pos position of the first object
+ * @param data pointer to the destination buffer
+ * @param count number of objects, must not exceed the capacity
+ *
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_spsc_copy_out(const uni_common_ringbuffer_spsc_context_t *ctx, size_t pos, uint8_t *data,
+                                                 size_t count) {
+    size_t size_total = (ctx->mask + 1U) * ctx->size_object;
+    size_t offset = (pos & ctx->mask) * ctx->size_object;
+    size_t size = count * ctx->size_object;
+    size_t size_first = uni_common_math_min(size, size_total - offset);
+
+    (void) memcpy(data, &ctx->data[offset], size_first);
+    if (size_first < size) {
+        (void) memcpy(&data[size_first], ctx->data, size - size_first);
+    }
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_spsc_init(uni_common_ringbuffer_spsc_context_t *ctx, uint8_t *data, size_t size_object, size_t size_total) {
+    bool result = false;
+
+    if (ctx != NULL && data != NULL && size_object != 0U && (size_total % size_object == 0U)) {
+        size_t capacity = size_total / size_object;
+        if (capacity != 0U && (capacity & (capacity - 1U)) == 0U) {
+            ctx->data = data;
+            ctx->size_object = size_object;
+            ctx->mask = capacity - 1U;
+
+            result = uni_common_ringbuffer_spsc_clear(ctx);
+        }
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_spsc_capacity(const uni_common_ringbuffer_spsc_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL) {
+        result = ctx->mask + 1U;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_spsc_is_empty(const uni_common_ringbuffer_spsc_context_t *ctx) {
+    return uni_common_ringbuffer_spsc_length(ctx) == 0U;
+}
+
+
+size_t uni_common_ringbuffer_spsc_length(const uni_common_ringbuffer_spsc_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        // front is loaded first, so the difference never underflows
+        size_t pos_front = atomic_load_explicit(&ctx->pos_front, memory_order_acquire);
+        size_t pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_acquire);
+        result = pos_back - pos_front;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Operations
+//
+
+bool uni_common_ringbuffer_spsc_clear(uni_common_ringbuffer_spsc_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL) {
+        atomic_store_explicit(&ctx->pos_front, 0U, memory_order_relaxed);
+        atomic_store_explicit(&ctx->pos_back, 0U, memory_order_relaxed);
+        ctx->pos_front_cached = 0U;
+        ctx->pos_back_cached = 0U;
+        atomic_thread_fence(memory_order_release);
+        result = true;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_spsc_pop(uni_common_ringbuffer_spsc_context_t *ctx, uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL) {
+        size_t pos_front = atomic_load_explicit(&ctx->pos_front, memory_order_relaxed);
+
+        // reload producer index only when the cached one does not cover the request
+        size_t available = ctx->pos_back_cached - pos_front;
+        if (available < count) {
+            ctx->pos_back_cached = atomic_load_explicit(&ctx->pos_back, memory_order_acquire);
+            available = ctx->pos_back_cached - pos_front;
+        }
+
+        result = uni_common_math_min(count, available);
+        if (result != 0U) {
+            if (data != NULL) {
+                _uni_common_ringbuffer_spsc_copy_out(ctx, pos_front, data, result);
+            }
+
+            // release the slots only after the objects were copied out
+            atomic_store_explicit(&ctx->pos_front, pos_front + result, memory_order_release);
+        }
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_spsc_push(uni_common_ringbuffer_spsc_context_t *ctx, const uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->data != NULL && data != NULL) {
+        size_t capacity = ctx->mask + 1U;
+        size_t pos_back = atomic_load_explicit(&ctx->pos_back, memory_order_relaxed);
+
+        // reload consumer index only when the cached one does not leave enough free slots
+        size_t available = capacity - (pos_back - ctx->pos_front_cached);
+        if (available < count) {
+            ctx->pos_front_cached = atomic_load_explicit(&ctx->pos_front, memory_order_acquire);
+            available = capacity - (pos_back - ctx->pos_front_cached);
+        }
+
+        result = uni_common_math_min(count, available);
+        if (result != 0U) {
+            _uni_common_ringbuffer_spsc_copy_in(ctx, pos_back, data, result);
+
+            // publish the objects only after they were copied in
+            atomic_store_explicit(&ctx->pos_back, pos_back + result, memory_order_release);
+        }
+    }
+
+    return result;
+}
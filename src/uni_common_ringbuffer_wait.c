@@ -0,0 +1,273 @@
+//
+// Includes
+//
+
+#if defined(__linux__)
+    #if !defined(_GNU_SOURCE)
+        #define _GNU_SOURCE
+    #endif
+    #include <linux/futex.h>
+    #include <sched.h>
+    #include <sys/syscall.h>
+    #include <time.h>
+    #include <unistd.h>
+#else
+    #include <time.h>
+#endif
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "uni_common_ringbuffer_wait.h"
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Returns monotonic time
+ * @return time in nanoseconds
+ */
+static uint64_t _uni_common_ringbuffer_wait_now(void) {
+    struct timespec ts = {0};
+
+#if defined(__linux__)
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    (void) timespec_get(&ts, TIME_UTC);
+#endif
+
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+
+/**
+ * Tells the CPU that the thread is in the busy-wait loop
+ */
+static void _uni_common_ringbuffer_wait_relax(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+
+/**
+ * Gives the rest of the time slice to the other threads
+ */
+static void _uni_common_ringbuffer_wait_yield(void) {
+#if defined(__linux__)
+    (void) sched_yield();
+#else
+    _uni_common_ringbuffer_wait_relax();
+#endif
+}
+
+
+/**
+ * Checks that the deadline has passed
+ * @param deadline deadline in nanoseconds, UNI_COMMON_RINGBUFFER_WAIT_INFINITE for no deadline
+ * @return true if deadline has passed
+ */
+static bool _uni_common_ringbuffer_wait_expired(uint64_t deadline) {
+    return deadline != UNI_COMMON_RINGBUFFER_WAIT_INFINITE && _uni_common_ringbuffer_wait_now() >= deadline;
+}
+
+
+/**
+ * Parks the consumer until the wakeup, park_ns or the deadline
+ * @param ctx pointer to the wait strategy context
+ * @param deadline deadline in nanoseconds, UNI_COMMON_RINGBUFFER_WAIT_INFINITE for no deadline
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_wait_park(uni_common_ringbuffer_wait_context_t *ctx, uint64_t deadline) {
+    uint32_t epoch = atomic_load_explicit(&ctx->epoch, memory_order_acquire);
+
+    // announce the park first and check the ringbuffer after, producer does the opposite, so one of them sees the other
+    atomic_store_explicit(&ctx->parked, 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (uni_common_ringbuffer_spsc_is_empty(ctx->config.ring)) {
+        uint64_t duration = ctx->config.park_ns;
+        if (deadline != UNI_COMMON_RINGBUFFER_WAIT_INFINITE) {
+            uint64_t now = _uni_common_ringbuffer_wait_now();
+            uint64_t remaining = deadline > now ? deadline - now : 1U;
+            if (duration == 0U || duration > remaining) {
+                duration = remaining;
+            }
+        }
+
+        ctx->count_park++;
+
+#if defined(__linux__)
+        struct timespec ts = {
+            .tv_sec = (time_t)(duration / 1000000000U),
+            .tv_nsec = (long)(duration % 1000000000U),
+        };
+
+        // returns immediately when the epoch was changed after it was loaded
+        (void) syscall(SYS_futex, (uint32_t *)&ctx->epoch, FUTEX_WAIT_PRIVATE, epoch, duration != 0U ? &ts : NULL, NULL, 0);
+#else
+        uint64_t park_deadline = duration != 0U ? _uni_common_ringbuffer_wait_now() + duration : UNI_COMMON_RINGBUFFER_WAIT_INFINITE;
+        while (atomic_load_explicit(&ctx->epoch, memory_order_acquire) == epoch &&
+               !_uni_common_ringbuffer_wait_expired(park_deadline)) {
+            _uni_common_ringbuffer_wait_relax();
+        }
+#endif
+    }
+
+    atomic_store_explicit(&ctx->parked, 0U, memory_order_relaxed);
+}
+
+
+/**
+ * Wakes the consumer if it is parked and enough objects are available
+ * @param ctx pointer to the wait strategy context
+ * @param count_min minimal number of available objects
+ * @return true if the consumer was woken
+ * @note input data must be valid
+ */
+static bool _uni_common_ringbuffer_wait_notify(uni_common_ringbuffer_wait_context_t *ctx, size_t count_min) {
+    bool result = false;
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&ctx->parked, memory_order_relaxed) != 0U &&
+        uni_common_ringbuffer_spsc_length(ctx->config.ring) >= count_min &&
+        atomic_exchange_explicit(&ctx->parked, 0U, memory_order_relaxed) != 0U) {
+        // only the first notification after the park pays for the syscall
+        atomic_fetch_add_explicit(&ctx->epoch, 1U, memory_order_release);
+#if defined(__linux__)
+        (void) syscall(SYS_futex, (uint32_t *)&ctx->epoch, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+        ctx->count_wake++;
+        result = true;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_wait_init(uni_common_ringbuffer_wait_context_t *ctx, uni_common_ringbuffer_spsc_context_t *ring) {
+    uni_common_ringbuffer_wait_config_t config = {
+        .ring = ring,
+        .spin_count = 256U,
+        .yield_count = 16U,
+        .wake_batch = 1U,
+        .park_ns = 0U,
+    };
+
+    return uni_common_ringbuffer_wait_init_ex(ctx, &config);
+}
+
+
+bool uni_common_ringbuffer_wait_init_ex(uni_common_ringbuffer_wait_context_t *ctx, const uni_common_ringbuffer_wait_config_t *config) {
+    bool result = false;
+
+    if (ctx != NULL && config != NULL && config->ring != NULL && config->ring->data != NULL && config->wake_batch != 0U) {
+        (void) memset(ctx, 0, sizeof(*ctx));
+        ctx->config = *config;
+
+        atomic_store_explicit(&ctx->epoch, 0U, memory_order_relaxed);
+        atomic_store_explicit(&ctx->parked, 0U, memory_order_release);
+        result = true;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_wait_count_park(const uni_common_ringbuffer_wait_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        result = ctx->count_park;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_wait_count_wake(const uni_common_ringbuffer_wait_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL) {
+        result = ctx->count_wake;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Operations
+//
+
+bool uni_common_ringbuffer_wait_flush(uni_common_ringbuffer_wait_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->config.ring != NULL) {
+        result = _uni_common_ringbuffer_wait_notify(ctx, 1U);
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_wait_pop(uni_common_ringbuffer_wait_context_t *ctx, uint8_t *data, size_t count, uint64_t timeout_ns) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->config.ring != NULL) {
+        result = uni_common_ringbuffer_spsc_pop(ctx->config.ring, data, count);
+
+        if (result == 0U && count != 0U && timeout_ns != 0U) {
+            uint64_t deadline = UNI_COMMON_RINGBUFFER_WAIT_INFINITE;
+            uint64_t now = _uni_common_ringbuffer_wait_now();
+            if (timeout_ns < UNI_COMMON_RINGBUFFER_WAIT_INFINITE - now) {
+                deadline = now + timeout_ns;
+            }
+
+            // spin phase is not bounded by the clock, it is short and clock reads would dominate it
+            for (uint32_t idx = 0U; result == 0U && idx < ctx->config.spin_count; idx++) {
+                _uni_common_ringbuffer_wait_relax();
+                result = uni_common_ringbuffer_spsc_pop(ctx->config.ring, data, count);
+            }
+
+            for (uint32_t idx = 0U; result == 0U && idx < ctx->config.yield_count && !_uni_common_ringbuffer_wait_expired(deadline);
+                 idx++) {
+                _uni_common_ringbuffer_wait_yield();
+                result = uni_common_ringbuffer_spsc_pop(ctx->config.ring, data, count);
+            }
+
+            while (result == 0U && !_uni_common_ringbuffer_wait_expired(deadline)) {
+                _uni_common_ringbuffer_wait_park(ctx, deadline);
+                result = uni_common_ringbuffer_spsc_pop(ctx->config.ring, data, count);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_wait_push(uni_common_ringbuffer_wait_context_t *ctx, const uint8_t *data, size_t count) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->config.ring != NULL) {
+        result = uni_common_ringbuffer_spsc_push(ctx->config.ring, data, count);
+        if (result != 0U) {
+            (void) _uni_common_ringbuffer_wait_notify(ctx, ctx->config.wake_batch);
+        }
+    }
+
+    return result;
+}
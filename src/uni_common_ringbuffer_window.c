@@ -0,0 +1,307 @@
+//
+// Includes
+//
+
+#include <stdbool.h>
+
+#include "uni_common_ringbuffer_window.h"
+
+
+//
+// Functions/Private
+//
+
+/**
+ * Advances index of the window-sized array
+ * @param ctx pointer to the sliding window context
+ * @param idx index
+ * @return next index
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_window_next(const uni_common_ringbuffer_window_context_t *ctx, size_t idx) {
+    size_t result = idx + 1U;
+
+    if (result == ctx->capacity) {
+        result = 0U;
+    }
+
+    return result;
+}
+
+
+/**
+ * Returns the index of the deque entry
+ * @param ctx pointer to the sliding window context
+ * @param deque pointer to the deque
+ * @param offset offset of the entry from the deque head
+ * @return index inside the entries array
+ * @note input data must be valid
+ */
+static size_t _uni_common_ringbuffer_window_deque_index(const uni_common_ringbuffer_window_context_t *ctx,
+                                                        const uni_common_ringbuffer_window_deque_t *deque, size_t offset) {
+    size_t result = deque->head + offset;
+
+    if (result >= ctx->capacity) {
+        result -= ctx->capacity;
+    }
+
+    return result;
+}
+
+
+/**
+ * Pushes the sample into the monotonic deque, dropping the entries which can not become the extremum anymore
+ * @param ctx pointer to the sliding window context
+ * @param deque pointer to the deque
+ * @param value sample value
+ * @param is_max true for maximum deque, false for minimum deque
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_window_deque_push(const uni_common_ringbuffer_window_context_t *ctx,
+                                                     uni_common_ringbuffer_window_deque_t *deque, double value, bool is_max) {
+    while (deque->count != 0U) {
+        double back = deque->entries[_uni_common_ringbuffer_window_deque_index(ctx, deque, deque->count - 1U)].value;
+        if (is_max ? back > value : back < value) {
+            break;
+        }
+        deque->count--;
+    }
+
+    uni_common_ringbuffer_window_entry_t *entry = &deque->entries[_uni_common_ringbuffer_window_deque_index(ctx, deque, deque->count)];
+    entry->value = value;
+    entry->pos = ctx->pos_back;
+    deque->count++;
+}
+
+
+/**
+ * Drops the deque front entry if it belongs to the evicted sample
+ * @param ctx pointer to the sliding window context
+ * @param deque pointer to the deque
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_window_deque_evict(const uni_common_ringbuffer_window_context_t *ctx,
+                                                      uni_common_ringbuffer_window_deque_t *deque) {
+    if (deque->count != 0U && deque->entries[deque->head].pos == ctx->pos_front) {
+        deque->head = _uni_common_ringbuffer_window_next(ctx, deque->head);
+        deque->count--;
+    }
+}
+
+
+/**
+ * Adds value to the compensated running sum
+ * @param ctx pointer to the sliding window context
+ * @param value value to add
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_window_sum_add(uni_common_ringbuffer_window_context_t *ctx, double value) {
+    double sum = ctx->sum + value;
+
+    // Neumaier: keep the low-order bits lost by the addition of the smaller operand
+    if ((ctx->sum >= 0.0 ? ctx->sum : -ctx->sum) >= (value >= 0.0 ? value : -value)) {
+        ctx->sum_comp += (ctx->sum - sum) + value;
+    } else {
+        ctx->sum_comp += (value - sum) + ctx->sum;
+    }
+    ctx->sum = sum;
+}
+
+
+/**
+ * Recalculates the running sum from the stored values
+ * @param ctx pointer to the sliding window context
+ * @note input data must be valid
+ */
+static void _uni_common_ringbuffer_window_sum_anchor(uni_common_ringbuffer_window_context_t *ctx) {
+    ctx->sum = 0.0;
+    ctx->sum_comp = 0.0;
+
+    size_t slot = ctx->slot_front;
+    for (size_t idx = ctx->pos_front; idx != ctx->pos_back; idx++) {
+        _uni_common_ringbuffer_window_sum_add(ctx, ctx->values[slot]);
+        slot = _uni_common_ringbuffer_window_next(ctx, slot);
+    }
+
+    ctx->anchor_countdown = ctx->capacity;
+}
+
+
+/**
+ * Evicts the oldest sample
+ * @param ctx pointer to the sliding window context
+ * @note window must be valid and not empty
+ */
+static void _uni_common_ringbuffer_window_evict(uni_common_ringbuffer_window_context_t *ctx) {
+    _uni_common_ringbuffer_window_deque_evict(ctx, &ctx->deque_min);
+    _uni_common_ringbuffer_window_deque_evict(ctx, &ctx->deque_max);
+    _uni_common_ringbuffer_window_sum_add(ctx, -ctx->values[ctx->slot_front]);
+
+    ctx->slot_front = _uni_common_ringbuffer_window_next(ctx, ctx->slot_front);
+    ctx->pos_front++;
+
+    // amortized O(1): one O(capacity) pass per capacity evictions
+    ctx->anchor_countdown--;
+    if (ctx->anchor_countdown == 0U) {
+        _uni_common_ringbuffer_window_sum_anchor(ctx);
+    }
+}
+
+
+//
+// Functions/Init
+//
+
+bool uni_common_ringbuffer_window_init(uni_common_ringbuffer_window_context_t *ctx, double *values,
+                                       uni_common_ringbuffer_window_entry_t *entries_min,
+                                       uni_common_ringbuffer_window_entry_t *entries_max, size_t capacity) {
+    bool result = false;
+
+    if (ctx != NULL && values != NULL && entries_min != NULL && entries_max != NULL && capacity != 0U) {
+        ctx->values = values;
+        ctx->deque_min.entries = entries_min;
+        ctx->deque_max.entries = entries_max;
+        ctx->capacity = capacity;
+
+        result = uni_common_ringbuffer_window_clear(ctx);
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Getters
+//
+
+size_t uni_common_ringbuffer_window_capacity(const uni_common_ringbuffer_window_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->values != NULL) {
+        result = ctx->capacity;
+    }
+
+    return result;
+}
+
+
+size_t uni_common_ringbuffer_window_length(const uni_common_ringbuffer_window_context_t *ctx) {
+    size_t result = 0U;
+
+    if (ctx != NULL && ctx->values != NULL) {
+        result = ctx->pos_back - ctx->pos_front;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_window_max(const uni_common_ringbuffer_window_context_t *ctx, double *value) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->values != NULL && value != NULL && ctx->deque_max.count != 0U) {
+        *value = ctx->deque_max.entries[ctx->deque_max.head].value;
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_window_mean(const uni_common_ringbuffer_window_context_t *ctx, double *value) {
+    bool result = false;
+
+    size_t length = uni_common_ringbuffer_window_length(ctx);
+    if (length != 0U && value != NULL) {
+        *value = uni_common_ringbuffer_window_sum(ctx) / (double)length;
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_window_min(const uni_common_ringbuffer_window_context_t *ctx, double *value) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->values != NULL && value != NULL && ctx->deque_min.count != 0U) {
+        *value = ctx->deque_min.entries[ctx->deque_min.head].value;
+        result = true;
+    }
+
+    return result;
+}
+
+
+double uni_common_ringbuffer_window_sum(const uni_common_ringbuffer_window_context_t *ctx) {
+    double result = 0.0;
+
+    if (ctx != NULL && ctx->values != NULL) {
+        result = ctx->sum + ctx->sum_comp;
+    }
+
+    return result;
+}
+
+
+//
+// Functions/Operations
+//
+
+bool uni_common_ringbuffer_window_clear(uni_common_ringbuffer_window_context_t *ctx) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->values != NULL) {
+        ctx->pos_front = 0U;
+        ctx->pos_back = 0U;
+        ctx->slot_front = 0U;
+        ctx->deque_min.head = 0U;
+        ctx->deque_min.count = 0U;
+        ctx->deque_max.head = 0U;
+        ctx->deque_max.count = 0U;
+        ctx->sum = 0.0;
+        ctx->sum_comp = 0.0;
+        ctx->anchor_countdown = ctx->capacity;
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_window_pop(uni_common_ringbuffer_window_context_t *ctx) {
+    bool result = false;
+
+    if (uni_common_ringbuffer_window_length(ctx) != 0U) {
+        _uni_common_ringbuffer_window_evict(ctx);
+        result = true;
+    }
+
+    return result;
+}
+
+
+bool uni_common_ringbuffer_window_push(uni_common_ringbuffer_window_context_t *ctx, double value) {
+    bool result = false;
+
+    if (ctx != NULL && ctx->values != NULL) {
+        if (ctx->pos_back - ctx->pos_front == ctx->capacity) {
+            _uni_common_ringbuffer_window_evict(ctx);
+        }
+
+        size_t slot_back = ctx->slot_front + (ctx->pos_back - ctx->pos_front);
+        if (slot_back >= ctx->capacity) {
+            slot_back -= ctx->capacity;
+        }
+        ctx->values[slot_back] = value;
+
+        _uni_common_ringbuffer_window_deque_push(ctx, &ctx->deque_min, value, false);
+        _uni_common_ringbuffer_window_deque_push(ctx, &ctx->deque_max, value, true);
+        _uni_common_ringbuffer_window_sum_add(ctx, value);
+
+        ctx->pos_back++;
+        result = true;
+    }
+
+    return result;
+}
@@ -0,0 +1,312 @@
+//
+// Includes
+//
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "uni_common.h"
+
+
+//
+// Static
+//
+
+static constexpr size_t _nodes_count = 512;
+static uni_common_btreemap_context_t _ctx;
+
+static uni_common_array_t _arr_nodes{};
+static uni_common_btreemap_node_t _arr_nodes_buf[_nodes_count];
+
+static uni_common_array_t _arr_vals{};
+static size_t _arr_vals_buf[_nodes_count * UNI_COMMON_BTREEMAP_ORDER];
+
+static std::vector<std::pair<size_t, size_t>> _visited;
+
+
+//
+// Private
+//
+
+bool _btreemap_init(size_t nodes_count) {
+    _ctx = {};
+    uni_common_array_init(&_arr_nodes, (uint8_t *)_arr_nodes_buf, nodes_count * sizeof(uni_common_btreemap_node_t),
+                          sizeof(uni_common_btreemap_node_t));
+    uni_common_array_init(&_arr_vals, (uint8_t *)_arr_vals_buf, sizeof(_arr_vals_buf), sizeof(size_t));
+
+    bool result = uni_common_btreemap_init(&_ctx, &_arr_nodes, &_arr_vals);
+
+    REQUIRE(uni_common_btreemap_initialized(&_ctx));
+
+    return result;
+}
+
+void _btreemap_visit(size_t key, const void *val) {
+    _visited.emplace_back(key, *(const size_t *)val);
+}
+
+void _btreemap_check(const std::map<size_t, size_t> &reference) {
+    REQUIRE(uni_common_btreemap_size(&_ctx) == reference.size());
+
+    _visited.clear();
+    REQUIRE(uni_common_btreemap_enum(&_ctx, _btreemap_visit));
+    REQUIRE(_visited == std::vector<std::pair<size_t, size_t>>(reference.begin(), reference.end()));
+
+    for (const auto &[key, val] : reference) {
+        REQUIRE(*(size_t *)uni_common_btreemap_get(&_ctx, key) == val);
+    }
+}
+
+
+//
+// Tests
+//
+
+TEST_CASE("btreemap_init", "[btreemap]") {
+    SECTION("nullptr") {
+        REQUIRE_FALSE(uni_common_btreemap_init(nullptr, nullptr, nullptr));
+        REQUIRE_FALSE(uni_common_btreemap_init(&_ctx, nullptr, nullptr));
+        REQUIRE_FALSE(uni_common_btreemap_initialized(nullptr));
+        REQUIRE(uni_common_btreemap_size(nullptr) == 0);
+        REQUIRE(uni_common_btreemap_height(nullptr) == 0);
+        REQUIRE_FALSE(uni_common_btreemap_clear(nullptr));
+        REQUIRE(uni_common_btreemap_get(nullptr, 0) == nullptr);
+        REQUIRE_FALSE(uni_common_btreemap_set(nullptr, 0, nullptr));
+        REQUIRE_FALSE(uni_common_btreemap_remove(nullptr, 0));
+        REQUIRE_FALSE(uni_common_btreemap_lower_bound(nullptr, 0, nullptr, nullptr));
+    }
+
+    SECTION("too small values array") {
+        uni_common_btreemap_context_t ctx{};
+        uni_common_array_init(&_arr_nodes, (uint8_t *)_arr_nodes_buf, sizeof(_arr_nodes_buf), sizeof(uni_common_btreemap_node_t));
+        uni_common_array_init(&_arr_vals, (uint8_t *)_arr_vals_buf, (UNI_COMMON_BTREEMAP_ORDER - 1) * sizeof(size_t), sizeof(size_t));
+        REQUIRE_FALSE(uni_common_btreemap_init(&ctx, &_arr_nodes, &_arr_vals));
+    }
+
+    SECTION("ok") {
+        REQUIRE(_btreemap_init(_nodes_count));
+        REQUIRE(_ctx.node_count == _nodes_count);
+        REQUIRE(uni_common_btreemap_size(&_ctx) == 0);
+        REQUIRE(uni_common_btreemap_height(&_ctx) == 1);
+        REQUIRE(uni_common_btreemap_get(&_ctx, 0) == nullptr);
+        REQUIRE_FALSE(uni_common_btreemap_lower_bound(&_ctx, 0, nullptr, nullptr));
+    }
+}
+
+
+TEST_CASE("btreemap_set", "[btreemap]") {
+    SECTION("update") {
+        REQUIRE(_btreemap_init(_nodes_count));
+
+        size_t val = 1;
+        REQUIRE(uni_common_btreemap_set(&_ctx, SIZE_MAX, &val));
+        REQUIRE(uni_common_btreemap_set(&_ctx, 0, &val));
+        val = 2;
+        REQUIRE(uni_common_btreemap_set(&_ctx, SIZE_MAX, &val));
+        REQUIRE(uni_common_btreemap_size(&_ctx) == 2);
+        REQUIRE(*(size_t *)uni_common_btreemap_get(&_ctx, SIZE_MAX) == 2);
+        REQUIRE(*(size_t *)uni_common_btreemap_get(&_ctx, 0) == 1);
+    }
+
+    SECTION("random") {
+        REQUIRE(_btreemap_init(_nodes_count));
+
+        std::map<size_t, size_t> reference;
+        std::mt19937_64 rng(1);
+        for (size_t idx = 0; idx < 2000; idx++) {
+            size_t key = rng() % 100000;
+            size_t val = rng();
+            REQUIRE(uni_common_btreemap_set(&_ctx, key, &val));
+            reference[key] = val;
+        }
+
+        REQUIRE(uni_common_btreemap_height(&_ctx) >= 3);
+        _btreemap_check(reference);
+        REQUIRE(uni_common_btreemap_get(&_ctx, 100000) == nullptr);
+    }
+
+    SECTION("ascending keys fill the nodes") {
+        REQUIRE(_btreemap_init(_nodes_count));
+
+        size_t count = UNI_COMMON_BTREEMAP_ORDER * 100;
+        for (size_t key = 0; key < count; key++) {
+            REQUIRE(uni_common_btreemap_set(&_ctx, key * 10, &key));
+        }
+
+        // 100 full leaves, 5 inner nodes and the root
+        REQUIRE(_ctx.node_count - _ctx.node_free_count == 106);
+        REQUIRE(uni_common_btreemap_height(&_ctx) == 3);
+    }
+
+    SECTION("out of nodes") {
+        REQUIRE(_btreemap_init(4));
+
+        std::map<size_t, size_t> reference;
+        size_t key = 0;
+        while (true) {
+            key = key * 2654435761U % 1000003U + 1U;
+            if (!uni_common_btreemap_set(&_ctx, key, &key)) {
+                break;
+            }
+            reference[key] = key;
+        }
+
+        REQUIRE(reference.size() >= UNI_COMMON_BTREEMAP_ORDER * 2);
+        _btreemap_check(reference);
+
+        // update of the existing key does not need free nodes
+        size_t val = 7;
+        REQUIRE(uni_common_btreemap_set(&_ctx, reference.begin()->first, &val));
+    }
+}
+
+
+TEST_CASE("btreemap_remove", "[btreemap]") {
+    REQUIRE(_btreemap_init(_nodes_count));
+
+    std::map<size_t, size_t> reference;
+    std::mt19937_64 rng(2);
+    for (size_t iter = 0; iter < 20000; iter++) {
+        size_t key = rng() % 3000;
+        size_t val = rng();
+        if (rng() % 2 == 0) {
+            REQUIRE(uni_common_btreemap_remove(&_ctx, key) == (reference.erase(key) == 1));
+        } else {
+            REQUIRE(uni_common_btreemap_set(&_ctx, key, &val));
+            reference[key] = val;
+        }
+
+        if (iter % 1000 == 0) {
+            _btreemap_check(reference);
+        }
+    }
+    _btreemap_check(reference);
+
+    // all nodes are returned to the free list
+    for (const auto &[key, val] : reference) {
+        REQUIRE(uni_common_btreemap_remove(&_ctx, key));
+    }
+    REQUIRE(uni_common_btreemap_size(&_ctx) == 0);
+    REQUIRE(uni_common_btreemap_height(&_ctx) == 1);
+    REQUIRE(_ctx.node_free_count == _ctx.node_count - 1);
+
+    size_t val = 5;
+    REQUIRE(uni_common_btreemap_set(&_ctx, 5, &val));
+    REQUIRE(*(size_t *)uni_common_btreemap_get(&_ctx, 5) == 5);
+}
+
+
+TEST_CASE("btreemap_range", "[btreemap]") {
+    REQUIRE(_btreemap_init(_nodes_count));
+
+    std::map<size_t, size_t> reference;
+    std::mt19937_64 rng(3);
+    for (size_t idx = 0; idx < 1500; idx++) {
+        size_t key = rng() % 10000;
+        REQUIRE(uni_common_btreemap_set(&_ctx, key, &idx));
+        reference[key] = idx;
+    }
+    for (size_t idx = 0; idx < 500; idx++) {
+        size_t key = rng() % 10000;
+        uni_common_btreemap_remove(&_ctx, key);
+        reference.erase(key);
+    }
+
+    SECTION("lower_bound") {
+        for (size_t key = 0; key < 10100; key += 7) {
+            auto it = reference.lower_bound(key);
+
+            size_t key_found = 0;
+            uint8_t *val_found = nullptr;
+            REQUIRE(uni_common_btreemap_lower_bound(&_ctx, key, &key_found, &val_found) == (it != reference.end()));
+            if (it != reference.end()) {
+                REQUIRE(key_found == it->first);
+                REQUIRE(*(size_t *)val_found == it->second);
+            }
+        }
+    }
+
+    SECTION("enum_range") {
+        REQUIRE(uni_common_btreemap_enum_range(&_ctx, 0, 100, nullptr) == 0);
+        REQUIRE(uni_common_btreemap_enum_range(&_ctx, 100, 100, _btreemap_visit) == 0);
+
+        for (size_t lo = 0; lo < 10000; lo += 333) {
+            size_t hi = lo + rng() % 2000;
+
+            _visited.clear();
+            size_t count = uni_common_btreemap_enum_range(&_ctx, lo, hi, _btreemap_visit);
+            std::vector<std::pair<size_t, size_t>> expected(reference.lower_bound(lo), reference.lower_bound(hi));
+            REQUIRE(count == expected.size());
+            REQUIRE(_visited == expected);
+        }
+
+        _visited.clear();
+        REQUIRE(uni_common_btreemap_enum_range(&_ctx, 0, SIZE_MAX, _btreemap_visit) == reference.size());
+    }
+}
+
+
+TEST_CASE("btreemap_load", "[btreemap]") {
+    REQUIRE(_btreemap_init(_nodes_count));
+
+    std::vector<size_t> keys(3000);
+    std::vector<size_t> vals(keys.size());
+    for (size_t idx = 0; idx < keys.size(); idx++) {
+        keys[idx] = idx * 3 + 1;
+        vals[idx] = idx;
+    }
+
+    SECTION("invalid") {
+        size_t val = 9;
+        REQUIRE(uni_common_btreemap_set(&_ctx, 9, &val));
+
+        std::swap(keys[10], keys[11]);
+        REQUIRE_FALSE(uni_common_btreemap_load(&_ctx, keys.data(), keys.size(), vals.data()));
+        REQUIRE_FALSE(uni_common_btreemap_load(&_ctx, nullptr, keys.size(), vals.data()));
+
+        // 3000 keys need 150 leaves, 8 + 1 inner nodes
+        _btreemap_init(158);
+        REQUIRE(uni_common_btreemap_set(&_ctx, 9, &val));
+        std::swap(keys[10], keys[11]);
+        REQUIRE_FALSE(uni_common_btreemap_load(&_ctx, keys.data(), keys.size(), vals.data()));
+        REQUIRE(uni_common_btreemap_size(&_ctx) == 1);
+        REQUIRE(*(size_t *)uni_common_btreemap_get(&_ctx, 9) == 9);
+
+        _btreemap_init(159);
+        REQUIRE(uni_common_btreemap_load(&_ctx, keys.data(), keys.size(), vals.data()));
+        REQUIRE(_ctx.node_free_count == 0);
+    }
+
+    SECTION("ok") {
+        for (size_t count : {size_t(0), size_t(1), size_t(UNI_COMMON_BTREEMAP_ORDER), size_t(UNI_COMMON_BTREEMAP_ORDER + 1), keys.size()}) {
+            REQUIRE(uni_common_btreemap_load(&_ctx, keys.data(), count, vals.data()));
+
+            std::map<size_t, size_t> reference;
+            for (size_t idx = 0; idx < count; idx++) {
+                reference[keys[idx]] = vals[idx];
+            }
+            _btreemap_check(reference);
+        }
+        REQUIRE(uni_common_btreemap_height(&_ctx) == 3);
+
+        // loaded tree accepts the regular updates
+        std::map<size_t, size_t> reference;
+        for (size_t idx = 0; idx < keys.size(); idx++) {
+            reference[keys[idx]] = vals[idx];
+        }
+        std::mt19937_64 rng(4);
+        for (size_t iter = 0; iter < 3000; iter++) {
+            size_t key = rng() % 9000;
+            if (rng() % 2 == 0) {
+                REQUIRE(uni_common_btreemap_remove(&_ctx, key) == (reference.erase(key) == 1));
+            } else {
+                REQUIRE(uni_common_btreemap_set(&_ctx, key, &iter));
+                reference[key] = iter;
+            }
+        }
+        _btreemap_check(reference);
+    }
+}
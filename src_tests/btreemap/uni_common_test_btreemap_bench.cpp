@@ -0,0 +1,145 @@
+//
+// Includes
+//
+
+// stdlib
+#include <map>
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct btreemap_bench {
+        std::vector<uni_common_btreemap_node_t> nodes_buf;
+        std::vector<size_t> vals_buf;
+        uni_common_array_t nodes{};
+        uni_common_array_t vals{};
+        uni_common_btreemap_context_t ctx{};
+
+        explicit btreemap_bench(size_t count) : nodes_buf(count * 2 / UNI_COMMON_BTREEMAP_ORDER + 16) {
+            vals_buf.resize(nodes_buf.size() * UNI_COMMON_BTREEMAP_ORDER);
+            uni_common_array_init(&nodes, (uint8_t *)nodes_buf.data(), nodes_buf.size() * sizeof(uni_common_btreemap_node_t),
+                                  sizeof(uni_common_btreemap_node_t));
+            uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), vals_buf.size() * sizeof(size_t), sizeof(size_t));
+            uni_common_btreemap_init(&ctx, &nodes, &vals);
+        }
+    };
+
+    size_t btreemap_bench_sum;
+
+    void btreemap_bench_visit(size_t key, const void *) {
+        btreemap_bench_sum += key;
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("btreemap_bench_lookup", "[.][benchmark][btreemap]") {
+    for (size_t count : {10000U, 1000000U}) {
+        std::vector<size_t> keys(count);
+        std::vector<size_t> vals(count);
+        for (size_t idx = 0; idx < count; idx++) {
+            keys[idx] = idx * 16;
+            vals[idx] = idx;
+        }
+
+        btreemap_bench bench(count);
+        uni_common_btreemap_load(&bench.ctx, keys.data(), count, vals.data());
+
+        std::map<size_t, size_t> reference;
+        for (size_t idx = 0; idx < count; idx++) {
+            reference.emplace(keys[idx], vals[idx]);
+        }
+
+        uint64_t seed = 1;
+        BENCHMARK("get/btreemap/" + std::to_string(count)) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            return uni_common_btreemap_get(&bench.ctx, ((seed >> 33) % count) * 16);
+        };
+
+        BENCHMARK("get/std::map/" + std::to_string(count)) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            return reference.find(((seed >> 33) % count) * 16)->second;
+        };
+
+        size_t key_found = 0;
+        BENCHMARK("lower_bound/btreemap/" + std::to_string(count)) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            uni_common_btreemap_lower_bound(&bench.ctx, (seed >> 33) % (count * 16), &key_found, nullptr);
+            return key_found;
+        };
+
+        BENCHMARK("lower_bound/std::map/" + std::to_string(count)) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            return reference.lower_bound((seed >> 33) % (count * 16))->first;
+        };
+
+        // 1000 keys per scan
+        BENCHMARK("range-1000/btreemap/" + std::to_string(count)) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t lo = (seed >> 33) % (count - 1000) * 16;
+            btreemap_bench_sum = 0;
+            uni_common_btreemap_enum_range(&bench.ctx, lo, lo + 16000, btreemap_bench_visit);
+            return btreemap_bench_sum;
+        };
+
+        BENCHMARK("range-1000/std::map/" + std::to_string(count)) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t lo = (seed >> 33) % (count - 1000) * 16;
+            btreemap_bench_sum = 0;
+            for (auto it = reference.lower_bound(lo); it != reference.end() && it->first < lo + 16000; ++it) {
+                btreemap_bench_visit(it->first, &it->second);
+            }
+            return btreemap_bench_sum;
+        };
+    }
+}
+
+
+TEST_CASE("btreemap_bench_build", "[.][benchmark][btreemap]") {
+    size_t count = 1000000;
+    std::vector<size_t> keys(count);
+    std::vector<size_t> vals(count);
+    for (size_t idx = 0; idx < count; idx++) {
+        keys[idx] = idx * 16;
+        vals[idx] = idx;
+    }
+
+    btreemap_bench bench(count);
+
+    BENCHMARK("load/btreemap/" + std::to_string(count)) {
+        return uni_common_btreemap_load(&bench.ctx, keys.data(), count, vals.data());
+    };
+
+    BENCHMARK("set-ascending/btreemap/" + std::to_string(count)) {
+        uni_common_btreemap_clear(&bench.ctx);
+        for (size_t idx = 0; idx < count; idx++) {
+            uni_common_btreemap_set(&bench.ctx, keys[idx], &vals[idx]);
+        }
+        return uni_common_btreemap_size(&bench.ctx);
+    };
+
+    BENCHMARK("set-ascending/std::map/" + std::to_string(count)) {
+        std::map<size_t, size_t> reference;
+        for (size_t idx = 0; idx < count; idx++) {
+            reference.emplace_hint(reference.end(), keys[idx], vals[idx]);
+        }
+        return reference.size();
+    };
+}
@@ -3,6 +3,8 @@
 //
 
 #include <cstring>
+#include <random>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -29,6 +31,21 @@ static size_t _arr_keys_buf[_capacity];
 static uni_common_array_t _arr_vals{};
 static size_t _arr_vals_buf[_capacity];
 
+static uni_common_array_t _arr_nodes{};
+static uni_common_lrumap_node_t _arr_nodes_buf[_capacity];
+
+static uni_common_array_t _arr_index{};
+static size_t _arr_index_buf[_capacity * 2];
+
+static uni_common_array_t _arr_rank_tree{};
+static size_t _arr_rank_tree_buf[_capacity * 2];
+
+static uni_common_array_t _arr_rank_slots{};
+static size_t _arr_rank_slots_buf[_capacity * 2];
+
+static uni_common_array_t _arr_rank_stamps{};
+static size_t _arr_rank_stamps_buf[_capacity];
+
 
 //
 // Private
@@ -60,6 +77,104 @@ bool _lrumap_init() {
     return result;
 }
 
+bool _lrumap_init_compact() {
+    memset(&_ctx, 0, sizeof(_ctx));
+    memset(_arr_nodes_buf, 0, sizeof(_arr_nodes_buf));
+    memset(_arr_vals_buf, 0, sizeof(_arr_vals_buf));
+
+    uni_common_array_init(&_arr_nodes, (uint8_t *)_arr_nodes_buf, sizeof(_arr_nodes_buf), sizeof(uni_common_lrumap_node_t));
+    uni_common_array_init(&_arr_vals, (uint8_t *)_arr_vals_buf, sizeof(_arr_vals_buf), sizeof(size_t));
+
+    bool result = uni_common_lrumap_init_compact(&_ctx, &_arr_nodes, &_arr_vals);
+
+    REQUIRE(uni_common_lrumap_initialized(&_ctx));
+
+    return result;
+}
+
+bool _lrumap_init_index() {
+    bool result = _lrumap_init();
+
+    memset(_arr_index_buf, 0, sizeof(_arr_index_buf));
+    uni_common_array_init(&_arr_index, (uint8_t *)_arr_index_buf, sizeof(_arr_index_buf), sizeof(size_t));
+
+    return result && uni_common_lrumap_set_index(&_ctx, &_arr_index);
+}
+
+
+bool _lrumap_init_rank(size_t rank_length) {
+    bool result = _lrumap_init();
+
+    uni_common_array_init(&_arr_rank_tree, (uint8_t *)_arr_rank_tree_buf, rank_length * sizeof(size_t), sizeof(size_t));
+    uni_common_array_init(&_arr_rank_slots, (uint8_t *)_arr_rank_slots_buf, rank_length * sizeof(size_t), sizeof(size_t));
+    uni_common_array_init(&_arr_rank_stamps, (uint8_t *)_arr_rank_stamps_buf, sizeof(_arr_rank_stamps_buf), sizeof(size_t));
+
+    return result && uni_common_lrumap_set_rank(&_ctx, &_arr_rank_tree, &_arr_rank_slots, &_arr_rank_stamps);
+}
+
+
+/**
+ * LRU-map with the dynamically allocated storage, used as a reference
+ */
+struct lrumap_reference {
+    std::vector<size_t> link_prev;
+    std::vector<size_t> link_next;
+    std::vector<size_t> keys;
+    std::vector<size_t> vals;
+    uni_common_array_t arr_link_prev{};
+    uni_common_array_t arr_link_next{};
+    uni_common_array_t arr_keys{};
+    uni_common_array_t arr_vals{};
+    uni_common_lrumap_context_t ctx{};
+
+    explicit lrumap_reference(size_t capacity)
+        : link_prev(capacity), link_next(capacity), keys(capacity), vals(capacity) {
+        uni_common_array_init(&arr_link_prev, (uint8_t *)link_prev.data(), capacity * sizeof(size_t), sizeof(size_t));
+        uni_common_array_init(&arr_link_next, (uint8_t *)link_next.data(), capacity * sizeof(size_t), sizeof(size_t));
+        uni_common_array_init(&arr_keys, (uint8_t *)keys.data(), capacity * sizeof(size_t), sizeof(size_t));
+        uni_common_array_init(&arr_vals, (uint8_t *)vals.data(), capacity * sizeof(size_t), sizeof(size_t));
+        uni_common_lrumap_init(&ctx, &arr_link_prev, &arr_link_next, &arr_keys, &arr_vals);
+    }
+};
+
+
+/**
+ * Applies the same random operations to the tested and to the reference LRU-maps and compares them
+ */
+static void _lrumap_compare_random(uni_common_lrumap_context_t *ctx, size_t iterations) {
+    lrumap_reference reference(uni_common_lrumap_capacity(ctx));
+
+    std::mt19937_64 rng(42);
+    for (size_t iter = 0; iter < iterations; iter++) {
+        size_t key = rng() % (_capacity * 2);
+        size_t val = rng();
+        switch (rng() % 8) {
+            case 0:
+                REQUIRE(uni_common_lrumap_remove(ctx, key) == uni_common_lrumap_remove(&reference.ctx, key));
+                break;
+            case 1:
+                REQUIRE(uni_common_lrumap_remove_first(ctx) == uni_common_lrumap_remove_first(&reference.ctx));
+                break;
+            case 2:
+                REQUIRE(uni_common_lrumap_remove_last(ctx) == uni_common_lrumap_remove_last(&reference.ctx));
+                break;
+            default:
+                REQUIRE(uni_common_lrumap_update(ctx, key, &val));
+                REQUIRE(uni_common_lrumap_update(&reference.ctx, key, &val));
+                break;
+        }
+
+        REQUIRE(uni_common_lrumap_length(ctx) == uni_common_lrumap_length(&reference.ctx));
+        for (size_t idx = 0; idx < uni_common_lrumap_length(ctx); idx++) {
+            size_t key_a = 0, val_a = 0, key_b = 0, val_b = 0;
+            REQUIRE(uni_common_lrumap_get_idx(ctx, idx, &key_a, &val_a));
+            REQUIRE(uni_common_lrumap_get_idx(&reference.ctx, idx, &key_b, &val_b));
+            REQUIRE((key_a == key_b && val_a == val_b));
+            REQUIRE(*(size_t *)uni_common_lrumap_get(ctx, key_a) == val_a);
+        }
+    }
+}
+
 
 //
 // Tests
@@ -473,3 +588,235 @@ TEST_CASE("lrumap_displacement", "[lrumap]") {
     REQUIRE(uni_common_lrumap_get_idx(&_ctx, 2, &key, &val));
     REQUIRE((key == 1 && val == 333));
 }
+
+
+TEST_CASE("lrumap_index", "[lrumap]") {
+    SECTION("nullptr") { REQUIRE_FALSE(uni_common_lrumap_set_index(nullptr, nullptr)); }
+
+    SECTION("too-small") {
+        _lrumap_init();
+        uni_common_array_init(&_arr_index, (uint8_t *)_arr_index_buf, _capacity * sizeof(size_t), sizeof(size_t));
+        REQUIRE_FALSE(uni_common_lrumap_set_index(&_ctx, &_arr_index));
+    }
+
+    SECTION("rebuild") {
+        _lrumap_init();
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(uni_common_lrumap_update(&_ctx, idx * 3, &idx));
+        }
+
+        uni_common_array_init(&_arr_index, (uint8_t *)_arr_index_buf, sizeof(_arr_index_buf), sizeof(size_t));
+        REQUIRE(uni_common_lrumap_set_index(&_ctx, &_arr_index));
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(*(size_t *)uni_common_lrumap_get(&_ctx, idx * 3) == idx);
+        }
+        REQUIRE(uni_common_lrumap_get(&_ctx, 1) == nullptr);
+
+        REQUIRE(uni_common_lrumap_set_index(&_ctx, nullptr));
+        REQUIRE(*(size_t *)uni_common_lrumap_get(&_ctx, 3) == 1);
+    }
+
+    SECTION("eviction") {
+        REQUIRE(_lrumap_init_index());
+
+        for (size_t idx = 0; idx < _capacity * 3; idx++) {
+            REQUIRE(uni_common_lrumap_update(&_ctx, idx, &idx));
+        }
+        for (size_t idx = 0; idx < _capacity * 2; idx++) {
+            REQUIRE(uni_common_lrumap_get(&_ctx, idx) == nullptr);
+        }
+        for (size_t idx = _capacity * 2; idx < _capacity * 3; idx++) {
+            REQUIRE(*(size_t *)uni_common_lrumap_get(&_ctx, idx) == idx);
+        }
+
+        REQUIRE(uni_common_lrumap_clear(&_ctx));
+        REQUIRE(uni_common_lrumap_get(&_ctx, _capacity * 2) == nullptr);
+    }
+
+    SECTION("random") {
+        REQUIRE(_lrumap_init_index());
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+}
+
+
+TEST_CASE("lrumap_free_slots", "[lrumap]") {
+    SECTION("reuse") {
+        _lrumap_init();
+        REQUIRE(_ctx.slot_free == 0);
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(uni_common_lrumap_update(&_ctx, idx, &idx));
+            REQUIRE(_ctx.slot_last == idx);
+        }
+        REQUIRE(_ctx.slot_free == SIZE_MAX);
+
+        // removed slots are reused in LIFO order
+        REQUIRE(uni_common_lrumap_remove(&_ctx, 5));
+        REQUIRE(uni_common_lrumap_remove_first(&_ctx));
+        REQUIRE(_ctx.slot_free == 0);
+
+        size_t val = 100;
+        REQUIRE(uni_common_lrumap_update(&_ctx, val, &val));
+        REQUIRE(_ctx.slot_last == 0);
+        REQUIRE(uni_common_lrumap_update(&_ctx, val + 1, &val));
+        REQUIRE(_ctx.slot_last == 5);
+        REQUIRE(_ctx.slot_free == SIZE_MAX);
+        REQUIRE(uni_common_lrumap_length(&_ctx) == _capacity);
+    }
+
+    SECTION("clear") {
+        _lrumap_init();
+
+        size_t val = 0;
+        REQUIRE(uni_common_lrumap_update(&_ctx, 1, &val));
+        REQUIRE(uni_common_lrumap_update(&_ctx, 2, &val));
+        REQUIRE(uni_common_lrumap_clear(&_ctx));
+        REQUIRE(_ctx.slot_free == 0);
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(uni_common_lrumap_update(&_ctx, idx, &idx));
+        }
+        REQUIRE(uni_common_lrumap_length(&_ctx) == _capacity);
+    }
+
+    SECTION("random") {
+        _lrumap_init();
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+}
+
+
+TEST_CASE("lrumap_rank", "[lrumap]") {
+    SECTION("nullptr") { REQUIRE_FALSE(uni_common_lrumap_set_rank(nullptr, nullptr, nullptr, nullptr)); }
+
+    SECTION("too-small") {
+        REQUIRE_FALSE(_lrumap_init_rank(_capacity));
+        REQUIRE_FALSE(uni_common_lrumap_set_rank(&_ctx, &_arr_rank_tree, nullptr, &_arr_rank_stamps));
+    }
+
+    SECTION("rebuild") {
+        _lrumap_init();
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(uni_common_lrumap_update(&_ctx, idx, &idx));
+        }
+        REQUIRE(uni_common_lrumap_remove(&_ctx, 3));
+
+        uni_common_array_init(&_arr_rank_tree, (uint8_t *)_arr_rank_tree_buf, sizeof(_arr_rank_tree_buf), sizeof(size_t));
+        uni_common_array_init(&_arr_rank_slots, (uint8_t *)_arr_rank_slots_buf, sizeof(_arr_rank_slots_buf), sizeof(size_t));
+        uni_common_array_init(&_arr_rank_stamps, (uint8_t *)_arr_rank_stamps_buf, sizeof(_arr_rank_stamps_buf), sizeof(size_t));
+        REQUIRE(uni_common_lrumap_set_rank(&_ctx, &_arr_rank_tree, &_arr_rank_slots, &_arr_rank_stamps));
+
+        size_t key = 0;
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, 2, &key, nullptr));
+        REQUIRE(key == 2);
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, 3, &key, nullptr));
+        REQUIRE(key == 4);
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, _capacity - 2, &key, nullptr));
+        REQUIRE(key == _capacity - 1);
+        REQUIRE_FALSE(uni_common_lrumap_get_idx(&_ctx, _capacity - 1, &key, nullptr));
+
+        REQUIRE(uni_common_lrumap_set_rank(&_ctx, nullptr, nullptr, nullptr));
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, 3, &key, nullptr));
+        REQUIRE(key == 4);
+    }
+
+    SECTION("random") {
+        REQUIRE(_lrumap_init_rank(_capacity * 2));
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+
+    SECTION("random-renumber") {
+        // shortest rank tree, positions are renumbered on almost every update
+        REQUIRE(_lrumap_init_rank(_capacity + 1));
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+
+    SECTION("random-index") {
+        REQUIRE(_lrumap_init_rank(_capacity * 2));
+        uni_common_array_init(&_arr_index, (uint8_t *)_arr_index_buf, sizeof(_arr_index_buf), sizeof(size_t));
+        REQUIRE(uni_common_lrumap_set_index(&_ctx, &_arr_index));
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+
+    SECTION("detach-index") {
+        // detaching the key index must keep the rank tree
+        REQUIRE(_lrumap_init_rank(_capacity * 2));
+        uni_common_array_init(&_arr_index, (uint8_t *)_arr_index_buf, sizeof(_arr_index_buf), sizeof(size_t));
+        REQUIRE(uni_common_lrumap_set_index(&_ctx, &_arr_index));
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(uni_common_lrumap_update(&_ctx, idx, &idx));
+        }
+        REQUIRE(uni_common_lrumap_remove(&_ctx, 3));
+
+        REQUIRE(uni_common_lrumap_set_index(&_ctx, nullptr));
+        REQUIRE(_ctx.arr_index == nullptr);
+        REQUIRE(_ctx.arr_rank_tree == &_arr_rank_tree);
+
+        size_t key = 0;
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, 2, &key, nullptr));
+        REQUIRE(key == 2);
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, 3, &key, nullptr));
+        REQUIRE(key == 4);
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, _capacity - 2, &key, nullptr));
+        REQUIRE(key == _capacity - 1);
+        REQUIRE_FALSE(uni_common_lrumap_get_idx(&_ctx, _capacity - 1, &key, nullptr));
+
+        REQUIRE(uni_common_lrumap_clear(&_ctx));
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+}
+
+
+TEST_CASE("lrumap_compact", "[lrumap]") {
+    SECTION("nullptr") { REQUIRE_FALSE(uni_common_lrumap_init_compact(nullptr, nullptr, nullptr)); }
+
+    SECTION("ok") {
+        REQUIRE(_lrumap_init_compact());
+        REQUIRE(uni_common_lrumap_capacity(&_ctx) == _capacity);
+        REQUIRE(uni_common_lrumap_empty(&_ctx));
+
+        size_t key = 1;
+        size_t val = 11;
+        REQUIRE(uni_common_lrumap_update(&_ctx, key, &val));
+        key = 2;
+        val = 22;
+        REQUIRE(uni_common_lrumap_update(&_ctx, key, &val));
+        key = 1;
+        val = 111;
+        REQUIRE(uni_common_lrumap_update(&_ctx, key, &val));
+
+        REQUIRE(_ctx.slot_first == 1);
+        REQUIRE(_ctx.slot_last == 0);
+        REQUIRE(_arr_nodes_buf[1].link_prev == UINT32_MAX);
+        REQUIRE(_arr_nodes_buf[1].link_next == 0);
+        REQUIRE(_arr_nodes_buf[0].key == 1);
+
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, 0, &key, &val));
+        REQUIRE((key == 2 && val == 22));
+        REQUIRE(uni_common_lrumap_get_idx(&_ctx, 1, &key, &val));
+        REQUIRE((key == 1 && val == 111));
+
+        REQUIRE(uni_common_lrumap_remove_first(&_ctx));
+        REQUIRE(uni_common_lrumap_get(&_ctx, 2) == nullptr);
+        REQUIRE(uni_common_lrumap_length(&_ctx) == 1);
+    }
+
+    SECTION("random") {
+        REQUIRE(_lrumap_init_compact());
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+
+    SECTION("random-index-rank") {
+        REQUIRE(_lrumap_init_compact());
+
+        uni_common_array_init(&_arr_index, (uint8_t *)_arr_index_buf, sizeof(_arr_index_buf), sizeof(size_t));
+        uni_common_array_init(&_arr_rank_tree, (uint8_t *)_arr_rank_tree_buf, sizeof(_arr_rank_tree_buf), sizeof(size_t));
+        uni_common_array_init(&_arr_rank_slots, (uint8_t *)_arr_rank_slots_buf, sizeof(_arr_rank_slots_buf), sizeof(size_t));
+        uni_common_array_init(&_arr_rank_stamps, (uint8_t *)_arr_rank_stamps_buf, sizeof(_arr_rank_stamps_buf), sizeof(size_t));
+        REQUIRE(uni_common_lrumap_set_index(&_ctx, &_arr_index));
+        REQUIRE(uni_common_lrumap_set_rank(&_ctx, &_arr_rank_tree, &_arr_rank_slots, &_arr_rank_stamps));
+
+        _lrumap_compare_random(&_ctx, 5000);
+    }
+}
@@ -0,0 +1,217 @@
+//
+// Includes
+//
+
+// stdlib
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct lrumap_bench {
+        std::vector<size_t> link_prev;
+        std::vector<size_t> link_next;
+        std::vector<size_t> keys;
+        std::vector<size_t> vals;
+        std::vector<size_t> index;
+        std::vector<size_t> rank_tree;
+        std::vector<size_t> rank_slots;
+        std::vector<size_t> rank_stamps;
+        uni_common_array_t arr_link_prev{};
+        uni_common_array_t arr_link_next{};
+        uni_common_array_t arr_keys{};
+        uni_common_array_t arr_vals{};
+        uni_common_array_t arr_index{};
+        uni_common_array_t arr_rank_tree{};
+        uni_common_array_t arr_rank_slots{};
+        uni_common_array_t arr_rank_stamps{};
+        uni_common_lrumap_context_t ctx{};
+
+        lrumap_bench(size_t capacity, bool indexed)
+            : link_prev(capacity), link_next(capacity), keys(capacity), vals(capacity), index(capacity * 2) {
+            uni_common_array_init(&arr_link_prev, (uint8_t *)link_prev.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&arr_link_next, (uint8_t *)link_next.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&arr_keys, (uint8_t *)keys.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&arr_vals, (uint8_t *)vals.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&arr_index, (uint8_t *)index.data(), index.size() * sizeof(size_t), sizeof(size_t));
+            uni_common_lrumap_init(&ctx, &arr_link_prev, &arr_link_next, &arr_keys, &arr_vals);
+            if (indexed) {
+                uni_common_lrumap_set_index(&ctx, &arr_index);
+            }
+        }
+
+        void rank() {
+            size_t capacity = uni_common_lrumap_capacity(&ctx);
+            rank_tree.resize(capacity * 2);
+            rank_slots.resize(capacity * 2);
+            rank_stamps.resize(capacity);
+            uni_common_array_init(&arr_rank_tree, (uint8_t *)rank_tree.data(), rank_tree.size() * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&arr_rank_slots, (uint8_t *)rank_slots.data(), rank_slots.size() * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&arr_rank_stamps, (uint8_t *)rank_stamps.data(), rank_stamps.size() * sizeof(size_t), sizeof(size_t));
+            uni_common_lrumap_set_rank(&ctx, &arr_rank_tree, &arr_rank_slots, &arr_rank_stamps);
+        }
+
+        void fill(size_t count) {
+            for (size_t idx = 0; idx < count; idx++) {
+                uni_common_lrumap_update(&ctx, idx, &idx);
+            }
+        }
+    };
+
+    std::string lrumap_bench_name(const char *op, bool indexed, size_t capacity) {
+        return std::string(op) + (indexed ? "/index/" : "/scan/") + std::to_string(capacity);
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("lrumap_bench_get", "[.][benchmark][lrumap]") {
+    for (size_t capacity : {1000U, 10000U, 100000U}) {
+        for (bool indexed : {false, true}) {
+            if (!indexed && capacity > 10000U) {
+                continue;
+            }
+
+            lrumap_bench bench(capacity, indexed);
+            bench.fill(capacity);
+
+            size_t key = 0;
+            BENCHMARK(lrumap_bench_name("get", indexed, capacity)) {
+                key = key + 1 == capacity ? 0 : key + 1;
+                return uni_common_lrumap_get(&bench.ctx, key);
+            };
+
+            BENCHMARK(lrumap_bench_name("refresh", indexed, capacity)) {
+                key = key + 1 == capacity ? 0 : key + 1;
+                return uni_common_lrumap_update(&bench.ctx, key, &key);
+            };
+        }
+    }
+}
+
+
+TEST_CASE("lrumap_bench_churn", "[.][benchmark][lrumap]") {
+    for (size_t capacity : {1000U, 100000U}) {
+        lrumap_bench bench(capacity, true);
+        bench.fill(capacity);
+
+        // full map, every update of the new key evicts the oldest one
+        size_t key = capacity;
+        BENCHMARK(lrumap_bench_name("evict", true, capacity)) {
+            key++;
+            return uni_common_lrumap_update(&bench.ctx, key, &key);
+        };
+
+        // half-full map, slots are recycled through the free list
+        uni_common_lrumap_clear(&bench.ctx);
+        bench.fill(capacity / 2);
+        key = 0;
+        BENCHMARK(lrumap_bench_name("remove-insert", true, capacity)) {
+            uni_common_lrumap_remove(&bench.ctx, key);
+            size_t key_new = key + capacity / 2;
+            key++;
+            return uni_common_lrumap_update(&bench.ctx, key_new, &key_new);
+        };
+    }
+}
+
+
+TEST_CASE("lrumap_bench_position", "[.][benchmark][lrumap]") {
+    for (size_t capacity : {1000U, 10000U, 100000U}) {
+        for (bool ranked : {false, true}) {
+            lrumap_bench bench(capacity, true);
+            if (ranked) {
+                bench.rank();
+            }
+            bench.fill(capacity);
+
+            const char *mode = ranked ? "/rank/" : "/walk/";
+            BENCHMARK(std::string("length") + mode + std::to_string(capacity)) {
+                return uni_common_lrumap_length(&bench.ctx);
+            };
+
+            size_t idx = 0;
+            size_t key = 0;
+            BENCHMARK(std::string("get_idx") + mode + std::to_string(capacity)) {
+                idx = (idx + 7919U) % capacity;
+                return uni_common_lrumap_get_idx(&bench.ctx, idx, &key, nullptr);
+            };
+
+            BENCHMARK(std::string("refresh") + mode + std::to_string(capacity)) {
+                key = key + 1 == capacity ? 0 : key + 1;
+                return uni_common_lrumap_update(&bench.ctx, key, &key);
+            };
+        }
+    }
+}
+
+
+TEST_CASE("lrumap_bench_layout", "[.][benchmark][lrumap]") {
+    for (size_t capacity : {1000U, 100000U, 1000000U}) {
+        // separate link/key arrays
+        {
+            lrumap_bench bench(capacity, true);
+            bench.fill(capacity);
+
+            size_t key = capacity;
+            BENCHMARK("evict/separate/" + std::to_string(capacity)) {
+                key++;
+                return uni_common_lrumap_update(&bench.ctx, key, &key);
+            };
+
+            size_t seed = 1;
+            BENCHMARK("refresh-random/separate/" + std::to_string(capacity)) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                size_t key_refresh = key - (seed >> 33) % capacity;
+                return uni_common_lrumap_update(&bench.ctx, key_refresh, &key_refresh);
+            };
+        }
+
+        // compact nodes
+        {
+            std::vector<uni_common_lrumap_node_t> nodes(capacity);
+            std::vector<size_t> vals(capacity);
+            std::vector<size_t> index(capacity * 2);
+            uni_common_array_t arr_nodes{}, arr_vals{}, arr_index{};
+            uni_common_array_init(&arr_nodes, (uint8_t *)nodes.data(), capacity * sizeof(uni_common_lrumap_node_t), sizeof(uni_common_lrumap_node_t));
+            uni_common_array_init(&arr_vals, (uint8_t *)vals.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&arr_index, (uint8_t *)index.data(), index.size() * sizeof(size_t), sizeof(size_t));
+
+            uni_common_lrumap_context_t ctx{};
+            uni_common_lrumap_init_compact(&ctx, &arr_nodes, &arr_vals);
+            uni_common_lrumap_set_index(&ctx, &arr_index);
+            for (size_t idx = 0; idx < capacity; idx++) {
+                uni_common_lrumap_update(&ctx, idx, &idx);
+            }
+
+            size_t key = capacity;
+            BENCHMARK("evict/compact/" + std::to_string(capacity)) {
+                key++;
+                return uni_common_lrumap_update(&ctx, key, &key);
+            };
+
+            size_t seed = 1;
+            BENCHMARK("refresh-random/compact/" + std::to_string(capacity)) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                size_t key_refresh = key - (seed >> 33) % capacity;
+                return uni_common_lrumap_update(&ctx, key_refresh, &key_refresh);
+            };
+        }
+    }
+}
@@ -3,6 +3,9 @@
 //
 
 #include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -23,6 +26,9 @@ static size_t _arr_keys_buf[_capacity];
 static uni_common_array_t _arr_vals{};
 static size_t _arr_vals_buf[_capacity];
 
+static uni_common_array_t _arr_ctrl{};
+static uint8_t _arr_ctrl_buf[_capacity];
+
 
 //
 // Private
@@ -48,6 +54,51 @@ bool _map_init() {
     return result;
 }
 
+bool _map_init_hash() {
+    memset(&_ctx, 0, sizeof(_ctx));
+
+    memset(_arr_keys_buf, 0, sizeof(_arr_keys_buf));
+    memset(_arr_vals_buf, 0, sizeof(_arr_vals_buf));
+
+    uni_common_array_init(&_arr_keys, (uint8_t *)_arr_keys_buf, sizeof(_arr_keys_buf), sizeof(size_t));
+    uni_common_array_init(&_arr_vals, (uint8_t *)_arr_vals_buf, sizeof(_arr_vals_buf), sizeof(size_t));
+
+    uni_common_map_config_t config{};
+    config.keys = &_arr_keys;
+    config.vals = &_arr_vals;
+    config.mode = UNI_COMMON_MAP_MODE_HASH;
+
+    bool result = uni_common_map_init_ex(&_ctx, &config);
+
+    REQUIRE(uni_common_map_initialized(&_ctx));
+
+    return result;
+}
+
+bool _map_init_swiss() {
+    memset(&_ctx, 0, sizeof(_ctx));
+
+    memset(_arr_keys_buf, 0, sizeof(_arr_keys_buf));
+    memset(_arr_vals_buf, 0, sizeof(_arr_vals_buf));
+    memset(_arr_ctrl_buf, 0, sizeof(_arr_ctrl_buf));
+
+    uni_common_array_init(&_arr_keys, (uint8_t *)_arr_keys_buf, sizeof(_arr_keys_buf), sizeof(size_t));
+    uni_common_array_init(&_arr_vals, (uint8_t *)_arr_vals_buf, sizeof(_arr_vals_buf), sizeof(size_t));
+    uni_common_array_init(&_arr_ctrl, _arr_ctrl_buf, sizeof(_arr_ctrl_buf), 1);
+
+    uni_common_map_config_t config{};
+    config.keys = &_arr_keys;
+    config.vals = &_arr_vals;
+    config.ctrl = &_arr_ctrl;
+    config.mode = UNI_COMMON_MAP_MODE_SWISS;
+
+    bool result = uni_common_map_init_ex(&_ctx, &config);
+
+    REQUIRE(uni_common_map_initialized(&_ctx));
+
+    return result;
+}
+
 
 //
 // Tests
@@ -295,3 +346,485 @@ TEST_CASE("map_clear", "[map]") {
         REQUIRE(uni_common_map_size(&_ctx) == 0);
     }
 }
+
+
+TEST_CASE("map_hash", "[map]") {
+    SECTION("nullptr") {
+        REQUIRE_FALSE(uni_common_map_init_ex(nullptr, nullptr));
+        REQUIRE_FALSE(uni_common_map_init_ex(&_ctx, nullptr));
+    }
+
+    SECTION("set-get") {
+        REQUIRE(_map_init_hash());
+        REQUIRE(uni_common_map_capacity(&_ctx) == _capacity);
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            size_t val = idx * 10;
+            REQUIRE(uni_common_map_set(&_ctx, idx * 7, &val));
+            REQUIRE(uni_common_map_size(&_ctx) == idx + 1);
+        }
+
+        size_t val = 100;
+        REQUIRE_FALSE(uni_common_map_set(&_ctx, 1000, &val));
+        REQUIRE(uni_common_map_get(&_ctx, 1000) == nullptr);
+        REQUIRE_FALSE(uni_common_map_set(&_ctx, SIZE_MAX, &val));
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(*(size_t *)uni_common_map_get(&_ctx, idx * 7) == idx * 10);
+        }
+    }
+
+    SECTION("remove") {
+        REQUIRE(_map_init_hash());
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(uni_common_map_set(&_ctx, idx, &idx));
+        }
+
+        for (size_t idx = 0; idx < _capacity; idx += 2) {
+            REQUIRE(uni_common_map_remove(&_ctx, idx));
+            REQUIRE_FALSE(uni_common_map_remove(&_ctx, idx));
+        }
+        REQUIRE(uni_common_map_size(&_ctx) == _capacity / 2);
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            if (idx % 2 == 0) {
+                REQUIRE(uni_common_map_get(&_ctx, idx) == nullptr);
+            } else {
+                REQUIRE(*(size_t *)uni_common_map_get(&_ctx, idx) == idx);
+            }
+        }
+    }
+
+    SECTION("clear") {
+        REQUIRE(_map_init_hash());
+
+        size_t val = 1;
+        REQUIRE(uni_common_map_set(&_ctx, 1, &val));
+        REQUIRE(uni_common_map_clear(&_ctx));
+        REQUIRE(uni_common_map_size(&_ctx) == 0);
+        REQUIRE(uni_common_map_capacity(&_ctx) == _capacity);
+        REQUIRE(uni_common_map_get(&_ctx, 1) == nullptr);
+        REQUIRE(uni_common_map_set(&_ctx, 1, &val));
+    }
+
+    SECTION("random") {
+        REQUIRE(_map_init_hash());
+
+        std::unordered_map<size_t, size_t> reference;
+        std::mt19937_64 rng(42);
+        for (size_t iter = 0; iter < 20000; iter++) {
+            size_t key = rng() % (_capacity * 2);
+            size_t val = rng();
+            if (rng() % 3 == 0) {
+                REQUIRE(uni_common_map_remove(&_ctx, key) == (reference.erase(key) == 1));
+            } else {
+                bool fits = reference.count(key) == 1 || reference.size() < _capacity;
+                REQUIRE(uni_common_map_set(&_ctx, key, &val) == fits);
+                if (fits) {
+                    reference[key] = val;
+                }
+            }
+
+            REQUIRE(uni_common_map_size(&_ctx) == reference.size());
+            for (const auto &[ref_key, ref_val] : reference) {
+                REQUIRE(*(size_t *)uni_common_map_get(&_ctx, ref_key) == ref_val);
+            }
+        }
+    }
+}
+
+
+TEST_CASE("map_swiss", "[map]") {
+    SECTION("init") {
+        uni_common_array_init(&_arr_keys, (uint8_t *)_arr_keys_buf, sizeof(_arr_keys_buf), sizeof(size_t));
+        uni_common_array_init(&_arr_vals, (uint8_t *)_arr_vals_buf, sizeof(_arr_vals_buf), sizeof(size_t));
+
+        uni_common_map_config_t config{};
+        config.keys = &_arr_keys;
+        config.vals = &_arr_vals;
+        config.mode = UNI_COMMON_MAP_MODE_SWISS;
+        REQUIRE_FALSE(uni_common_map_init_ex(&_ctx, &config));
+
+        // capacity is rounded down to the whole groups
+        uni_common_array_init(&_arr_ctrl, _arr_ctrl_buf, UNI_COMMON_MAP_SWISS_GROUP + 3, 1);
+        config.ctrl = &_arr_ctrl;
+        REQUIRE(uni_common_map_init_ex(&_ctx, &config));
+        REQUIRE(uni_common_map_capacity(&_ctx) == UNI_COMMON_MAP_SWISS_GROUP);
+
+        uni_common_array_init(&_arr_ctrl, _arr_ctrl_buf, UNI_COMMON_MAP_SWISS_GROUP - 1, 1);
+        uni_common_map_context_t ctx{};
+        REQUIRE_FALSE(uni_common_map_init_ex(&ctx, &config));
+    }
+
+    SECTION("set-get") {
+        REQUIRE(_map_init_swiss());
+        REQUIRE(uni_common_map_capacity(&_ctx) == _capacity);
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            size_t val = idx * 10;
+            REQUIRE(uni_common_map_set(&_ctx, idx * 7, &val));
+            REQUIRE(uni_common_map_size(&_ctx) == idx + 1);
+        }
+
+        size_t val = 100;
+        REQUIRE_FALSE(uni_common_map_set(&_ctx, 1000, &val));
+        REQUIRE(uni_common_map_get(&_ctx, 1000) == nullptr);
+        REQUIRE_FALSE(uni_common_map_set(&_ctx, SIZE_MAX, &val));
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(*(size_t *)uni_common_map_get(&_ctx, idx * 7) == idx * 10);
+        }
+    }
+
+    SECTION("remove") {
+        REQUIRE(_map_init_swiss());
+
+        // full table leaves tombstones behind, the keys must stay reachable past them
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            REQUIRE(uni_common_map_set(&_ctx, idx, &idx));
+        }
+
+        for (size_t idx = 0; idx < _capacity; idx += 2) {
+            REQUIRE(uni_common_map_remove(&_ctx, idx));
+            REQUIRE_FALSE(uni_common_map_remove(&_ctx, idx));
+        }
+        REQUIRE(uni_common_map_size(&_ctx) == _capacity / 2);
+
+        for (size_t idx = 0; idx < _capacity; idx++) {
+            if (idx % 2 == 0) {
+                REQUIRE(uni_common_map_get(&_ctx, idx) == nullptr);
+            } else {
+                REQUIRE(*(size_t *)uni_common_map_get(&_ctx, idx) == idx);
+            }
+        }
+
+        // tombstones are reused
+        for (size_t idx = 0; idx < _capacity; idx += 2) {
+            size_t key = idx + _capacity;
+            REQUIRE(uni_common_map_set(&_ctx, key, &key));
+        }
+        REQUIRE(uni_common_map_size(&_ctx) == _capacity);
+        for (size_t idx = 1; idx < _capacity; idx += 2) {
+            REQUIRE(*(size_t *)uni_common_map_get(&_ctx, idx) == idx);
+            REQUIRE(*(size_t *)uni_common_map_get(&_ctx, idx - 1 + _capacity) == idx - 1 + _capacity);
+        }
+    }
+
+    SECTION("clear") {
+        REQUIRE(_map_init_swiss());
+
+        size_t val = 1;
+        REQUIRE(uni_common_map_set(&_ctx, 1, &val));
+        REQUIRE(uni_common_map_remove(&_ctx, 1));
+        REQUIRE(uni_common_map_set(&_ctx, 2, &val));
+        REQUIRE(uni_common_map_clear(&_ctx));
+        REQUIRE(uni_common_map_size(&_ctx) == 0);
+        REQUIRE(uni_common_map_capacity(&_ctx) == _capacity);
+        REQUIRE(uni_common_map_get(&_ctx, 2) == nullptr);
+        REQUIRE(uni_common_map_set(&_ctx, 1, &val));
+        REQUIRE(*(size_t *)uni_common_map_get(&_ctx, 1) == val);
+    }
+
+    SECTION("random") {
+        REQUIRE(_map_init_swiss());
+
+        std::unordered_map<size_t, size_t> reference;
+        std::mt19937_64 rng(42);
+        for (size_t iter = 0; iter < 20000; iter++) {
+            size_t key = rng() % (_capacity * 2);
+            size_t val = rng();
+            if (rng() % 3 == 0) {
+                REQUIRE(uni_common_map_remove(&_ctx, key) == (reference.erase(key) == 1));
+            } else {
+                bool fits = reference.count(key) == 1 || reference.size() < _capacity;
+                REQUIRE(uni_common_map_set(&_ctx, key, &val) == fits);
+                if (fits) {
+                    reference[key] = val;
+                }
+            }
+
+            REQUIRE(uni_common_map_size(&_ctx) == reference.size());
+            for (const auto &[ref_key, ref_val] : reference) {
+                REQUIRE(*(size_t *)uni_common_map_get(&_ctx, ref_key) == ref_val);
+            }
+        }
+
+        size_t count = 0;
+        for (size_t idx = 0; idx < uni_common_map_capacity(&_ctx); idx++) {
+            count += _arr_keys_buf[idx] != SIZE_MAX;
+        }
+        REQUIRE(count == reference.size());
+    }
+}
+
+
+TEST_CASE("map_batch", "[map]") {
+    for (auto init : {_map_init, _map_init_hash, _map_init_swiss}) {
+        REQUIRE(init());
+
+        // more keys than one prefetch chunk, with a duplicate, a reserved key and keys which do not fit
+        size_t keys[40];
+        size_t vals[40];
+        for (size_t idx = 0; idx < 40; idx++) {
+            keys[idx] = idx * 3;
+            vals[idx] = idx + 100;
+        }
+        keys[5] = keys[2];
+        keys[7] = SIZE_MAX;
+
+        REQUIRE(uni_common_map_set_batch(nullptr, keys, 40, vals) == 0);
+        REQUIRE(uni_common_map_set_batch(&_ctx, nullptr, 40, vals) == 0);
+        REQUIRE(uni_common_map_set_batch(&_ctx, keys, 40, nullptr) == 0);
+
+        // 38 unique keys, 32 fit
+        REQUIRE(uni_common_map_set_batch(&_ctx, keys, 40, vals) == _capacity + 1);
+        REQUIRE(uni_common_map_size(&_ctx) == _capacity);
+        REQUIRE(*(size_t *)uni_common_map_get(&_ctx, keys[2]) == vals[5]);
+
+        uint8_t *found[40];
+        REQUIRE(uni_common_map_get_batch(&_ctx, keys, 40, nullptr) == 0);
+        REQUIRE(uni_common_map_get_batch(&_ctx, keys, 40, found) == _capacity + 1);
+        REQUIRE(found[7] == nullptr);
+        REQUIRE(found[39] == nullptr);
+        for (size_t idx = 0; idx < 40; idx++) {
+            REQUIRE(found[idx] == uni_common_map_get(&_ctx, keys[idx]));
+        }
+    }
+}
+
+
+TEST_CASE("map_occupancy", "[map]") {
+    constexpr size_t slots = 200;
+    static std::unordered_map<size_t, size_t> visited;
+
+    for (auto mode : {UNI_COMMON_MAP_MODE_LINEAR, UNI_COMMON_MAP_MODE_HASH, UNI_COMMON_MAP_MODE_SWISS}) {
+        std::vector<size_t> keys_buf(slots);
+        std::vector<size_t> vals_buf(slots);
+        std::vector<uint8_t> ctrl_buf(slots);
+        std::vector<uint64_t> occupancy_buf(UNI_COMMON_MAP_OCCUPANCY_WORDS(slots));
+        uni_common_array_t keys{}, vals{}, ctrl{}, occupancy{};
+        uni_common_array_init(&keys, (uint8_t *)keys_buf.data(), slots * sizeof(size_t), sizeof(size_t));
+        uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), slots * sizeof(size_t), sizeof(size_t));
+        uni_common_array_init(&ctrl, ctrl_buf.data(), slots, 1);
+
+        uni_common_map_config_t config{};
+        config.keys = &keys;
+        config.vals = &vals;
+        config.ctrl = &ctrl;
+        config.occupancy = &occupancy;
+        config.mode = mode;
+        uni_common_map_context_t ctx{};
+
+        // capacity is limited by the bitmap length
+        uni_common_array_init(&occupancy, (uint8_t *)occupancy_buf.data(), sizeof(uint64_t), sizeof(uint64_t));
+        REQUIRE(uni_common_map_init_ex(&ctx, &config));
+        REQUIRE(uni_common_map_capacity(&ctx) == 64);
+
+        uni_common_array_init(&occupancy, (uint8_t *)occupancy_buf.data(), occupancy_buf.size() * sizeof(uint64_t), sizeof(uint64_t));
+        REQUIRE(uni_common_map_init_ex(&ctx, &config));
+        size_t capacity = uni_common_map_capacity(&ctx);
+        REQUIRE(capacity == (mode == UNI_COMMON_MAP_MODE_SWISS ? 192 : slots));
+
+        std::unordered_map<size_t, size_t> reference;
+        std::mt19937_64 rng(7);
+        for (size_t iter = 0; iter < 5000; iter++) {
+            size_t key = rng() % (capacity * 2);
+            size_t val = rng();
+            if (rng() % 3 == 0) {
+                REQUIRE(uni_common_map_remove(&ctx, key) == (reference.erase(key) == 1));
+            } else if (reference.count(key) == 1 || reference.size() < capacity) {
+                REQUIRE(uni_common_map_set(&ctx, key, &val));
+                reference[key] = val;
+            }
+
+            if (iter % 50 == 0) {
+                for (size_t slot = 0; slot < capacity; slot++) {
+                    bool used = (occupancy_buf[slot / 64] >> (slot % 64) & 1U) != 0;
+                    REQUIRE(used == (keys_buf[slot] != SIZE_MAX));
+                }
+
+                visited.clear();
+                REQUIRE(uni_common_map_enum(&ctx, [](size_t key, const void *val) { visited[key] = *(const size_t *)val; }));
+                REQUIRE(visited == reference);
+            }
+        }
+
+        REQUIRE(uni_common_map_clear(&ctx));
+        visited.clear();
+        REQUIRE(uni_common_map_enum(&ctx, [](size_t key, const void *val) { visited[key] = *(const size_t *)val; }));
+        REQUIRE(visited.empty());
+    }
+}
+
+
+TEST_CASE("map_migrate", "[map]") {
+    struct table {
+        std::vector<size_t> keys_buf;
+        std::vector<size_t> vals_buf;
+        std::vector<uint8_t> ctrl_buf;
+        std::vector<uint64_t> occupancy_buf;
+        uni_common_array_t keys{}, vals{}, ctrl{}, occupancy{};
+        uni_common_map_config_t config{};
+        uni_common_map_context_t ctx{};
+
+        table(size_t capacity, uni_common_map_mode_t mode, bool bitmap)
+            : keys_buf(capacity), vals_buf(capacity), ctrl_buf(capacity), occupancy_buf(UNI_COMMON_MAP_OCCUPANCY_WORDS(capacity)) {
+            uni_common_array_init(&keys, (uint8_t *)keys_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&ctrl, ctrl_buf.data(), capacity, 1);
+            uni_common_array_init(&occupancy, (uint8_t *)occupancy_buf.data(), occupancy_buf.size() * sizeof(uint64_t), sizeof(uint64_t));
+            config.keys = &keys;
+            config.vals = &vals;
+            config.ctrl = &ctrl;
+            config.occupancy = bitmap ? &occupancy : nullptr;
+            config.mode = mode;
+            uni_common_map_init_ex(&ctx, &config);
+        }
+    };
+
+    static std::unordered_map<size_t, size_t> visited;
+    auto modes = {UNI_COMMON_MAP_MODE_LINEAR, UNI_COMMON_MAP_MODE_HASH, UNI_COMMON_MAP_MODE_SWISS};
+
+    SECTION("invalid") {
+        table table_old(32, UNI_COMMON_MAP_MODE_HASH, false);
+        table table_new(64, UNI_COMMON_MAP_MODE_HASH, false);
+        table table_small(16, UNI_COMMON_MAP_MODE_HASH, false);
+        uni_common_map_context_t ctx{};
+
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &table_new.ctx));
+        REQUIRE(uni_common_map_init_ex(&ctx, &table_old.config));
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, nullptr));
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &table_old.ctx));
+        REQUIRE_FALSE(uni_common_map_migrating(&ctx));
+
+        for (size_t key = 0; key < 20; key++) {
+            REQUIRE(uni_common_map_set(&ctx, key, &key));
+        }
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &table_small.ctx));
+
+        // new table must be empty
+        size_t val = 1;
+        REQUIRE(uni_common_map_set(&table_new.ctx, 1, &val));
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &table_new.ctx));
+        REQUIRE(uni_common_map_clear(&table_new.ctx));
+
+        uni_common_array_set_itemsize(&table_new.vals, sizeof(uint32_t));
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &table_new.ctx));
+        uni_common_array_set_itemsize(&table_new.vals, sizeof(size_t));
+
+        // arrays of the new table must not overlap with any array of the current one
+        uni_common_array_t arr_overlap{};
+        uni_common_array_init(&arr_overlap, (uint8_t *)&table_old.keys_buf[16], 16 * sizeof(size_t), sizeof(size_t));
+        uni_common_map_context_t ctx_overlap = table_new.ctx;
+        ctx_overlap.config.keys = &arr_overlap;
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &ctx_overlap));
+        ctx_overlap.config.keys = table_new.ctx.config.keys;
+        ctx_overlap.config.vals = &arr_overlap;
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &ctx_overlap));
+
+        REQUIRE(uni_common_map_migrate(&ctx, &table_new.ctx));
+        REQUIRE(uni_common_map_migrating(&ctx));
+        REQUIRE_FALSE(uni_common_map_migrate(&ctx, &table_small.ctx));
+
+        // clear drops the old table
+        REQUIRE(uni_common_map_clear(&ctx));
+        REQUIRE_FALSE(uni_common_map_migrating(&ctx));
+        REQUIRE(uni_common_map_size(&ctx) == 0);
+        REQUIRE(uni_common_map_capacity(&ctx) == 64);
+    }
+
+    SECTION("modes") {
+        for (auto mode_old : modes) {
+            for (auto mode_new : modes) {
+                table table_old(64, mode_old, mode_old == UNI_COMMON_MAP_MODE_HASH);
+                table table_new(256, mode_new, mode_new != UNI_COMMON_MAP_MODE_HASH);
+                uni_common_map_context_t ctx{};
+                REQUIRE(uni_common_map_init_ex(&ctx, &table_old.config));
+
+                std::unordered_map<size_t, size_t> reference;
+                std::mt19937_64 rng(5);
+                for (size_t key = 0; key < 64; key++) {
+                    size_t val = rng();
+                    REQUIRE(uni_common_map_set(&ctx, key * 7, &val));
+                    reference[key * 7] = val;
+                }
+
+                // old table is full, so every slot is visited
+                REQUIRE(uni_common_map_migrate(&ctx, &table_new.ctx));
+                REQUIRE(uni_common_map_capacity(&ctx) == 256);
+                REQUIRE(ctx.migration.cursor <= UNI_COMMON_MAP_MIGRATE_STEP);
+
+                size_t ops = 0;
+                while (uni_common_map_migrating(&ctx)) {
+                    size_t key = rng() % 600;
+                    size_t val = rng();
+                    size_t cursor = ctx.migration.cursor;
+                    if (rng() % 3 == 0) {
+                        REQUIRE(uni_common_map_remove(&ctx, key) == (reference.erase(key) == 1));
+                    } else {
+                        bool fits = reference.count(key) == 1 || reference.size() < 256;
+                        REQUIRE(uni_common_map_set(&ctx, key, &val) == fits);
+                        if (fits) {
+                            reference[key] = val;
+                        }
+                    }
+                    REQUIRE(ctx.migration.cursor - cursor <= UNI_COMMON_MAP_MIGRATE_STEP);
+                    ops++;
+
+                    REQUIRE(uni_common_map_size(&ctx) == reference.size());
+                    for (const auto &[ref_key, ref_val] : reference) {
+                        REQUIRE(*(size_t *)uni_common_map_get(&ctx, ref_key) == ref_val);
+                    }
+
+                    visited.clear();
+                    REQUIRE(uni_common_map_enum(&ctx, [](size_t key, const void *val) { visited[key] = *(const size_t *)val; }));
+                    REQUIRE(visited == reference);
+
+                    std::vector<size_t> keys;
+                    for (const auto &[ref_key, ref_val] : reference) {
+                        keys.push_back(ref_key);
+                    }
+                    keys.push_back(1000);
+                    std::vector<uint8_t *> found(keys.size());
+                    REQUIRE(uni_common_map_get_batch(&ctx, keys.data(), keys.size(), found.data()) == reference.size());
+                }
+                REQUIRE(ops <= 64);
+                REQUIRE(ctx.migration.state.size == 0);
+
+                for (const auto &[ref_key, ref_val] : reference) {
+                    REQUIRE(*(size_t *)uni_common_map_get(&ctx, ref_key) == ref_val);
+                }
+
+                // old arrays are not used anymore
+                std::fill(table_old.keys_buf.begin(), table_old.keys_buf.end(), 0);
+                REQUIRE(uni_common_map_size(&ctx) == reference.size());
+                for (const auto &[ref_key, ref_val] : reference) {
+                    REQUIRE(*(size_t *)uni_common_map_get(&ctx, ref_key) == ref_val);
+                }
+            }
+        }
+    }
+
+    SECTION("step") {
+        table table_old(1024, UNI_COMMON_MAP_MODE_HASH, false);
+        table table_new(4096, UNI_COMMON_MAP_MODE_SWISS, false);
+        uni_common_map_context_t ctx{};
+        REQUIRE(uni_common_map_init_ex(&ctx, &table_old.config));
+        for (size_t key = 0; key < 900; key++) {
+            REQUIRE(uni_common_map_set(&ctx, key, &key));
+        }
+
+        REQUIRE(uni_common_map_migrate(&ctx, &table_new.ctx));
+        size_t moved = 0;
+        while (uni_common_map_migrating(&ctx)) {
+            moved += uni_common_map_migrate_step(&ctx, 100);
+        }
+        REQUIRE(moved <= 900);
+        REQUIRE(uni_common_map_size(&ctx) == 900);
+        REQUIRE(uni_common_map_migrate_step(&ctx, 100) == 0);
+        for (size_t key = 0; key < 900; key++) {
+            REQUIRE(*(size_t *)uni_common_map_get(&ctx, key) == key);
+        }
+    }
+}
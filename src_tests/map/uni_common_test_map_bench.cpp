@@ -0,0 +1,319 @@
+//
+// Includes
+//
+
+// stdlib
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct map_bench {
+        std::vector<size_t> keys_buf;
+        std::vector<size_t> vals_buf;
+        std::vector<uint8_t> ctrl_buf;
+        uni_common_array_t keys{};
+        uni_common_array_t vals{};
+        uni_common_array_t ctrl{};
+        uni_common_map_context_t ctx{};
+
+        map_bench(size_t capacity, uni_common_map_mode_t mode) : keys_buf(capacity), vals_buf(capacity), ctrl_buf(capacity) {
+            uni_common_array_init(&keys, (uint8_t *)keys_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&ctrl, ctrl_buf.data(), capacity, 1);
+
+            uni_common_map_config_t config{};
+            config.keys = &keys;
+            config.vals = &vals;
+            config.ctrl = &ctrl;
+            config.mode = mode;
+            uni_common_map_init_ex(&ctx, &config);
+        }
+    };
+
+
+    /**
+     * Fills map to 75% and measures lookups of the present keys
+     */
+    void map_bench_get(size_t capacity, uni_common_map_mode_t mode, const char *mode_name) {
+        map_bench bench(capacity, mode);
+
+        size_t count = capacity * 3 / 4;
+        for (size_t idx = 0; idx < count; idx++) {
+            size_t key = idx * 2654435761U;
+            uni_common_map_set(&bench.ctx, key, &idx);
+        }
+
+        size_t idx = 0;
+        BENCHMARK(std::string("get/") + mode_name + "/" + std::to_string(capacity)) {
+            idx = idx + 1 == count ? 0 : idx + 1;
+            return uni_common_map_get(&bench.ctx, idx * 2654435761U);
+        };
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("map_bench_get", "[.][benchmark][map]") {
+    // linear scan wins only on the tiny maps, the crossover is where hash row becomes faster
+    for (size_t capacity : {4U, 8U, 16U, 32U, 64U, 128U, 1024U, 4096U}) {
+        map_bench_get(capacity, UNI_COMMON_MAP_MODE_LINEAR, "linear");
+        map_bench_get(capacity, UNI_COMMON_MAP_MODE_HASH, "hash");
+    }
+
+    map_bench_get(65536U, UNI_COMMON_MAP_MODE_HASH, "hash");
+}
+
+
+TEST_CASE("map_bench_churn", "[.][benchmark][map]") {
+    for (size_t capacity : {16U, 256U, 4096U}) {
+        for (auto mode : {UNI_COMMON_MAP_MODE_LINEAR, UNI_COMMON_MAP_MODE_HASH}) {
+            map_bench bench(capacity, mode);
+
+            size_t count = capacity / 2;
+            for (size_t idx = 0; idx < count; idx++) {
+                uni_common_map_set(&bench.ctx, idx, &idx);
+            }
+
+            size_t key = count;
+            BENCHMARK(std::string("set-remove/") + (mode == UNI_COMMON_MAP_MODE_HASH ? "hash/" : "linear/") +
+                      std::to_string(capacity)) {
+                uni_common_map_remove(&bench.ctx, key - count);
+                uni_common_map_set(&bench.ctx, key, &key);
+                key++;
+            };
+        }
+    }
+}
+
+
+TEST_CASE("map_bench_batch", "[.][benchmark][map]") {
+    // 64K fits into the cache, 16M (256 MiB of keys and values) does not
+    for (size_t capacity : {65536U, 16777216U}) {
+        map_bench bench(capacity, UNI_COMMON_MAP_MODE_HASH);
+
+        size_t count = capacity * 3 / 4;
+        for (size_t idx = 0; idx < count; idx++) {
+            size_t key = idx * 2654435761U;
+            uni_common_map_set(&bench.ctx, key, &idx);
+        }
+
+        for (size_t batch : {32U, 256U}) {
+            std::vector<size_t> keys(batch);
+            std::vector<uint8_t *> vals(batch);
+            uint64_t seed = 1;
+
+            auto next_keys = [&]() {
+                for (auto &key : keys) {
+                    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                    key = ((seed >> 33) % count) * 2654435761U;
+                }
+            };
+
+            // ns/key is the reported time divided by the batch size
+            BENCHMARK(std::string("get-scalar/") + std::to_string(capacity) + "/" + std::to_string(batch)) {
+                next_keys();
+                for (size_t idx = 0; idx < batch; idx++) {
+                    vals[idx] = uni_common_map_get(&bench.ctx, keys[idx]);
+                }
+                return vals[batch - 1];
+            };
+
+            BENCHMARK(std::string("get-batch/") + std::to_string(capacity) + "/" + std::to_string(batch)) {
+                next_keys();
+                return uni_common_map_get_batch(&bench.ctx, keys.data(), batch, vals.data());
+            };
+
+            std::vector<size_t> vals_set(batch);
+            BENCHMARK(std::string("set-scalar/") + std::to_string(capacity) + "/" + std::to_string(batch)) {
+                next_keys();
+                for (size_t idx = 0; idx < batch; idx++) {
+                    uni_common_map_set(&bench.ctx, keys[idx], &vals_set[idx]);
+                }
+            };
+
+            BENCHMARK(std::string("set-batch/") + std::to_string(capacity) + "/" + std::to_string(batch)) {
+                next_keys();
+                return uni_common_map_set_batch(&bench.ctx, keys.data(), batch, vals_set.data());
+            };
+        }
+    }
+}
+
+
+TEST_CASE("map_bench_swiss", "[.][benchmark][map]") {
+    // 7/8 load is where the linear probe chains of the hash mode grow long
+    for (size_t capacity : {4096U, 65536U, 4194304U}) {
+        for (auto mode : {UNI_COMMON_MAP_MODE_HASH, UNI_COMMON_MAP_MODE_SWISS}) {
+            map_bench bench(capacity, mode);
+            const char *mode_name = mode == UNI_COMMON_MAP_MODE_SWISS ? "swiss/" : "hash/";
+
+            size_t count = capacity * 7 / 8;
+            for (size_t idx = 0; idx < count; idx++) {
+                size_t key = idx * 2654435761U;
+                uni_common_map_set(&bench.ctx, key, &idx);
+            }
+
+            uint64_t seed = 1;
+            BENCHMARK(std::string("get-hit/") + mode_name + std::to_string(capacity)) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                return uni_common_map_get(&bench.ctx, ((seed >> 33) % count) * 2654435761U);
+            };
+
+            BENCHMARK(std::string("get-miss/") + mode_name + std::to_string(capacity)) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                return uni_common_map_get(&bench.ctx, ((seed >> 33) % count) * 2654435761U + 1U);
+            };
+
+            size_t key = count;
+            BENCHMARK(std::string("set-remove/") + mode_name + std::to_string(capacity)) {
+                uni_common_map_remove(&bench.ctx, (key - count) * 2654435761U);
+                size_t key_new = key * 2654435761U;
+                key++;
+                return uni_common_map_set(&bench.ctx, key_new, &key_new);
+            };
+        }
+    }
+}
+
+
+TEST_CASE("map_bench_enum", "[.][benchmark][map]") {
+    // sparse map, the scan reads every key while the bitmap skips 64 empty slots per word
+    for (size_t capacity : {65536U, 1048576U}) {
+        for (bool bitmap : {false, true}) {
+            std::vector<size_t> keys_buf(capacity);
+            std::vector<size_t> vals_buf(capacity);
+            std::vector<uint64_t> occupancy_buf(UNI_COMMON_MAP_OCCUPANCY_WORDS(capacity));
+            uni_common_array_t keys{}, vals{}, occupancy{};
+            uni_common_array_init(&keys, (uint8_t *)keys_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&occupancy, (uint8_t *)occupancy_buf.data(), occupancy_buf.size() * sizeof(uint64_t), sizeof(uint64_t));
+
+            uni_common_map_config_t config{};
+            config.keys = &keys;
+            config.vals = &vals;
+            config.occupancy = bitmap ? &occupancy : nullptr;
+            config.mode = UNI_COMMON_MAP_MODE_HASH;
+            uni_common_map_context_t ctx{};
+            uni_common_map_init_ex(&ctx, &config);
+
+            for (size_t idx = 0; idx < 1000; idx++) {
+                uni_common_map_set(&ctx, idx * 2654435761U, &idx);
+            }
+
+            static size_t sum;
+            BENCHMARK(std::string("enum-1000/") + (bitmap ? "bitmap/" : "scan/") + std::to_string(capacity)) {
+                sum = 0;
+                uni_common_map_enum(&ctx, [](size_t key, const void *) { sum += key; });
+                return sum;
+            };
+        }
+    }
+
+    // linear mode takes the first empty slot on every insert
+    for (size_t capacity : {1024U, 4096U}) {
+        for (bool bitmap : {false, true}) {
+            std::vector<size_t> keys_buf(capacity);
+            std::vector<size_t> vals_buf(capacity);
+            std::vector<uint64_t> occupancy_buf(UNI_COMMON_MAP_OCCUPANCY_WORDS(capacity));
+            uni_common_array_t keys{}, vals{}, occupancy{};
+            uni_common_array_init(&keys, (uint8_t *)keys_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&occupancy, (uint8_t *)occupancy_buf.data(), occupancy_buf.size() * sizeof(uint64_t), sizeof(uint64_t));
+
+            uni_common_map_config_t config{};
+            config.keys = &keys;
+            config.vals = &vals;
+            config.occupancy = bitmap ? &occupancy : nullptr;
+            config.mode = UNI_COMMON_MAP_MODE_LINEAR;
+            uni_common_map_context_t ctx{};
+            uni_common_map_init_ex(&ctx, &config);
+
+            // the freed slot is near the end, so the scan walks almost the whole keys array
+            for (size_t idx = 0; idx < capacity; idx++) {
+                uni_common_map_set(&ctx, idx, &idx);
+            }
+
+            size_t key = capacity;
+            BENCHMARK(std::string("remove-insert/linear/") + (bitmap ? "bitmap/" : "scan/") + std::to_string(capacity)) {
+                uni_common_map_remove(&ctx, key - 1U);
+                bool result = uni_common_map_set(&ctx, key, &key);
+                key++;
+                return result;
+            };
+        }
+    }
+}
+
+
+TEST_CASE("map_bench_migrate", "[.][benchmark][map]") {
+    // full 1M-slot table grows into 2M slots while the request path keeps inserting
+    size_t capacity = 1048576U;
+    size_t count_ops = 200000U;
+
+    auto now = []() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+    };
+
+    auto report = [](const char *name, std::vector<uint64_t> &lat) {
+        std::sort(lat.begin(), lat.end());
+        std::printf("%-12s p50 %9.3f us  p99 %9.3f us  p99.9 %9.3f us  max %9.3f us\n", name, lat[lat.size() / 2] / 1e3,
+                    lat[lat.size() * 99 / 100] / 1e3, lat[lat.size() * 999 / 1000] / 1e3, lat.back() / 1e3);
+    };
+
+    for (bool incremental : {false, true}) {
+        map_bench bench_old(capacity, UNI_COMMON_MAP_MODE_HASH);
+        map_bench bench_new(capacity * 2, UNI_COMMON_MAP_MODE_HASH);
+
+        size_t count = capacity * 7 / 8;
+        for (size_t idx = 0; idx < count; idx++) {
+            uni_common_map_set(&bench_old.ctx, idx, &idx);
+        }
+
+        std::vector<uint64_t> lat;
+        lat.reserve(count_ops);
+        uni_common_map_context_t *ctx = &bench_old.ctx;
+        for (size_t idx = 0; idx < count_ops; idx++) {
+            size_t key = count + idx;
+            uint64_t start = now();
+            if (idx == 0) {
+                if (incremental) {
+                    uni_common_map_migrate(ctx, &bench_new.ctx);
+                } else {
+                    // stop-the-world rebuild on the first insert
+                    ctx = &bench_new.ctx;
+                    for (size_t slot = 0; slot < capacity; slot++) {
+                        if (bench_old.keys_buf[slot] != SIZE_MAX) {
+                            uni_common_map_set(ctx, bench_old.keys_buf[slot], &bench_old.vals_buf[slot]);
+                        }
+                    }
+                }
+            }
+            uni_common_map_set(ctx, key, &key);
+            lat.push_back(now() - start);
+        }
+
+        report(incremental ? "incremental" : "rebuild", lat);
+    }
+}
@@ -0,0 +1,176 @@
+//
+// Includes
+//
+
+// stdlib
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct map_seqlock_value {
+        uint64_t lo;
+        uint64_t hi;
+    };
+
+    struct map_seqlock_table {
+        std::vector<size_t> keys_buf;
+        std::vector<map_seqlock_value> vals_buf;
+        std::vector<uint8_t> ctrl_buf;
+        uni_common_array_t keys{};
+        uni_common_array_t vals{};
+        uni_common_array_t ctrl{};
+        uni_common_map_config_t config{};
+        uni_common_map_seqlock_context_t ctx{};
+
+        map_seqlock_table(size_t capacity, uni_common_map_mode_t mode)
+            : keys_buf(capacity), vals_buf(capacity), ctrl_buf(capacity) {
+            uni_common_array_init(&keys, (uint8_t *)keys_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), capacity * sizeof(map_seqlock_value),
+                                  sizeof(map_seqlock_value));
+            uni_common_array_init(&ctrl, ctrl_buf.data(), capacity, 1U);
+            config.keys = &keys;
+            config.vals = &vals;
+            config.mode = mode;
+            config.ctrl = mode == UNI_COMMON_MAP_MODE_SWISS ? &ctrl : nullptr;
+        }
+    };
+}
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("map_seqlock_init", "[map_seqlock]") {
+    map_seqlock_table table(64U, UNI_COMMON_MAP_MODE_HASH);
+
+    REQUIRE_FALSE(uni_common_map_seqlock_init(nullptr, &table.config));
+    REQUIRE_FALSE(uni_common_map_seqlock_init(&table.ctx, nullptr));
+    REQUIRE_FALSE(uni_common_map_seqlock_initialized(&table.ctx));
+    REQUIRE_FALSE(uni_common_map_seqlock_get(&table.ctx, 1U, nullptr));
+    REQUIRE_FALSE(uni_common_map_seqlock_set(&table.ctx, 1U, &table.vals_buf[0]));
+
+    REQUIRE(uni_common_map_seqlock_init(&table.ctx, &table.config));
+    REQUIRE(uni_common_map_seqlock_initialized(&table.ctx));
+    REQUIRE(uni_common_map_seqlock_capacity(&table.ctx) == 64U);
+    REQUIRE(uni_common_map_seqlock_size(&table.ctx) == 0U);
+    REQUIRE(uni_common_map_seqlock_version(&table.ctx) == 0U);
+}
+
+
+TEST_CASE("map_seqlock_process", "[map_seqlock]") {
+    for (auto mode : {UNI_COMMON_MAP_MODE_LINEAR, UNI_COMMON_MAP_MODE_HASH, UNI_COMMON_MAP_MODE_SWISS}) {
+        map_seqlock_table table(64U, mode);
+        REQUIRE(uni_common_map_seqlock_init(&table.ctx, &table.config));
+
+        map_seqlock_value val{1U, 2U};
+        map_seqlock_value val_read{};
+        REQUIRE(uni_common_map_seqlock_set(&table.ctx, 10U, &val));
+        REQUIRE(uni_common_map_seqlock_get(&table.ctx, 10U, &val_read));
+        REQUIRE(val_read.lo == 1U);
+        REQUIRE(val_read.hi == 2U);
+        REQUIRE(uni_common_map_seqlock_get(&table.ctx, 10U, nullptr));
+        REQUIRE_FALSE(uni_common_map_seqlock_get(&table.ctx, 11U, &val_read));
+        REQUIRE(uni_common_map_seqlock_size(&table.ctx) == 1U);
+        REQUIRE(uni_common_map_seqlock_version(&table.ctx) == 1U);
+
+        size_t keys[3] = {20U, 21U, 22U};
+        map_seqlock_value vals[3] = {{20U, 0U}, {21U, 0U}, {22U, 0U}};
+        REQUIRE(uni_common_map_seqlock_set_batch(&table.ctx, keys, 3U, vals) == 3U);
+        REQUIRE(uni_common_map_seqlock_version(&table.ctx) == 2U);
+        REQUIRE(uni_common_map_seqlock_get(&table.ctx, 21U, &val_read));
+        REQUIRE(val_read.lo == 21U);
+
+        REQUIRE(uni_common_map_seqlock_remove(&table.ctx, 10U));
+        REQUIRE_FALSE(uni_common_map_seqlock_remove(&table.ctx, 10U));
+        REQUIRE_FALSE(uni_common_map_seqlock_get(&table.ctx, 10U, &val_read));
+        REQUIRE(uni_common_map_seqlock_size(&table.ctx) == 3U);
+
+        REQUIRE(uni_common_map_seqlock_clear(&table.ctx));
+        REQUIRE(uni_common_map_seqlock_size(&table.ctx) == 0U);
+        REQUIRE(uni_common_map_seqlock_version(&table.ctx) == 5U);
+    }
+}
+
+
+TEST_CASE("map_seqlock_threads", "[map_seqlock]") {
+    constexpr size_t readers = 3U;
+    constexpr size_t writers = 2U;
+    constexpr size_t keys = 256U;
+    constexpr uint64_t rounds = 20000U;
+
+    map_seqlock_table table(512U, UNI_COMMON_MAP_MODE_HASH);
+    REQUIRE(uni_common_map_seqlock_init(&table.ctx, &table.config));
+
+    // even keys are always present, odd keys are inserted and removed, so the probe sequences shift under readers
+    for (size_t key = 0; key < keys; key += 2U) {
+        map_seqlock_value val{key, ~(uint64_t)key};
+        REQUIRE(uni_common_map_seqlock_set(&table.ctx, key, &val));
+    }
+
+    // readers must never see torn values or miss the present keys
+    std::atomic<bool> done{false};
+    std::vector<uint8_t> consistent(readers, 1U);
+    std::vector<std::thread> threads;
+    for (size_t reader = 0; reader < readers; reader++) {
+        threads.emplace_back([&, reader]() {
+            size_t key = reader;
+            while (!done.load()) {
+                map_seqlock_value val{};
+                bool found = uni_common_map_seqlock_get(&table.ctx, key, &val);
+                if (key % 2U == 0U) {
+                    consistent[reader] = consistent[reader] && found;
+                }
+                if (found) {
+                    consistent[reader] = consistent[reader] && val.hi == ~val.lo && val.lo % keys == key;
+                }
+                key = (key + 1U) % keys;
+            }
+        });
+    }
+
+    // writers update disjoint keys
+    for (size_t writer = 0; writer < writers; writer++) {
+        threads.emplace_back([&, writer]() {
+            for (uint64_t round = 0; round < rounds; round++) {
+                size_t key = (round * writers + writer) % keys;
+                map_seqlock_value val{key + round * keys, ~(key + round * keys)};
+                if (key % 2U == 1U && round % 3U == 0U) {
+                    uni_common_map_seqlock_remove(&table.ctx, key);
+                } else {
+                    uni_common_map_seqlock_set(&table.ctx, key, &val);
+                }
+                if (round % 64U == 0U) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (size_t idx = readers; idx < threads.size(); idx++) {
+        threads[idx].join();
+    }
+    done.store(true);
+    for (size_t idx = 0; idx < readers; idx++) {
+        threads[idx].join();
+    }
+
+    for (size_t reader = 0; reader < readers; reader++) {
+        REQUIRE(consistent[reader]);
+    }
+    REQUIRE(uni_common_map_seqlock_version(&table.ctx) == keys / 2U + writers * rounds);
+}
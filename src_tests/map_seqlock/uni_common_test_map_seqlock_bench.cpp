@@ -0,0 +1,111 @@
+//
+// Includes
+//
+
+// stdlib
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct map_seqlock_bench {
+        std::vector<size_t> keys_buf;
+        std::vector<uint64_t> vals_buf;
+        uni_common_array_t keys{};
+        uni_common_array_t vals{};
+        uni_common_map_config_t config{};
+        uni_common_map_seqlock_context_t ctx{};
+        uni_common_map_context_t map{};
+
+        map_seqlock_bench(size_t capacity, size_t count) : keys_buf(capacity), vals_buf(capacity) {
+            uni_common_array_init(&keys, (uint8_t *)keys_buf.data(), capacity * sizeof(size_t), sizeof(size_t));
+            uni_common_array_init(&vals, (uint8_t *)vals_buf.data(), capacity * sizeof(uint64_t), sizeof(uint64_t));
+            config.keys = &keys;
+            config.vals = &vals;
+            config.mode = UNI_COMMON_MAP_MODE_HASH;
+            uni_common_map_seqlock_init(&ctx, &config);
+            for (size_t key = 0; key < count; key++) {
+                uint64_t val = key;
+                uni_common_map_seqlock_set(&ctx, key, &val);
+            }
+        }
+    };
+
+
+    /**
+     * Runs :threads readers which look up :reads keys each, returns the sum of the found values
+     */
+    template <typename Func>
+    uint64_t map_seqlock_bench_readers(size_t threads, size_t reads, size_t count, Func get) {
+        std::atomic<uint64_t> checksum{0};
+        std::vector<std::thread> workers;
+
+        for (size_t thread = 0; thread < threads; thread++) {
+            workers.emplace_back([&, thread]() {
+                uint64_t sum = 0;
+                uint64_t seed = thread + 1U;
+                for (size_t idx = 0; idx < reads; idx++) {
+                    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                    sum += get((seed >> 33) % count);
+                }
+                checksum += sum;
+            });
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        return checksum.load();
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("map_seqlock_bench_readers", "[.][benchmark][map_seqlock]") {
+    constexpr size_t count = 4096U;
+    constexpr size_t reads = 100000U;
+
+    map_seqlock_bench bench(8192U, count);
+
+    // the same (read-only) table guarded by the reader-writer lock
+    std::shared_mutex lock;
+    bench.map = bench.ctx.map;
+
+    for (size_t threads = 1U; threads <= 64U; threads *= 2U) {
+        BENCHMARK("get-100k/rwlock/threads-" + std::to_string(threads)) {
+            return map_seqlock_bench_readers(threads, reads, count, [&](size_t key) {
+                std::shared_lock<std::shared_mutex> guard(lock);
+                const uint8_t *val = uni_common_map_get(&bench.map, key);
+                return val != nullptr ? *(const uint64_t *)val : 0U;
+            });
+        };
+
+        BENCHMARK("get-100k/seqlock/threads-" + std::to_string(threads)) {
+            return map_seqlock_bench_readers(threads, reads, count, [&](size_t key) {
+                uint64_t val = 0;
+                uni_common_map_seqlock_get(&bench.ctx, key, &val);
+                return val;
+            });
+        };
+    }
+}
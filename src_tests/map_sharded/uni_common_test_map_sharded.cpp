@@ -0,0 +1,204 @@
+//
+// Includes
+//
+
+// stdlib
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct map_sharded_table {
+        std::vector<size_t> keys_buf;
+        std::vector<uint64_t> vals_buf;
+        std::vector<uni_common_array_t> keys;
+        std::vector<uni_common_array_t> vals;
+        std::vector<uni_common_map_config_t> configs;
+        std::vector<uni_common_map_shard_t> shards;
+        uni_common_map_sharded_context_t ctx{};
+
+        map_sharded_table(size_t shard_count, size_t shard_capacity)
+            : keys_buf(shard_count * shard_capacity), vals_buf(shard_count * shard_capacity), keys(shard_count),
+              vals(shard_count), configs(shard_count), shards(shard_count) {
+            for (size_t shard = 0; shard < shard_count; shard++) {
+                uni_common_array_init(&keys[shard], (uint8_t *)&keys_buf[shard * shard_capacity],
+                                      shard_capacity * sizeof(size_t), sizeof(size_t));
+                uni_common_array_init(&vals[shard], (uint8_t *)&vals_buf[shard * shard_capacity],
+                                      shard_capacity * sizeof(uint64_t), sizeof(uint64_t));
+                configs[shard].keys = &keys[shard];
+                configs[shard].vals = &vals[shard];
+                configs[shard].mode = UNI_COMMON_MAP_MODE_HASH;
+            }
+        }
+    };
+
+    std::atomic<uint64_t> map_sharded_enum_sum;
+    std::atomic<size_t> map_sharded_enum_count;
+
+    void map_sharded_enum_visit(size_t key, const void *val) {
+        map_sharded_enum_sum += key + *(const uint64_t *)val;
+        map_sharded_enum_count++;
+    }
+}
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("map_sharded_init", "[map_sharded]") {
+    map_sharded_table table(4U, 64U);
+
+    REQUIRE(alignof(uni_common_map_shard_t) == UNI_COMMON_COMPILER_CACHELINE);
+    REQUIRE_FALSE(uni_common_map_sharded_init(nullptr, table.shards.data(), table.configs.data(), 4U));
+    REQUIRE_FALSE(uni_common_map_sharded_init(&table.ctx, nullptr, table.configs.data(), 4U));
+    REQUIRE_FALSE(uni_common_map_sharded_init(&table.ctx, table.shards.data(), nullptr, 4U));
+    REQUIRE_FALSE(uni_common_map_sharded_init(&table.ctx, table.shards.data(), table.configs.data(), 0U));
+    REQUIRE_FALSE(uni_common_map_sharded_initialized(&table.ctx));
+    REQUIRE_FALSE(uni_common_map_sharded_set(&table.ctx, 1U, &table.vals_buf[0]));
+    REQUIRE(uni_common_map_sharded_shard(&table.ctx, 1U) == SIZE_MAX);
+
+    // value sizes of the shards must match
+    uni_common_array_set_itemsize(&table.vals[3], sizeof(uint32_t));
+    REQUIRE_FALSE(uni_common_map_sharded_init(&table.ctx, table.shards.data(), table.configs.data(), 4U));
+    uni_common_array_set_itemsize(&table.vals[3], sizeof(uint64_t));
+
+    REQUIRE(uni_common_map_sharded_init(&table.ctx, table.shards.data(), table.configs.data(), 4U));
+    REQUIRE(uni_common_map_sharded_initialized(&table.ctx));
+    REQUIRE(uni_common_map_sharded_capacity(&table.ctx) == 256U);
+    REQUIRE(uni_common_map_sharded_shard_count(&table.ctx) == 4U);
+    REQUIRE(uni_common_map_sharded_size(&table.ctx) == 0U);
+}
+
+
+TEST_CASE("map_sharded_process", "[map_sharded]") {
+    map_sharded_table table(4U, 64U);
+    REQUIRE(uni_common_map_sharded_init(&table.ctx, table.shards.data(), table.configs.data(), 4U));
+
+    SECTION("set-get-remove") {
+        uint64_t val = 100U;
+        uint64_t val_read = 0U;
+        REQUIRE(uni_common_map_sharded_set(&table.ctx, 5U, &val));
+        REQUIRE(uni_common_map_sharded_get(&table.ctx, 5U, &val_read));
+        REQUIRE(val_read == 100U);
+        REQUIRE(uni_common_map_sharded_get(&table.ctx, 5U, nullptr));
+        REQUIRE_FALSE(uni_common_map_sharded_get(&table.ctx, 6U, &val_read));
+
+        size_t shard = uni_common_map_sharded_shard(&table.ctx, 5U);
+        REQUIRE(shard < 4U);
+        REQUIRE(uni_common_map_size(&table.shards[shard].map) == 1U);
+
+        REQUIRE(uni_common_map_sharded_remove(&table.ctx, 5U));
+        REQUIRE_FALSE(uni_common_map_sharded_remove(&table.ctx, 5U));
+        REQUIRE(uni_common_map_sharded_size(&table.ctx) == 0U);
+    }
+
+    SECTION("distribution") {
+        for (size_t key = 0; key < 128U; key++) {
+            uint64_t val = key;
+            REQUIRE(uni_common_map_sharded_set(&table.ctx, key, &val));
+        }
+        REQUIRE(uni_common_map_sharded_size(&table.ctx) == 128U);
+
+        for (auto &shard : table.shards) {
+            REQUIRE(uni_common_map_size(&shard.map) > 16U);
+            REQUIRE(uni_common_map_size(&shard.map) < 48U);
+        }
+
+        REQUIRE(uni_common_map_sharded_clear(&table.ctx));
+        REQUIRE(uni_common_map_sharded_size(&table.ctx) == 0U);
+    }
+
+    SECTION("enum") {
+        uint64_t expected = 0U;
+        for (size_t key = 0; key < 100U; key++) {
+            uint64_t val = key * 2U;
+            REQUIRE(uni_common_map_sharded_set(&table.ctx, key, &val));
+            expected += key * 3U;
+        }
+
+        map_sharded_enum_sum = 0U;
+        map_sharded_enum_count = 0U;
+        REQUIRE(uni_common_map_sharded_enum(&table.ctx, map_sharded_enum_visit));
+        REQUIRE(map_sharded_enum_count == 100U);
+        REQUIRE(map_sharded_enum_sum == expected);
+
+        // shard-parallel enumeration
+        map_sharded_enum_sum = 0U;
+        map_sharded_enum_count = 0U;
+        std::vector<std::thread> threads;
+        for (size_t shard = 0; shard < 4U; shard++) {
+            threads.emplace_back([&, shard]() {
+                uni_common_map_sharded_enum_shard(&table.ctx, shard, map_sharded_enum_visit);
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        REQUIRE(map_sharded_enum_count == 100U);
+        REQUIRE(map_sharded_enum_sum == expected);
+
+        REQUIRE_FALSE(uni_common_map_sharded_enum_shard(&table.ctx, 4U, map_sharded_enum_visit));
+        REQUIRE_FALSE(uni_common_map_sharded_enum(&table.ctx, nullptr));
+    }
+}
+
+
+TEST_CASE("map_sharded_threads", "[map_sharded]") {
+    constexpr size_t threads_count = 4U;
+    constexpr size_t keys = 256U;
+    constexpr uint64_t rounds = 20000U;
+
+    map_sharded_table table(8U, 128U);
+    REQUIRE(uni_common_map_sharded_init(&table.ctx, table.shards.data(), table.configs.data(), 8U));
+
+    // every thread owns keys % threads_count == thread, values always encode the key
+    std::vector<uint8_t> consistent(threads_count, 1U);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < threads_count; thread++) {
+        threads.emplace_back([&, thread]() {
+            for (uint64_t round = 0; round < rounds; round++) {
+                size_t key = (round * threads_count + thread) % keys;
+                uint64_t val = key + round * keys;
+                if (round % 5U == 4U) {
+                    uni_common_map_sharded_remove(&table.ctx, key);
+                } else {
+                    consistent[thread] = consistent[thread] && uni_common_map_sharded_set(&table.ctx, key, &val);
+                }
+
+                uint64_t val_read = 0U;
+                size_t key_read = (key * 7U + 3U) % keys;
+                if (uni_common_map_sharded_get(&table.ctx, key_read, &val_read)) {
+                    consistent[thread] = consistent[thread] && val_read % keys == key_read;
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (size_t thread = 0; thread < threads_count; thread++) {
+        REQUIRE(consistent[thread]);
+    }
+
+    size_t size = 0U;
+    for (size_t key = 0; key < keys; key++) {
+        size += uni_common_map_sharded_get(&table.ctx, key, nullptr) ? 1U : 0U;
+    }
+    REQUIRE(uni_common_map_sharded_size(&table.ctx) == size);
+}
@@ -0,0 +1,110 @@
+//
+// Includes
+//
+
+// stdlib
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct map_sharded_bench {
+        std::vector<size_t> keys_buf;
+        std::vector<uint64_t> vals_buf;
+        std::vector<uni_common_array_t> keys;
+        std::vector<uni_common_array_t> vals;
+        std::vector<uni_common_map_config_t> configs;
+        std::vector<uni_common_map_shard_t> shards;
+        uni_common_map_sharded_context_t ctx{};
+
+        map_sharded_bench(size_t shard_count, size_t capacity)
+            : keys_buf(capacity), vals_buf(capacity), keys(shard_count), vals(shard_count), configs(shard_count),
+              shards(shard_count) {
+            size_t shard_capacity = capacity / shard_count;
+            for (size_t shard = 0; shard < shard_count; shard++) {
+                uni_common_array_init(&keys[shard], (uint8_t *)&keys_buf[shard * shard_capacity],
+                                      shard_capacity * sizeof(size_t), sizeof(size_t));
+                uni_common_array_init(&vals[shard], (uint8_t *)&vals_buf[shard * shard_capacity],
+                                      shard_capacity * sizeof(uint64_t), sizeof(uint64_t));
+                configs[shard].keys = &keys[shard];
+                configs[shard].vals = &vals[shard];
+                configs[shard].mode = UNI_COMMON_MAP_MODE_HASH;
+            }
+            uni_common_map_sharded_init(&ctx, shards.data(), configs.data(), shard_count);
+        }
+    };
+
+
+    /**
+     * Runs :threads workers with :ops operations each, every 4th operation is set or remove, the rest are gets
+     */
+    uint64_t map_sharded_bench_mixed(uni_common_map_sharded_context_t *ctx, size_t threads, size_t ops, size_t count) {
+        std::atomic<uint64_t> checksum{0};
+        std::vector<std::thread> workers;
+
+        for (size_t thread = 0; thread < threads; thread++) {
+            workers.emplace_back([&, thread]() {
+                uint64_t sum = 0;
+                uint64_t seed = thread + 1U;
+                for (size_t idx = 0; idx < ops; idx++) {
+                    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                    size_t key = (seed >> 33) % count;
+                    uint64_t val = seed;
+                    if (idx % 8U == 3U) {
+                        uni_common_map_sharded_set(ctx, key, &val);
+                    } else if (idx % 8U == 7U) {
+                        uni_common_map_sharded_remove(ctx, key);
+                    } else if (uni_common_map_sharded_get(ctx, key, &val)) {
+                        sum += val;
+                    }
+                }
+                checksum += sum;
+            });
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        return checksum.load();
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("map_sharded_bench_mixed", "[.][benchmark][map_sharded]") {
+    constexpr size_t count = 16384U;
+    constexpr size_t ops = 100000U;
+
+    for (size_t shard_count : {1U, 64U}) {
+        map_sharded_bench bench(shard_count, 65536U);
+        for (size_t key = 0; key < count; key += 2U) {
+            uint64_t val = key;
+            uni_common_map_sharded_set(&bench.ctx, key, &val);
+        }
+
+        for (size_t threads = 1U; threads <= 32U; threads *= 2U) {
+            BENCHMARK("mixed-100k/shards-" + std::to_string(shard_count) + "/threads-" + std::to_string(threads)) {
+                return map_sharded_bench_mixed(&bench.ctx, threads, ops, count);
+            };
+        }
+    }
+}
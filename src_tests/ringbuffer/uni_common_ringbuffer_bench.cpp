@@ -0,0 +1,181 @@
+//
+// Includes
+//
+
+// stdlib
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct ringbuffer_bench {
+        std::vector<uint8_t> buf;
+        std::vector<uint8_t> chunk;
+        uni_common_ringbuffer_context_t ctx{};
+
+        ringbuffer_bench(size_t size_object, size_t capacity, bool pow2)
+            : buf(size_object * capacity), chunk(size_object * capacity) {
+            if (pow2) {
+                uni_common_ringbuffer_init_pow2(&ctx, buf.data(), size_object, buf.size());
+            } else {
+                uni_common_ringbuffer_init(&ctx, buf.data(), size_object, buf.size());
+            }
+        }
+    };
+
+    std::string ringbuffer_bench_name(const char *op, bool pow2, size_t size_object, size_t capacity) {
+        return std::string(op) + (pow2 ? "/pow2/" : "/modulo/") + std::to_string(size_object) + "x" +
+               std::to_string(capacity);
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ringbuffer_bench_throughput", "[.][benchmark][ringbuffer]") {
+    for (size_t size_object : {1U, 4U, 16U}) {
+        for (size_t capacity : {64U, 4096U}) {
+            for (bool pow2 : {false, true}) {
+                ringbuffer_bench bench(size_object, capacity, pow2);
+
+                // push/pop of single object keeps ringbuffer half-full, index arithmetic dominates
+                uni_common_ringbuffer_push(&bench.ctx, bench.chunk.data(), capacity / 2);
+                BENCHMARK(ringbuffer_bench_name("push-pop", pow2, size_object, capacity)) {
+                    uni_common_ringbuffer_push(&bench.ctx, bench.chunk.data(), 1U);
+                    return uni_common_ringbuffer_pop(&bench.ctx, bench.chunk.data(), 1U);
+                };
+
+                // batch of half capacity per call
+                BENCHMARK(ringbuffer_bench_name("push-pop-batch", pow2, size_object, capacity)) {
+                    uni_common_ringbuffer_push(&bench.ctx, bench.chunk.data(), capacity / 2);
+                    return uni_common_ringbuffer_pop(&bench.ctx, bench.chunk.data(), capacity / 2);
+                };
+
+                // full ringbuffer, every push overwrites the oldest object
+                uni_common_ringbuffer_push(&bench.ctx, bench.chunk.data(), capacity);
+                BENCHMARK(ringbuffer_bench_name("push-overwrite", pow2, size_object, capacity)) {
+                    return uni_common_ringbuffer_push(&bench.ctx, bench.chunk.data(), 1U);
+                };
+            }
+        }
+    }
+}
+
+
+TEST_CASE("ringbuffer_bench_stream", "[.][benchmark][ringbuffer]") {
+    // byte stream staging, e.g. UART/socket frames of 1500 bytes through 4 KiB buffer
+    for (bool pow2 : {false, true}) {
+        ringbuffer_bench bench(1U, 4096U, pow2);
+
+        BENCHMARK(ringbuffer_bench_name("stream-1500", pow2, 1U, 4096U)) {
+            uni_common_ringbuffer_push_ex(&bench.ctx, bench.chunk.data(), 1500U, false);
+            return uni_common_ringbuffer_pop(&bench.ctx, bench.chunk.data(), 1500U);
+        };
+    }
+}
+
+
+TEST_CASE("ringbuffer_bench_zero_copy", "[.][benchmark][ringbuffer]") {
+    // decoder builds 16-byte objects, either on the stack with push or in place with reserve/commit
+    struct object {
+        uint64_t stamp;
+        uint64_t value;
+    };
+
+    for (bool pow2 : {false, true}) {
+        ringbuffer_bench bench(sizeof(object), 1024U, pow2);
+
+        uint64_t stamp = 0;
+        BENCHMARK(ringbuffer_bench_name("produce-push", pow2, sizeof(object), 1024U)) {
+            for (size_t idx = 0; idx < 256U; idx++) {
+                object obj{stamp, stamp * 3U};
+                uni_common_ringbuffer_push(&bench.ctx, (const uint8_t *)&obj, 1U);
+                stamp++;
+            }
+            return uni_common_ringbuffer_pop(&bench.ctx, nullptr, 256U);
+        };
+
+        BENCHMARK(ringbuffer_bench_name("produce-reserve", pow2, sizeof(object), 1024U)) {
+            size_t produced = 0;
+            while (produced < 256U) {
+                uint8_t *region = nullptr;
+                size_t reserved = uni_common_ringbuffer_reserve(&bench.ctx, 256U - produced, &region);
+                for (size_t idx = 0; idx < reserved; idx++) {
+                    ((object *)region)[idx] = {stamp, stamp * 3U};
+                    stamp++;
+                }
+                produced += uni_common_ringbuffer_commit(&bench.ctx, reserved);
+            }
+            return uni_common_ringbuffer_consume(&bench.ctx, 256U);
+        };
+    }
+}
+
+
+TEST_CASE("ringbuffer_bench_history", "[.][benchmark][ringbuffer]") {
+    // scan of the full 10k-object history
+    for (bool pow2 : {false, true}) {
+        ringbuffer_bench bench(sizeof(uint64_t), 16384U, pow2);
+        for (uint64_t value = 0; value < 16384U + 10000U; value++) {
+            uni_common_ringbuffer_push(&bench.ctx, (const uint8_t *)&value, 1U);
+        }
+        uni_common_ringbuffer_pop(&bench.ctx, nullptr, uni_common_ringbuffer_length(&bench.ctx) - 10000U);
+
+        BENCHMARK(ringbuffer_bench_name("scan-get", pow2, sizeof(uint64_t), 16384U)) {
+            uint64_t sum = 0;
+            size_t length = uni_common_ringbuffer_length(&bench.ctx);
+            for (size_t idx = 0; idx < length; idx++) {
+                uint64_t value = 0;
+                uni_common_ringbuffer_get(&bench.ctx, idx, (uint8_t *)&value);
+                sum += value;
+            }
+            return sum;
+        };
+
+        BENCHMARK(ringbuffer_bench_name("scan-view", pow2, sizeof(uint64_t), 16384U)) {
+            uint64_t sum = 0;
+            uni_common_ringbuffer_span_t spans[2]{};
+            uni_common_ringbuffer_view(&bench.ctx, spans);
+            for (const auto &span : spans) {
+                for (size_t idx = 0; idx < span.count; idx++) {
+                    sum += ((const uint64_t *)span.data)[idx];
+                }
+            }
+            return sum;
+        };
+    }
+}
+
+
+TEST_CASE("ringbuffer_bench_find", "[.][benchmark][ringbuffer]") {
+    // deduplication lookup of the absent ID scans the whole ring
+    for (size_t size_object : {1U, 4U, 8U, 16U}) {
+        for (bool pow2 : {false, true}) {
+            ringbuffer_bench bench(size_object, 4096U, pow2);
+            std::vector<uint8_t> needle(size_object, 0xFFU);
+            for (size_t idx = 0; idx < bench.chunk.size(); idx++) {
+                bench.chunk[idx] = (uint8_t)(idx % 251U);
+            }
+            uni_common_ringbuffer_push(&bench.ctx, bench.chunk.data(), 4096U);
+
+            BENCHMARK(ringbuffer_bench_name("find-absent", pow2, size_object, 4096U)) {
+                return uni_common_ringbuffer_find(&bench.ctx, needle.data());
+            };
+        }
+    }
+}
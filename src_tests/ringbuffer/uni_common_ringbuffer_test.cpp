@@ -4,6 +4,9 @@
 
 // stdlib
 #include <cstring>
+#include <deque>
+#include <random>
+#include <vector>
 
 // catch2
 #include <catch2/catch_test_macros.hpp>
@@ -40,6 +43,8 @@ typedef struct {
 uint8_t ringbuffer_data[ringbuffer_size];
 uni_common_ringbuffer_context_t ringbuffer_ctx{};
 
+UNI_COMMON_RINGBUFFER_DEFINITION_POW2(ringbuffer_pow2, uint32_t, 4);
+
 
 
 //
@@ -188,3 +193,345 @@ TEST_CASE("ringbuffer_overflow", "[ringbuffer]") {
     }
     REQUIRE(uni_common_ringbuffer_length(&ringbuffer_ctx) == 0);
 }
+
+
+TEST_CASE("ringbuffer_pow2", "[ringbuffer]") {
+    uint8_t data[8 * sizeof(ringbuffer_item)]{};
+    uni_common_ringbuffer_context_t ctx{};
+
+    SECTION("init") {
+        REQUIRE_FALSE(uni_common_ringbuffer_init_pow2(nullptr, data, sizeof(ringbuffer_item), sizeof(data)));
+        REQUIRE_FALSE(uni_common_ringbuffer_init_pow2(&ctx, nullptr, sizeof(ringbuffer_item), sizeof(data)));
+        REQUIRE_FALSE(uni_common_ringbuffer_init_pow2(&ctx, data, 0U, sizeof(data)));
+        REQUIRE_FALSE(uni_common_ringbuffer_init_pow2(&ctx, data, sizeof(ringbuffer_item), 6 * sizeof(ringbuffer_item)));
+        REQUIRE_FALSE(uni_common_ringbuffer_init_pow2(&ctx, data, sizeof(ringbuffer_item), 1 * sizeof(ringbuffer_item)));
+        REQUIRE(uni_common_ringbuffer_init_pow2(&ctx, data, sizeof(ringbuffer_item), sizeof(data)));
+        REQUIRE(uni_common_ringbuffer_is_empty(&ctx));
+    }
+
+    SECTION("overflow") {
+        REQUIRE(uni_common_ringbuffer_init_pow2(&ctx, data, sizeof(ringbuffer_item), sizeof(data)));
+
+        // all 8 slots are usable
+        for (size_t i = 0; i < 8; i++) {
+            REQUIRE_FALSE(uni_common_ringbuffer_is_full(&ctx));
+            ringbuffer_item item = {.a = i, .b = i + 1};
+            REQUIRE(uni_common_ringbuffer_push(&ctx, (uint8_t *)&item, 1U) == 1U);
+            REQUIRE(uni_common_ringbuffer_length(&ctx) == i + 1);
+        }
+        REQUIRE(uni_common_ringbuffer_is_full(&ctx));
+
+        // overwrite the two oldest objects
+        ringbuffer_item items[2] = {{.a = 8, .b = 9}, {.a = 9, .b = 10}};
+        REQUIRE(uni_common_ringbuffer_push(&ctx, (uint8_t *)items, 2U) == 2U);
+        REQUIRE(uni_common_ringbuffer_length(&ctx) == 8);
+
+        ringbuffer_item item_r{};
+        REQUIRE(uni_common_ringbuffer_get(&ctx, 7U, (uint8_t *)&item_r));
+        REQUIRE(item_r.a == 9);
+        REQUIRE_FALSE(uni_common_ringbuffer_get(&ctx, 8U, (uint8_t *)&item_r));
+        REQUIRE(uni_common_ringbuffer_find(&ctx, (uint8_t *)&items[0]) == 6U);
+
+        for (size_t i = 2; i < 10; i++) {
+            REQUIRE(uni_common_ringbuffer_pop(&ctx, (uint8_t *)&item_r, 1U) == 1U);
+            REQUIRE((item_r.a == i && item_r.b == i + 1));
+        }
+        REQUIRE(uni_common_ringbuffer_is_empty(&ctx));
+        REQUIRE(uni_common_ringbuffer_pop(&ctx, (uint8_t *)&item_r, 1U) == 0U);
+    }
+
+    SECTION("counter-wrap") {
+        REQUIRE(uni_common_ringbuffer_init_pow2(&ctx, data, sizeof(ringbuffer_item), sizeof(data)));
+
+        // counters are free-running, start right before the size_t overflow
+        ctx.pos_front = SIZE_MAX - 2U;
+        ctx.pos_back = SIZE_MAX - 2U;
+
+        for (size_t i = 0; i < 12; i++) {
+            ringbuffer_item item = {.a = i, .b = i + 1};
+            REQUIRE(uni_common_ringbuffer_push(&ctx, (uint8_t *)&item, 1U) == 1U);
+            REQUIRE(uni_common_ringbuffer_length(&ctx) == (i < 8 ? i + 1 : 8));
+        }
+
+        ringbuffer_item item_r{};
+        for (size_t i = 4; i < 12; i++) {
+            REQUIRE(uni_common_ringbuffer_pop(&ctx, (uint8_t *)&item_r, 1U) == 1U);
+            REQUIRE(item_r.a == i);
+        }
+        REQUIRE(uni_common_ringbuffer_is_empty(&ctx));
+    }
+}
+
+
+TEST_CASE("ringbuffer_pow2_definition", "[ringbuffer]") {
+    REQUIRE(uni_common_ringbuffer_length(&ringbuffer_pow2_ctx) == 0U);
+    REQUIRE(ringbuffer_pow2_ctx.mask == 3U);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        REQUIRE(uni_common_ringbuffer_push(&ringbuffer_pow2_ctx, (uint8_t *)&i, 1U) == 1U);
+    }
+    REQUIRE(uni_common_ringbuffer_is_full(&ringbuffer_pow2_ctx));
+    REQUIRE(uni_common_ringbuffer_clear(&ringbuffer_pow2_ctx));
+}
+
+
+TEST_CASE("ringbuffer_bulk", "[ringbuffer]") {
+    SECTION("no-overwrite") {
+        rb_init();
+
+        ringbuffer_item items[8]{};
+        for (size_t i = 0; i < 8; i++) {
+            items[i] = {.a = i, .b = i + 1};
+        }
+
+        // only 5 free slots
+        REQUIRE(uni_common_ringbuffer_push_ex(&ringbuffer_ctx, (uint8_t *)items, 3U, false) == 3U);
+        REQUIRE(uni_common_ringbuffer_push_ex(&ringbuffer_ctx, (uint8_t *)&items[3], 5U, false) == 2U);
+        REQUIRE(uni_common_ringbuffer_is_full(&ringbuffer_ctx));
+        REQUIRE(uni_common_ringbuffer_push_ex(&ringbuffer_ctx, (uint8_t *)items, 1U, false) == 0U);
+
+        ringbuffer_item items_r[8]{};
+        REQUIRE(uni_common_ringbuffer_pop(&ringbuffer_ctx, (uint8_t *)items_r, 8U) == 5U);
+        REQUIRE(memcmp(items, items_r, 5 * sizeof(ringbuffer_item)) == 0);
+    }
+
+    SECTION("oversized-push") {
+        rb_init();
+
+        ringbuffer_item items[8]{};
+        for (size_t i = 0; i < 8; i++) {
+            items[i] = {.a = i, .b = i + 1};
+        }
+
+        // only the last 5 objects survive
+        REQUIRE(uni_common_ringbuffer_push(&ringbuffer_ctx, (uint8_t *)items, 8U) == 8U);
+        REQUIRE(uni_common_ringbuffer_length(&ringbuffer_ctx) == 5U);
+
+        ringbuffer_item items_r[5]{};
+        REQUIRE(uni_common_ringbuffer_pop(&ringbuffer_ctx, nullptr, 1U) == 1U);
+        REQUIRE(uni_common_ringbuffer_pop(&ringbuffer_ctx, (uint8_t *)items_r, 5U) == 4U);
+        REQUIRE(memcmp(&items[4], items_r, 4 * sizeof(ringbuffer_item)) == 0);
+    }
+
+    SECTION("random") {
+        for (bool pow2 : {false, true}) {
+            uint8_t data[16]{};
+            uni_common_ringbuffer_context_t ctx{};
+            if (pow2) {
+                REQUIRE(uni_common_ringbuffer_init_pow2(&ctx, data, 1U, sizeof(data)));
+            } else {
+                REQUIRE(uni_common_ringbuffer_init(&ctx, data, 1U, sizeof(data)));
+            }
+            size_t capacity = pow2 ? 16U : 15U;
+
+            std::deque<uint8_t> reference;
+            std::mt19937 rng(42);
+            uint8_t counter = 0;
+
+            for (size_t iter = 0; iter < 2000; iter++) {
+                size_t count = rng() % 24U;
+                if (rng() % 2U == 0U) {
+                    std::vector<uint8_t> chunk(count);
+                    for (auto &byte : chunk) {
+                        byte = counter++;
+                    }
+
+                    bool overwrite = rng() % 2U == 0U;
+                    size_t pushed = uni_common_ringbuffer_push_ex(&ctx, chunk.data(), count, overwrite);
+                    if (!overwrite) {
+                        REQUIRE(pushed == std::min(count, capacity - reference.size()));
+                    } else {
+                        REQUIRE(pushed == count);
+                    }
+                    for (size_t i = 0; i < pushed; i++) {
+                        reference.push_back(chunk[i]);
+                        if (reference.size() > capacity) {
+                            reference.pop_front();
+                        }
+                    }
+                } else {
+                    std::vector<uint8_t> chunk(count);
+                    size_t popped = uni_common_ringbuffer_pop(&ctx, chunk.data(), count);
+                    REQUIRE(popped == std::min(count, reference.size()));
+                    for (size_t i = 0; i < popped; i++) {
+                        REQUIRE(chunk[i] == reference.front());
+                        reference.pop_front();
+                    }
+                }
+
+                REQUIRE(uni_common_ringbuffer_length(&ctx) == reference.size());
+            }
+        }
+    }
+}
+
+
+TEST_CASE("ringbuffer_zero_copy", "[ringbuffer]") {
+    SECTION("nullptr") {
+        uint8_t *region = nullptr;
+        const uint8_t *region_r = nullptr;
+        REQUIRE(uni_common_ringbuffer_reserve(nullptr, 1U, &region) == 0U);
+        REQUIRE(uni_common_ringbuffer_peek(nullptr, 1U, &region_r) == 0U);
+        REQUIRE(uni_common_ringbuffer_commit(nullptr, 1U) == 0U);
+        REQUIRE(uni_common_ringbuffer_consume(nullptr, 1U) == 0U);
+    }
+
+    SECTION("classic") {
+        rb_init();
+
+        // move positions to the middle, so region ends at the wrap point
+        ringbuffer_item items[3]{};
+        REQUIRE(uni_common_ringbuffer_push(&ringbuffer_ctx, (uint8_t *)items, 3U) == 3U);
+        REQUIRE(uni_common_ringbuffer_pop(&ringbuffer_ctx, nullptr, 3U) == 3U);
+
+        uint8_t *region = nullptr;
+        REQUIRE(uni_common_ringbuffer_reserve(&ringbuffer_ctx, 5U, &region) == 3U);
+        REQUIRE(region == &ringbuffer_data[3 * sizeof(ringbuffer_item)]);
+        for (size_t i = 0; i < 3; i++) {
+            ((ringbuffer_item *)region)[i] = {.a = i, .b = i + 1};
+        }
+        REQUIRE(uni_common_ringbuffer_commit(&ringbuffer_ctx, 3U) == 3U);
+
+        // one slot is kept free in classic mode
+        REQUIRE(uni_common_ringbuffer_reserve(&ringbuffer_ctx, 5U, &region) == 2U);
+        REQUIRE(region == ringbuffer_data);
+        for (size_t i = 0; i < 2; i++) {
+            ((ringbuffer_item *)region)[i] = {.a = i + 3, .b = i + 4};
+        }
+        REQUIRE(uni_common_ringbuffer_commit(&ringbuffer_ctx, 5U) == 2U);
+        REQUIRE(uni_common_ringbuffer_is_full(&ringbuffer_ctx));
+        REQUIRE(uni_common_ringbuffer_reserve(&ringbuffer_ctx, 1U, &region) == 0U);
+
+        const uint8_t *region_r = nullptr;
+        REQUIRE(uni_common_ringbuffer_peek(&ringbuffer_ctx, 5U, &region_r) == 3U);
+        REQUIRE(((const ringbuffer_item *)region_r)[2].a == 2U);
+        REQUIRE(uni_common_ringbuffer_consume(&ringbuffer_ctx, 3U) == 3U);
+
+        REQUIRE(uni_common_ringbuffer_peek(&ringbuffer_ctx, 5U, &region_r) == 2U);
+        REQUIRE(((const ringbuffer_item *)region_r)[1].a == 4U);
+        REQUIRE(uni_common_ringbuffer_consume(&ringbuffer_ctx, 5U) == 2U);
+        REQUIRE(uni_common_ringbuffer_is_empty(&ringbuffer_ctx));
+    }
+
+    SECTION("pow2") {
+        uint8_t data[8]{};
+        uni_common_ringbuffer_context_t ctx{};
+        REQUIRE(uni_common_ringbuffer_init_pow2(&ctx, data, 1U, sizeof(data)));
+
+        // byte stream written in place and parsed in place
+        uint8_t counter = 0;
+        uint8_t counter_r = 0;
+        for (size_t iter = 0; iter < 50; iter++) {
+            uint8_t *region = nullptr;
+            size_t reserved = uni_common_ringbuffer_reserve(&ctx, 1U + iter % 7U, &region);
+            for (size_t i = 0; i < reserved; i++) {
+                region[i] = counter++;
+            }
+            REQUIRE(uni_common_ringbuffer_commit(&ctx, reserved) == reserved);
+
+            const uint8_t *region_r = nullptr;
+            size_t peeked = uni_common_ringbuffer_peek(&ctx, 1U + iter % 5U, &region_r);
+            for (size_t i = 0; i < peeked; i++) {
+                REQUIRE(region_r[i] == counter_r++);
+            }
+            REQUIRE(uni_common_ringbuffer_consume(&ctx, peeked) == peeked);
+            REQUIRE(uni_common_ringbuffer_length(&ctx) == (uint8_t)(counter - counter_r));
+        }
+    }
+}
+
+
+TEST_CASE("ringbuffer_view", "[ringbuffer]") {
+    uni_common_ringbuffer_span_t spans[2]{};
+
+    SECTION("nullptr") {
+        REQUIRE(uni_common_ringbuffer_view(nullptr, spans) == 0U);
+        rb_init();
+        REQUIRE(uni_common_ringbuffer_view(&ringbuffer_ctx, nullptr) == 0U);
+    }
+
+    SECTION("empty") {
+        rb_init();
+        REQUIRE(uni_common_ringbuffer_view(&ringbuffer_ctx, spans) == 0U);
+        REQUIRE(spans[0].count == 0U);
+        REQUIRE(spans[1].count == 0U);
+    }
+
+    SECTION("wrap") {
+        for (bool pow2 : {false, true}) {
+            uint32_t data[8]{};
+            uni_common_ringbuffer_context_t ctx{};
+            if (pow2) {
+                REQUIRE(uni_common_ringbuffer_init_pow2(&ctx, (uint8_t *)data, sizeof(uint32_t), sizeof(data)));
+            } else {
+                REQUIRE(uni_common_ringbuffer_init(&ctx, (uint8_t *)data, sizeof(uint32_t), sizeof(data)));
+            }
+
+            // every push shifts the window, check contents through spans and indexed access
+            for (uint32_t value = 0; value < 40; value++) {
+                REQUIRE(uni_common_ringbuffer_push(&ctx, (uint8_t *)&value, 1U) == 1U);
+
+                size_t length = uni_common_ringbuffer_length(&ctx);
+                size_t span_count = uni_common_ringbuffer_view(&ctx, spans);
+                REQUIRE(span_count >= 1U);
+                REQUIRE(spans[0].count + spans[1].count == length);
+                REQUIRE((span_count == 2U) == (spans[1].count != 0U));
+
+                uint32_t expected = value + 1U - (uint32_t)length;
+                for (const auto &span : spans) {
+                    for (size_t idx = 0; idx < span.count; idx++) {
+                        uint32_t item = 0;
+                        REQUIRE(uni_common_ringbuffer_get(&ctx, expected - (value + 1U - length), (uint8_t *)&item));
+                        REQUIRE(item == expected);
+                        REQUIRE(((const uint32_t *)span.data)[idx] == expected);
+                        expected++;
+                    }
+                }
+                REQUIRE(expected == value + 1U);
+            }
+        }
+    }
+}
+
+
+TEST_CASE("ringbuffer_find_sizes", "[ringbuffer]") {
+    // vector path sizes, the odd size takes the scalar path
+    for (size_t size_object : {1U, 2U, 3U, 4U, 8U, 16U}) {
+        for (bool pow2 : {false, true}) {
+            std::vector<uint8_t> data(size_object * 64U);
+            uni_common_ringbuffer_context_t ctx{};
+            if (pow2) {
+                REQUIRE(uni_common_ringbuffer_init_pow2(&ctx, data.data(), size_object, data.size()));
+            } else {
+                REQUIRE(uni_common_ringbuffer_init(&ctx, data.data(), size_object, data.size()));
+            }
+
+            std::mt19937 rng(size_object);
+            std::deque<std::vector<uint8_t>> reference;
+            size_t capacity = pow2 ? 64U : 63U;
+
+            for (size_t iter = 0; iter < 300; iter++) {
+                // objects differ in the last byte only, so partial matches must be rejected
+                std::vector<uint8_t> object(size_object, 0x5A);
+                object.back() = (uint8_t)(rng() % 48U);
+                REQUIRE(uni_common_ringbuffer_push(&ctx, object.data(), 1U) == 1U);
+                reference.push_back(object);
+                if (reference.size() > capacity) {
+                    reference.pop_front();
+                }
+
+                std::vector<uint8_t> needle(size_object, 0x5A);
+                needle.back() = (uint8_t)(rng() % 64U);
+
+                size_t expected = SIZE_MAX;
+                for (size_t idx = 0; idx < reference.size(); idx++) {
+                    if (reference[idx] == needle) {
+                        expected = idx;
+                        break;
+                    }
+                }
+                REQUIRE(uni_common_ringbuffer_find(&ctx, needle.data()) == expected);
+            }
+        }
+    }
+}
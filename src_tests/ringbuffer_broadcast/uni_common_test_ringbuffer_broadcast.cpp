@@ -0,0 +1,154 @@
+//
+// Includes
+//
+
+// stdlib
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("ringbuffer_broadcast_init", "[ringbuffer_broadcast]") {
+    uint8_t data[64]{};
+    uni_common_ringbuffer_broadcast_context_t ctx{};
+    uni_common_ringbuffer_broadcast_cursor_t cursor{};
+
+    REQUIRE_FALSE(uni_common_ringbuffer_broadcast_init(nullptr, data, 4U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_broadcast_init(&ctx, nullptr, 4U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_broadcast_init(&ctx, data, 0U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_broadcast_init(&ctx, data, 4U, 12U * 4U));
+    REQUIRE_FALSE(uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor, false));
+    REQUIRE(uni_common_ringbuffer_broadcast_init(&ctx, data, 4U, sizeof(data)));
+    REQUIRE(uni_common_ringbuffer_broadcast_capacity(&ctx) == 16U);
+
+    REQUIRE(uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor, false));
+    REQUIRE(uni_common_ringbuffer_broadcast_pending(&ctx, &cursor) == 0U);
+    REQUIRE_FALSE(uni_common_ringbuffer_broadcast_lapped(&ctx, &cursor));
+}
+
+
+TEST_CASE("ringbuffer_broadcast_read", "[ringbuffer_broadcast]") {
+    uint32_t data[8]{};
+    uni_common_ringbuffer_broadcast_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_broadcast_init(&ctx, (uint8_t *)data, sizeof(uint32_t), sizeof(data)));
+
+    SECTION("independent-cursors") {
+        uni_common_ringbuffer_broadcast_cursor_t cursor_a{}, cursor_b{};
+        REQUIRE(uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor_a, false));
+        REQUIRE(uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor_b, false));
+
+        uint32_t items[5] = {10, 11, 12, 13, 14};
+        REQUIRE(uni_common_ringbuffer_broadcast_push(&ctx, (uint8_t *)items, 5U) == 5U);
+
+        // every reader gets every object
+        uint32_t items_r[5]{};
+        REQUIRE(uni_common_ringbuffer_broadcast_read(&ctx, &cursor_a, (uint8_t *)items_r, 2U) == 2U);
+        REQUIRE((items_r[0] == 10 && items_r[1] == 11));
+        REQUIRE(uni_common_ringbuffer_broadcast_read(&ctx, &cursor_b, (uint8_t *)items_r, 5U) == 5U);
+        REQUIRE(items_r[4] == 14);
+        REQUIRE(uni_common_ringbuffer_broadcast_read(&ctx, &cursor_a, (uint8_t *)items_r, 5U) == 3U);
+        REQUIRE(items_r[0] == 12);
+
+        REQUIRE(uni_common_ringbuffer_broadcast_read(&ctx, &cursor_a, (uint8_t *)items_r, 5U) == 0U);
+        REQUIRE(cursor_a.lost == 0U);
+        REQUIRE(cursor_b.lost == 0U);
+
+        // late reader may start from history
+        uni_common_ringbuffer_broadcast_cursor_t cursor_c{};
+        REQUIRE(uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor_c, true));
+        REQUIRE(uni_common_ringbuffer_broadcast_pending(&ctx, &cursor_c) == 5U);
+    }
+
+    SECTION("lapped") {
+        uni_common_ringbuffer_broadcast_cursor_t cursor{};
+        REQUIRE(uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor, false));
+
+        for (uint32_t value = 0; value < 20; value++) {
+            REQUIRE(uni_common_ringbuffer_broadcast_push(&ctx, (uint8_t *)&value, 1U) == 1U);
+        }
+        REQUIRE(uni_common_ringbuffer_broadcast_pending(&ctx, &cursor) == 20U);
+        REQUIRE(uni_common_ringbuffer_broadcast_lapped(&ctx, &cursor));
+
+        // 12 oldest objects are lost, the last 8 are read
+        uint32_t items_r[20]{};
+        REQUIRE(uni_common_ringbuffer_broadcast_read(&ctx, &cursor, (uint8_t *)items_r, 20U) == 8U);
+        REQUIRE(cursor.lost == 12U);
+        REQUIRE(items_r[0] == 12U);
+        REQUIRE(items_r[7] == 19U);
+        REQUIRE_FALSE(uni_common_ringbuffer_broadcast_lapped(&ctx, &cursor));
+    }
+}
+
+
+TEST_CASE("ringbuffer_broadcast_threads", "[ringbuffer_broadcast]") {
+    constexpr size_t readers = 3U;
+    constexpr uint64_t count = 100000U;
+
+    std::vector<uint64_t> data(256);
+    uni_common_ringbuffer_broadcast_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_broadcast_init(&ctx, (uint8_t *)data.data(), sizeof(uint64_t),
+                                                 data.size() * sizeof(uint64_t)));
+
+    std::vector<uni_common_ringbuffer_broadcast_cursor_t> cursors(readers);
+    for (auto &cursor : cursors) {
+        REQUIRE(uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor, false));
+    }
+
+    // every reader must see increasing values without torn objects, lost objects are accounted in the cursor
+    std::atomic<bool> done{false};
+    std::vector<uint64_t> received(readers);
+    std::vector<uint8_t> ordered(readers, 1U);
+    std::vector<std::thread> threads;
+    for (size_t reader = 0; reader < readers; reader++) {
+        threads.emplace_back([&, reader]() {
+            auto &cursor = cursors[reader];
+            uint64_t expected = 0;
+            for (;;) {
+                bool finished = done.load();
+                uint64_t chunk[4];
+                size_t read = uni_common_ringbuffer_broadcast_read(&ctx, &cursor, (uint8_t *)chunk, 4U);
+                for (size_t idx = 0; idx < read; idx++) {
+                    uint64_t position = cursor.pos - read + idx;
+                    ordered[reader] = ordered[reader] && chunk[idx] == position * 3U && position >= expected;
+                    expected = position + 1U;
+                }
+                received[reader] += read;
+                if (read == 0U) {
+                    if (finished) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (uint64_t value = 0; value < count; value++) {
+        uint64_t item = value * 3U;
+        uni_common_ringbuffer_broadcast_push(&ctx, (uint8_t *)&item, 1U);
+        if (value % 64U == 0U) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true);
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (size_t reader = 0; reader < readers; reader++) {
+        REQUIRE(ordered[reader]);
+        REQUIRE(received[reader] + cursors[reader].lost == count);
+    }
+}
@@ -0,0 +1,75 @@
+//
+// Includes
+//
+
+// stdlib
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ringbuffer_broadcast_bench_fanout", "[.][benchmark][ringbuffer_broadcast]") {
+    constexpr size_t capacity = 1024U;
+    constexpr size_t readers = 3U;
+
+    struct record {
+        uint64_t stamp;
+        uint64_t values[3];
+    };
+    std::vector<record> batch(64U);
+
+    // one copy of the stream per reader
+    {
+        std::vector<std::vector<record>> bufs(readers, std::vector<record>(capacity));
+        std::vector<uni_common_ringbuffer_context_t> ctxs(readers);
+        for (size_t reader = 0; reader < readers; reader++) {
+            uni_common_ringbuffer_init_pow2(&ctxs[reader], (uint8_t *)bufs[reader].data(), sizeof(record),
+                                            capacity * sizeof(record));
+        }
+
+        std::vector<record> batch_r(64U);
+        BENCHMARK("fanout-3/ringbuffer-copies") {
+            size_t result = 0;
+            for (auto &ctx : ctxs) {
+                uni_common_ringbuffer_push(&ctx, (const uint8_t *)batch.data(), batch.size());
+            }
+            for (auto &ctx : ctxs) {
+                result += uni_common_ringbuffer_pop(&ctx, (uint8_t *)batch_r.data(), batch_r.size());
+            }
+            return result;
+        };
+    }
+
+    // one shared stream, reader cursors
+    {
+        std::vector<record> buf(capacity);
+        uni_common_ringbuffer_broadcast_context_t ctx{};
+        uni_common_ringbuffer_broadcast_init(&ctx, (uint8_t *)buf.data(), sizeof(record), capacity * sizeof(record));
+
+        std::vector<uni_common_ringbuffer_broadcast_cursor_t> cursors(readers);
+        for (auto &cursor : cursors) {
+            uni_common_ringbuffer_broadcast_cursor_init(&ctx, &cursor, false);
+        }
+
+        std::vector<record> batch_r(64U);
+        BENCHMARK("fanout-3/broadcast") {
+            size_t result = 0;
+            uni_common_ringbuffer_broadcast_push(&ctx, (const uint8_t *)batch.data(), batch.size());
+            for (auto &cursor : cursors) {
+                result += uni_common_ringbuffer_broadcast_read(&ctx, &cursor, (uint8_t *)batch_r.data(), batch_r.size());
+            }
+            return result;
+        };
+    }
+}
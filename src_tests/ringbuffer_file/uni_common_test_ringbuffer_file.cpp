@@ -0,0 +1,247 @@
+//
+// Includes
+//
+
+// stdlib
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    std::string ringbuffer_file_test_path(const char *name) {
+        std::string result = (std::filesystem::temp_directory_path() / name).string();
+        std::remove(result.c_str());
+        return result;
+    }
+}
+
+
+
+//
+// Tests
+//
+
+#if defined(__linux__)
+
+TEST_CASE("ringbuffer_file_open", "[ringbuffer_file]") {
+    std::string path = ringbuffer_file_test_path("uni_common_test_ringbuffer_file_open.bin");
+
+    uni_common_ringbuffer_file_config_t config{};
+    config.path = path.c_str();
+    config.size_object = 4U;
+    config.size_total = 64U;
+
+    uni_common_ringbuffer_file_context_t ctx{};
+    REQUIRE_FALSE(uni_common_ringbuffer_file_open(nullptr, &config));
+    REQUIRE_FALSE(uni_common_ringbuffer_file_open(&ctx, nullptr));
+    REQUIRE_FALSE(uni_common_ringbuffer_file_close(&ctx));
+
+    config.sync = UNI_COMMON_RINGBUFFER_FILE_SYNC_PERIODIC;
+    REQUIRE_FALSE(uni_common_ringbuffer_file_open(&ctx, &config));
+    config.sync = UNI_COMMON_RINGBUFFER_FILE_SYNC_NONE;
+    config.size_total = 66U;
+    REQUIRE_FALSE(uni_common_ringbuffer_file_open(&ctx, &config));
+    config.size_total = 64U;
+
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+    REQUIRE_FALSE(uni_common_ringbuffer_file_is_restored(&ctx));
+    REQUIRE(ctx.ring.mask == 15U);
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+
+    // existing file with the different parameters is not touched
+    config.size_object = 8U;
+    REQUIRE_FALSE(uni_common_ringbuffer_file_open(&ctx, &config));
+    config.size_object = 4U;
+    config.size_total = 128U;
+    REQUIRE_FALSE(uni_common_ringbuffer_file_open(&ctx, &config));
+    config.size_total = 64U;
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+    REQUIRE(uni_common_ringbuffer_file_is_restored(&ctx));
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+
+    // file which was sized but got no header before the crash is initialized again
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        uni_common_ringbuffer_file_header_t header{};
+        file.write((const char *)&header, sizeof(header));
+    }
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+    REQUIRE_FALSE(uni_common_ringbuffer_file_is_restored(&ctx));
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+    REQUIRE(uni_common_ringbuffer_file_is_restored(&ctx));
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+
+    std::remove(path.c_str());
+}
+
+
+TEST_CASE("ringbuffer_file_reopen", "[ringbuffer_file]") {
+    std::string path = ringbuffer_file_test_path("uni_common_test_ringbuffer_file_reopen.bin");
+
+    uni_common_ringbuffer_file_config_t config{};
+    config.path = path.c_str();
+    config.size_object = 4U;
+
+    SECTION("pow2") {
+        config.size_total = 64U;
+    }
+
+    SECTION("classic") {
+        config.size_total = 60U;
+    }
+
+    uni_common_ringbuffer_file_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+
+    for (uint32_t value = 0; value < 20U; value++) {
+        REQUIRE(uni_common_ringbuffer_file_push(&ctx, (uint8_t *)&value, 1U) == 1U);
+    }
+    uint32_t value_r = 0U;
+    REQUIRE(uni_common_ringbuffer_file_pop(&ctx, (uint8_t *)&value_r, 1U) == 1U);
+    size_t length = uni_common_ringbuffer_length(&ctx.ring);
+
+    // second mapping of the same file sees only the committed state, like the process restarted after the crash
+    uint32_t value_uncommitted = 100U;
+    REQUIRE(uni_common_ringbuffer_push(&ctx.ring, (uint8_t *)&value_uncommitted, 1U) == 1U);
+
+    uni_common_ringbuffer_file_context_t ctx_reopen{};
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx_reopen, &config));
+    REQUIRE(uni_common_ringbuffer_file_is_restored(&ctx_reopen));
+    REQUIRE(uni_common_ringbuffer_length(&ctx_reopen.ring) == length);
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx_reopen));
+
+    uint32_t value_first = 0U;
+    REQUIRE(uni_common_ringbuffer_get(&ctx.ring, 0U, (uint8_t *)&value_first));
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+
+    // after the close everything is persisted
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+    REQUIRE(uni_common_ringbuffer_length(&ctx.ring) == length + 1U);
+    REQUIRE(uni_common_ringbuffer_file_pop(&ctx, (uint8_t *)&value_r, 1U) == 1U);
+    REQUIRE(value_r == value_first);
+    // close commits once more
+    uint64_t seq = ctx.seq + 1U;
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+
+    // torn write of the newest header slot falls back to the previous commit
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp((std::streamoff)(offsetof(uni_common_ringbuffer_file_header_t, slots) +
+                                    (seq & 1U) * sizeof(uni_common_ringbuffer_file_slot_t) +
+                                    offsetof(uni_common_ringbuffer_file_slot_t, check)));
+        uint64_t garbage = 0x5A5A5A5A5A5A5A5AULL;
+        file.write((const char *)&garbage, sizeof(garbage));
+    }
+
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+    REQUIRE(ctx.seq == seq - 1U);
+    REQUIRE(uni_common_ringbuffer_length(&ctx.ring) == length);
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+
+    std::remove(path.c_str());
+}
+
+
+TEST_CASE("ringbuffer_file_overwrite", "[ringbuffer_file]") {
+    std::string path = ringbuffer_file_test_path("uni_common_test_ringbuffer_file_overwrite.bin");
+
+    uni_common_ringbuffer_file_config_t config{};
+    config.path = path.c_str();
+    config.size_object = 4U;
+    config.size_total = 32U;
+
+    uni_common_ringbuffer_file_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+
+    uint32_t values[8] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U};
+    REQUIRE(uni_common_ringbuffer_file_push(&ctx, (uint8_t *)values, 8U) == 8U);
+
+    // overwrite of 0..2 by 100..102
+    uint32_t values_new[3] = {100U, 101U, 102U};
+    uint64_t seq = ctx.seq;
+    REQUIRE(uni_common_ringbuffer_file_push(&ctx, (uint8_t *)values_new, 3U) == 3U);
+    REQUIRE(ctx.seq == seq + 2U);
+
+    // crash before the last commit: newest header slot is lost, second mapping sees the previous commit, it must
+    // contain only the objects which were not overwritten
+    ctx.header->slots[ctx.seq & 1U].check ^= 1U;
+
+    uni_common_ringbuffer_file_context_t ctx_reopen{};
+    REQUIRE(uni_common_ringbuffer_file_open(&ctx_reopen, &config));
+    REQUIRE(ctx_reopen.seq == seq + 1U);
+    REQUIRE(uni_common_ringbuffer_length(&ctx_reopen.ring) == 5U);
+    for (size_t idx = 0; idx < 5U; idx++) {
+        uint32_t value = 0U;
+        REQUIRE(uni_common_ringbuffer_get(&ctx_reopen.ring, idx, (uint8_t *)&value));
+        REQUIRE(value == idx + 3U);
+    }
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx_reopen));
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+
+    std::remove(path.c_str());
+}
+
+
+TEST_CASE("ringbuffer_file_sync", "[ringbuffer_file]") {
+    std::string path = ringbuffer_file_test_path("uni_common_test_ringbuffer_file_sync.bin");
+
+    uni_common_ringbuffer_file_config_t config{};
+    config.path = path.c_str();
+    config.size_object = 8U;
+    config.size_total = 4096U;
+
+    uni_common_ringbuffer_file_context_t ctx{};
+    uint64_t value = 0U;
+
+    SECTION("none") {
+        config.sync = UNI_COMMON_RINGBUFFER_FILE_SYNC_NONE;
+        REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+        for (size_t idx = 0; idx < 10U; idx++) {
+            REQUIRE(uni_common_ringbuffer_file_push(&ctx, (uint8_t *)&value, 1U) == 1U);
+        }
+        REQUIRE(uni_common_ringbuffer_file_count_sync(&ctx) == 0U);
+    }
+
+    SECTION("periodic") {
+        config.sync = UNI_COMMON_RINGBUFFER_FILE_SYNC_PERIODIC;
+        config.sync_period = 4U;
+        REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+        size_t count_open = uni_common_ringbuffer_file_count_sync(&ctx);
+        for (size_t idx = 0; idx < 10U; idx++) {
+            REQUIRE(uni_common_ringbuffer_file_push(&ctx, (uint8_t *)&value, 1U) == 1U);
+        }
+        REQUIRE(uni_common_ringbuffer_file_count_sync(&ctx) - count_open == 2U);
+    }
+
+    SECTION("commit") {
+        config.sync = UNI_COMMON_RINGBUFFER_FILE_SYNC_COMMIT;
+        REQUIRE(uni_common_ringbuffer_file_open(&ctx, &config));
+        size_t count_open = uni_common_ringbuffer_file_count_sync(&ctx);
+        for (size_t idx = 0; idx < 10U; idx++) {
+            REQUIRE(uni_common_ringbuffer_file_push(&ctx, (uint8_t *)&value, 1U) == 1U);
+        }
+
+        // data and header per commit
+        REQUIRE(uni_common_ringbuffer_file_count_sync(&ctx) - count_open == 20U);
+    }
+
+    REQUIRE(uni_common_ringbuffer_file_close(&ctx));
+    std::remove(path.c_str());
+}
+
+#endif
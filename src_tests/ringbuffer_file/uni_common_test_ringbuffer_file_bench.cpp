@@ -0,0 +1,91 @@
+//
+// Includes
+//
+
+// stdlib
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Benchmarks
+//
+
+#if defined(__linux__)
+
+TEST_CASE("ringbuffer_file_bench_push", "[.][benchmark][ringbuffer_file]") {
+    std::string path = (std::filesystem::temp_directory_path() / "uni_common_test_ringbuffer_file_bench.bin").string();
+    std::vector<uint8_t> record(64U);
+
+    struct {
+        const char *name;
+        uni_common_ringbuffer_file_sync_t sync;
+    } policies[] = {
+        {"none", UNI_COMMON_RINGBUFFER_FILE_SYNC_NONE},
+        {"periodic-64", UNI_COMMON_RINGBUFFER_FILE_SYNC_PERIODIC},
+        {"commit", UNI_COMMON_RINGBUFFER_FILE_SYNC_COMMIT},
+    };
+
+    for (const auto &policy : policies) {
+        std::remove(path.c_str());
+
+        uni_common_ringbuffer_file_config_t config{};
+        config.path = path.c_str();
+        config.size_object = 64U;
+        config.size_total = 1024U * 1024U;
+        config.sync = policy.sync;
+        config.sync_period = 64U;
+
+        uni_common_ringbuffer_file_context_t ctx{};
+        uni_common_ringbuffer_file_open(&ctx, &config);
+
+        BENCHMARK(std::string("push-64B/") + policy.name) {
+            return uni_common_ringbuffer_file_push(&ctx, record.data(), 1U);
+        };
+
+        uni_common_ringbuffer_file_close(&ctx);
+    }
+
+    std::remove(path.c_str());
+}
+
+
+TEST_CASE("ringbuffer_file_bench_reopen", "[.][benchmark][ringbuffer_file]") {
+    std::string path = (std::filesystem::temp_directory_path() / "uni_common_test_ringbuffer_file_bench.bin").string();
+    std::remove(path.c_str());
+
+    uni_common_ringbuffer_file_config_t config{};
+    config.path = path.c_str();
+    config.size_object = 64U;
+    config.size_total = 64U * 1024U * 1024U;
+
+    // fill the whole ring once
+    uni_common_ringbuffer_file_context_t ctx{};
+    uni_common_ringbuffer_file_open(&ctx, &config);
+    std::vector<uint8_t> records(1024U * 64U, 0xA5);
+    for (size_t idx = 0; idx < 1024U; idx++) {
+        uni_common_ringbuffer_push(&ctx.ring, records.data(), 1024U);
+    }
+    uni_common_ringbuffer_file_close(&ctx);
+
+    BENCHMARK("reopen/64MiB") {
+        uni_common_ringbuffer_file_open(&ctx, &config);
+        size_t length = uni_common_ringbuffer_length(&ctx.ring);
+        uni_common_ringbuffer_file_close(&ctx);
+        return length;
+    };
+
+    std::remove(path.c_str());
+}
+
+#endif
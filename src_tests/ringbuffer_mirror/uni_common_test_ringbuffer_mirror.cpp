@@ -0,0 +1,104 @@
+//
+// Includes
+//
+
+// stdlib
+#include <cstring>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Tests
+//
+
+#if defined(__linux__)
+
+TEST_CASE("ringbuffer_mirror_create", "[ringbuffer_mirror]") {
+    size_t page = uni_common_ringbuffer_mirror_granularity();
+    REQUIRE(page != 0U);
+
+    uni_common_ringbuffer_context_t ctx{};
+    REQUIRE_FALSE(uni_common_ringbuffer_mirror_create(nullptr, 1U, page));
+    REQUIRE_FALSE(uni_common_ringbuffer_mirror_create(&ctx, 0U, page));
+    REQUIRE_FALSE(uni_common_ringbuffer_mirror_create(&ctx, 1U, page + 1U));
+    REQUIRE_FALSE(uni_common_ringbuffer_mirror_destroy(&ctx));
+
+    SECTION("pow2") {
+        REQUIRE(uni_common_ringbuffer_mirror_create(&ctx, 4U, page));
+        REQUIRE(ctx.mirrored);
+        REQUIRE(ctx.mask == page / 4U - 1U);
+
+        // second mapping aliases the first one
+        ctx.data[5] = 0xA5;
+        REQUIRE(ctx.data[page + 5U] == 0xA5);
+        ctx.data[page + 7U] = 0x5A;
+        REQUIRE(ctx.data[7] == 0x5A);
+
+        REQUIRE(uni_common_ringbuffer_mirror_destroy(&ctx));
+        REQUIRE(ctx.data == nullptr);
+    }
+
+    SECTION("classic") {
+        // 3-byte objects in 9 pages do not give power-of-two capacity
+        REQUIRE(uni_common_ringbuffer_mirror_create(&ctx, 3U, 9U * page));
+        REQUIRE(ctx.mirrored);
+        REQUIRE(ctx.mask == 0U);
+        REQUIRE(uni_common_ringbuffer_mirror_destroy(&ctx));
+    }
+}
+
+
+TEST_CASE("ringbuffer_mirror_contiguous", "[ringbuffer_mirror]") {
+    size_t page = uni_common_ringbuffer_mirror_granularity();
+    uint32_t size_objects[] = {1U, 3U};
+
+    for (uint32_t size_object : size_objects) {
+        // power-of-two mode for 1-byte objects, classic mode for 3-byte objects
+        size_t count = size_object * page;
+        uni_common_ringbuffer_context_t ctx{};
+        REQUIRE(uni_common_ringbuffer_mirror_create(&ctx, size_object, size_object * count));
+        size_t capacity = ctx.mask != 0U ? count : count - 1U;
+
+        // move positions close to the end of data array
+        std::vector<uint8_t> chunk(size_object * count);
+        REQUIRE(uni_common_ringbuffer_push(&ctx, chunk.data(), count - 10U) == count - 10U);
+        REQUIRE(uni_common_ringbuffer_pop(&ctx, nullptr, count - 10U) == count - 10U);
+
+        // whole free space is one region across the end of data array
+        uint8_t *region = nullptr;
+        REQUIRE(uni_common_ringbuffer_reserve(&ctx, count * 2U, &region) == capacity);
+        for (size_t idx = 0; idx < capacity * size_object; idx++) {
+            region[idx] = (uint8_t)(idx % 251U);
+        }
+        REQUIRE(uni_common_ringbuffer_commit(&ctx, capacity) == capacity);
+
+        // and so is the whole content
+        const uint8_t *region_r = nullptr;
+        REQUIRE(uni_common_ringbuffer_peek(&ctx, count * 2U, &region_r) == capacity);
+        bool equal = true;
+        for (size_t idx = 0; idx < capacity * size_object; idx++) {
+            equal = equal && region_r[idx] == (uint8_t)(idx % 251U);
+        }
+        REQUIRE(equal);
+
+        uni_common_ringbuffer_span_t spans[2]{};
+        REQUIRE(uni_common_ringbuffer_view(&ctx, spans) == 1U);
+        REQUIRE(spans[0].count == capacity);
+
+        // bulk copies and search see the same data
+        std::vector<uint8_t> chunk_r(capacity * size_object);
+        REQUIRE(uni_common_ringbuffer_pop(&ctx, chunk_r.data(), capacity) == capacity);
+        REQUIRE(memcmp(chunk_r.data(), region_r, chunk_r.size()) == 0);
+
+        REQUIRE(uni_common_ringbuffer_mirror_destroy(&ctx));
+    }
+}
+
+#endif
@@ -0,0 +1,88 @@
+//
+// Includes
+//
+
+// stdlib
+#include <cstring>
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    /**
+     * Writes frames of varying length (2-byte length prefix + payload), then parses them in place where possible
+     */
+    uint64_t ringbuffer_mirror_bench_frames(uni_common_ringbuffer_context_t *ctx, std::vector<uint8_t> &scratch, size_t frames) {
+        uint64_t checksum = 0;
+
+        for (size_t frame = 0; frame < frames; frame++) {
+            uint16_t len = (uint16_t)(200U + (frame * 397U) % 1300U);
+
+            uint8_t header[2];
+            memcpy(header, &len, sizeof(len));
+            uni_common_ringbuffer_push_ex(ctx, header, sizeof(header), false);
+            uni_common_ringbuffer_push_ex(ctx, scratch.data(), len, false);
+
+            // frame is parsed in place when it is contiguous, otherwise it is copied out
+            const uint8_t *region = nullptr;
+            size_t peeked = uni_common_ringbuffer_peek(ctx, sizeof(header) + len, &region);
+            if (peeked == sizeof(header) + len) {
+                checksum += region[sizeof(header) + len - 1U];
+                uni_common_ringbuffer_consume(ctx, peeked);
+            } else {
+                uni_common_ringbuffer_pop(ctx, scratch.data(), sizeof(header) + len);
+                checksum += scratch[sizeof(header) + len - 1U];
+            }
+        }
+
+        return checksum;
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+#if defined(__linux__)
+
+TEST_CASE("ringbuffer_mirror_bench_frames", "[.][benchmark][ringbuffer_mirror]") {
+    size_t size_total = 16U * uni_common_ringbuffer_mirror_granularity();
+    std::vector<uint8_t> scratch(2048U, 0x5AU);
+
+    {
+        std::vector<uint8_t> buf(size_total);
+        uni_common_ringbuffer_context_t ctx{};
+        uni_common_ringbuffer_init_pow2(&ctx, buf.data(), 1U, size_total);
+
+        BENCHMARK("frames-1000/plain/" + std::to_string(size_total)) {
+            return ringbuffer_mirror_bench_frames(&ctx, scratch, 1000U);
+        };
+    }
+
+    {
+        uni_common_ringbuffer_context_t ctx{};
+        uni_common_ringbuffer_mirror_create(&ctx, 1U, size_total);
+
+        BENCHMARK("frames-1000/mirror/" + std::to_string(size_total)) {
+            return ringbuffer_mirror_bench_frames(&ctx, scratch, 1000U);
+        };
+
+        uni_common_ringbuffer_mirror_destroy(&ctx);
+    }
+}
+
+#endif
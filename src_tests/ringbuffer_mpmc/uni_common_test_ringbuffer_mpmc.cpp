@@ -0,0 +1,135 @@
+//
+// Includes
+//
+
+// stdlib
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("ringbuffer_mpmc_init", "[ringbuffer_mpmc]") {
+    uint8_t data[64]{};
+    _Atomic(size_t) seqs[16]{};
+    uni_common_ringbuffer_mpmc_context_t ctx{};
+
+    REQUIRE_FALSE(uni_common_ringbuffer_mpmc_init(nullptr, data, seqs, 4U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_mpmc_init(&ctx, nullptr, seqs, 4U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_mpmc_init(&ctx, data, nullptr, 4U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_mpmc_init(&ctx, data, seqs, 0U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_mpmc_init(&ctx, data, seqs, 4U, 12U * 4U));
+    REQUIRE_FALSE(uni_common_ringbuffer_mpmc_init(&ctx, data, seqs, 4U, 4U));
+    REQUIRE(uni_common_ringbuffer_mpmc_init(&ctx, data, seqs, 4U, sizeof(data)));
+
+    REQUIRE(uni_common_ringbuffer_mpmc_capacity(&ctx) == 16U);
+    REQUIRE(uni_common_ringbuffer_mpmc_length(&ctx) == 0U);
+}
+
+
+TEST_CASE("ringbuffer_mpmc_push_pop", "[ringbuffer_mpmc]") {
+    uint32_t data[8]{};
+    _Atomic(size_t) seqs[8]{};
+    uni_common_ringbuffer_mpmc_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_mpmc_init(&ctx, (uint8_t *)data, seqs, sizeof(uint32_t), sizeof(data)));
+
+    SECTION("back-pressure") {
+        uint32_t items[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        REQUIRE(uni_common_ringbuffer_mpmc_push(&ctx, (uint8_t *)items, 5U) == 5U);
+        REQUIRE(uni_common_ringbuffer_mpmc_push(&ctx, (uint8_t *)&items[5], 5U) == 3U);
+        REQUIRE(uni_common_ringbuffer_mpmc_length(&ctx) == 8U);
+        REQUIRE(uni_common_ringbuffer_mpmc_push(&ctx, (uint8_t *)items, 1U) == 0U);
+
+        uint32_t items_r[10]{};
+        REQUIRE(uni_common_ringbuffer_mpmc_pop(&ctx, (uint8_t *)items_r, 10U) == 8U);
+        REQUIRE(memcmp(items, items_r, 8U * sizeof(uint32_t)) == 0);
+        REQUIRE(uni_common_ringbuffer_mpmc_pop(&ctx, (uint8_t *)items_r, 1U) == 0U);
+        REQUIRE(uni_common_ringbuffer_mpmc_length(&ctx) == 0U);
+    }
+
+    SECTION("wrap") {
+        uint32_t counter_push = 0;
+        uint32_t counter_pop = 0;
+
+        for (size_t iter = 0; iter < 100; iter++) {
+            uint32_t items[5];
+            for (auto &item : items) {
+                item = counter_push++;
+            }
+            REQUIRE(uni_common_ringbuffer_mpmc_push(&ctx, (uint8_t *)items, 5U) == 5U);
+
+            uint32_t items_r[5]{};
+            REQUIRE(uni_common_ringbuffer_mpmc_pop(&ctx, (uint8_t *)items_r, 5U) == 5U);
+            for (auto item : items_r) {
+                REQUIRE(item == counter_pop++);
+            }
+        }
+
+        REQUIRE(uni_common_ringbuffer_mpmc_clear(&ctx));
+        REQUIRE(uni_common_ringbuffer_mpmc_length(&ctx) == 0U);
+    }
+}
+
+
+TEST_CASE("ringbuffer_mpmc_threads", "[ringbuffer_mpmc]") {
+    constexpr size_t threads = 4U;
+    constexpr uint64_t count = 50000U;
+
+    std::vector<uint64_t> data(64);
+    std::vector<_Atomic(size_t)> seqs(64);
+    uni_common_ringbuffer_mpmc_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_mpmc_init(&ctx, (uint8_t *)data.data(), seqs.data(), sizeof(uint64_t),
+                                            data.size() * sizeof(uint64_t)));
+
+    // every producer pushes its own range, every value must be popped exactly once
+    std::vector<std::atomic<uint8_t>> seen(threads * count);
+    std::atomic<uint64_t> popped{0};
+    std::vector<std::thread> workers;
+
+    for (size_t thread = 0; thread < threads; thread++) {
+        workers.emplace_back([&ctx, thread]() {
+            for (uint64_t value = thread * count; value < (thread + 1) * count;) {
+                if (uni_common_ringbuffer_mpmc_push(&ctx, (uint8_t *)&value, 1U) == 1U) {
+                    value++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        workers.emplace_back([&ctx, &seen, &popped]() {
+            while (popped.load() < threads * count) {
+                uint64_t value = 0;
+                if (uni_common_ringbuffer_mpmc_pop(&ctx, (uint8_t *)&value, 1U) == 1U) {
+                    seen[value]++;
+                    popped++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    bool exactly_once = true;
+    for (auto &flag : seen) {
+        exactly_once = exactly_once && flag.load() == 1U;
+    }
+    REQUIRE(exactly_once);
+    REQUIRE(uni_common_ringbuffer_mpmc_length(&ctx) == 0U);
+}
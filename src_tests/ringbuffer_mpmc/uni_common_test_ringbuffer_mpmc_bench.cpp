@@ -0,0 +1,108 @@
+//
+// Includes
+//
+
+// stdlib
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct ringbuffer_mpmc_bench {
+        std::vector<uint64_t> buf;
+        std::vector<_Atomic(size_t)> seqs;
+        uni_common_ringbuffer_mpmc_context_t ctx{};
+
+        explicit ringbuffer_mpmc_bench(size_t capacity) : buf(capacity), seqs(capacity) {
+            uni_common_ringbuffer_mpmc_init(&ctx, (uint8_t *)buf.data(), seqs.data(), sizeof(uint64_t),
+                                            capacity * sizeof(uint64_t));
+        }
+    };
+
+
+    /**
+     * Moves :count objects through the queue with :threads producers and :threads consumers
+     */
+    uint64_t ringbuffer_mpmc_bench_transfer(uni_common_ringbuffer_mpmc_context_t *ctx, size_t threads, uint64_t count) {
+        std::atomic<uint64_t> checksum{0};
+        std::vector<std::thread> workers;
+        uint64_t count_thread = count / threads;
+
+        for (size_t thread = 0; thread < threads; thread++) {
+            workers.emplace_back([ctx, count_thread]() {
+                for (uint64_t value = 0; value < count_thread;) {
+                    if (uni_common_ringbuffer_mpmc_push(ctx, (uint8_t *)&value, 1U) == 1U) {
+                        value++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+
+            workers.emplace_back([ctx, count_thread, &checksum]() {
+                uint64_t sum = 0;
+                for (uint64_t received = 0; received < count_thread;) {
+                    uint64_t value = 0;
+                    if (uni_common_ringbuffer_mpmc_pop(ctx, (uint8_t *)&value, 1U) == 1U) {
+                        sum += value;
+                        received++;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                checksum += sum;
+            });
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+
+        return checksum.load();
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ringbuffer_mpmc_bench_scaling", "[.][benchmark][ringbuffer_mpmc]") {
+    constexpr uint64_t count = 400000U;
+
+    size_t threads_max = std::max<size_t>(std::thread::hardware_concurrency() / 2U, 1U);
+    for (size_t threads = 1U; threads <= std::max<size_t>(threads_max, 4U); threads *= 2U) {
+        ringbuffer_mpmc_bench bench(1024U);
+
+        BENCHMARK("transfer-400k/threads-" + std::to_string(threads) + "x" + std::to_string(threads)) {
+            return ringbuffer_mpmc_bench_transfer(&bench.ctx, threads, count);
+        };
+    }
+}
+
+
+TEST_CASE("ringbuffer_mpmc_bench_uncontended", "[.][benchmark][ringbuffer_mpmc]") {
+    ringbuffer_mpmc_bench bench(1024U);
+
+    uint64_t value = 0;
+    BENCHMARK("push-pop") {
+        uni_common_ringbuffer_mpmc_push(&bench.ctx, (uint8_t *)&value, 1U);
+        return uni_common_ringbuffer_mpmc_pop(&bench.ctx, (uint8_t *)&value, 1U);
+    };
+}
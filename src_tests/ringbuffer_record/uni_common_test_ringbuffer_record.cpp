@@ -0,0 +1,200 @@
+//
+// Includes
+//
+
+// stdlib
+#include <cstring>
+#include <deque>
+#include <random>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("ringbuffer_record_init", "[ringbuffer_record]") {
+    alignas(16) uint8_t data[256]{};
+    uni_common_ringbuffer_record_context_t ctx{};
+
+    REQUIRE_FALSE(uni_common_ringbuffer_record_init(nullptr, data, sizeof(data), 8U));
+    REQUIRE_FALSE(uni_common_ringbuffer_record_init(&ctx, nullptr, sizeof(data), 8U));
+    REQUIRE_FALSE(uni_common_ringbuffer_record_init(&ctx, data, sizeof(data), 0U));
+    REQUIRE_FALSE(uni_common_ringbuffer_record_init(&ctx, data, sizeof(data), 12U));
+    REQUIRE_FALSE(uni_common_ringbuffer_record_init(&ctx, data, 100U, 8U));
+    REQUIRE(uni_common_ringbuffer_record_init(&ctx, data, sizeof(data), 1U));
+    REQUIRE(ctx.align == sizeof(uint32_t));
+    REQUIRE(uni_common_ringbuffer_record_size_max(&ctx) == sizeof(data) - sizeof(uint32_t));
+
+    REQUIRE(uni_common_ringbuffer_record_init(&ctx, data, sizeof(data), 16U));
+    REQUIRE(uni_common_ringbuffer_record_is_empty(&ctx));
+    REQUIRE(uni_common_ringbuffer_record_used(&ctx) == 0U);
+    REQUIRE(uni_common_ringbuffer_record_size_max(&ctx) == sizeof(data) - 16U);
+}
+
+
+TEST_CASE("ringbuffer_record_push_pop", "[ringbuffer_record]") {
+    alignas(8) uint8_t data[64]{};
+    uni_common_ringbuffer_record_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_record_init(&ctx, data, sizeof(data), 8U));
+
+    const uint8_t message_a[] = "hello";
+    const uint8_t message_b[] = "variable-length";
+
+    SECTION("fifo") {
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, message_a, sizeof(message_a), false));
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, message_b, sizeof(message_b), false));
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, nullptr, 0U, false));
+        REQUIRE(uni_common_ringbuffer_record_count(&ctx) == 3U);
+
+        // 8-byte header + 8-byte payload, 8 + 16, 8 + 0
+        REQUIRE(uni_common_ringbuffer_record_used(&ctx) == 48U);
+
+        const uint8_t *payload = nullptr;
+        size_t size = 0U;
+        REQUIRE(uni_common_ringbuffer_record_peek(&ctx, &payload, &size));
+        REQUIRE(size == sizeof(message_a));
+        REQUIRE(memcmp(payload, message_a, size) == 0);
+        REQUIRE((uintptr_t)payload % 8U == 0U);
+
+        // too small receive buffer keeps the record
+        uint8_t buf[32]{};
+        REQUIRE_FALSE(uni_common_ringbuffer_record_pop(&ctx, buf, 2U, &size));
+        REQUIRE(uni_common_ringbuffer_record_pop(&ctx, buf, sizeof(buf), &size));
+        REQUIRE(size == sizeof(message_a));
+        REQUIRE(memcmp(buf, message_a, size) == 0);
+
+        REQUIRE(uni_common_ringbuffer_record_pop(&ctx, buf, sizeof(buf), &size));
+        REQUIRE(size == sizeof(message_b));
+        REQUIRE(memcmp(buf, message_b, size) == 0);
+
+        REQUIRE(uni_common_ringbuffer_record_pop(&ctx, nullptr, 0U, &size));
+        REQUIRE(size == 0U);
+        REQUIRE(uni_common_ringbuffer_record_is_empty(&ctx));
+        REQUIRE_FALSE(uni_common_ringbuffer_record_pop(&ctx, buf, sizeof(buf), &size));
+    }
+
+    SECTION("full") {
+        uint8_t big[56]{};
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, big, sizeof(big), false));
+        REQUIRE_FALSE(uni_common_ringbuffer_record_push(&ctx, big, sizeof(big) + 1U, true));
+        REQUIRE_FALSE(uni_common_ringbuffer_record_push(&ctx, message_a, sizeof(message_a), false));
+
+        // overwrite drops the oldest record
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, message_a, sizeof(message_a), true));
+        REQUIRE(uni_common_ringbuffer_record_count(&ctx) == 1U);
+
+        const uint8_t *payload = nullptr;
+        size_t size = 0U;
+        REQUIRE(uni_common_ringbuffer_record_peek(&ctx, &payload, &size));
+        REQUIRE(size == sizeof(message_a));
+    }
+
+    SECTION("wrap-padding") {
+        uint8_t record[20]{};
+
+        // 32-byte and 24-byte records, then the first one is gone and 8-byte tail is left
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, record, 20U, false));
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, record, 12U, false));
+        REQUIRE(uni_common_ringbuffer_record_pop(&ctx, nullptr, 0U, nullptr));
+        REQUIRE(uni_common_ringbuffer_record_used(&ctx) == 24U);
+
+        // 32-byte record does not fit into the tail, the tail becomes padding
+        record[0] = 0xAB;
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, record, 20U, false));
+        REQUIRE(uni_common_ringbuffer_record_used(&ctx) == 64U);
+        REQUIRE_FALSE(uni_common_ringbuffer_record_push(&ctx, nullptr, 0U, false));
+        REQUIRE(uni_common_ringbuffer_record_pop(&ctx, nullptr, 0U, nullptr));
+
+        const uint8_t *payload = nullptr;
+        size_t size = 0U;
+        REQUIRE(uni_common_ringbuffer_record_peek(&ctx, &payload, &size));
+        REQUIRE(size == 20U);
+        REQUIRE(payload == &data[8]);
+        REQUIRE(payload[0] == 0xAB);
+        REQUIRE(uni_common_ringbuffer_record_pop(&ctx, nullptr, 0U, nullptr));
+        REQUIRE(uni_common_ringbuffer_record_used(&ctx) == 0U);
+    }
+}
+
+
+TEST_CASE("ringbuffer_record_wrap", "[ringbuffer_record]") {
+    // size_total is not power of two, positions must stay inside of the data array instead of wrapping the counters
+    alignas(8) uint8_t data[48]{};
+    uni_common_ringbuffer_record_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_record_init(&ctx, data, sizeof(data), 8U));
+
+    uint8_t expected = 0U;
+    for (uint8_t value = 0U; value < 250U; value++) {
+        uint8_t record[20];
+        memset(record, value, sizeof(record));
+        REQUIRE(uni_common_ringbuffer_record_push(&ctx, record, 1U + value % sizeof(record), true));
+        REQUIRE(ctx.pos_front < sizeof(data));
+        REQUIRE(ctx.pos_back < sizeof(data));
+
+        if (value % 3U == 2U) {
+            uint8_t buf[20]{};
+            size_t size = 0U;
+            REQUIRE(uni_common_ringbuffer_record_pop(&ctx, buf, sizeof(buf), &size));
+            REQUIRE(buf[0] >= expected);
+            expected = buf[0] + 1U;
+            REQUIRE(size == 1U + buf[0] % sizeof(record));
+        }
+    }
+
+    REQUIRE(uni_common_ringbuffer_record_clear(&ctx));
+    REQUIRE(uni_common_ringbuffer_record_used(&ctx) == 0U);
+}
+
+
+TEST_CASE("ringbuffer_record_random", "[ringbuffer_record]") {
+    for (bool overwrite : {false, true}) {
+        alignas(16) uint8_t data[512]{};
+        uni_common_ringbuffer_record_context_t ctx{};
+        REQUIRE(uni_common_ringbuffer_record_init(&ctx, data, sizeof(data), 16U));
+
+        std::mt19937 rng(7);
+        std::deque<std::vector<uint8_t>> reference;
+        uint8_t counter = 0;
+
+        for (size_t iter = 0; iter < 5000; iter++) {
+            if (rng() % 3U != 0U) {
+                std::vector<uint8_t> record(rng() % 120U);
+                for (auto &byte : record) {
+                    byte = counter++;
+                }
+
+                bool pushed = uni_common_ringbuffer_record_push(&ctx, record.data(), record.size(), overwrite);
+                if (overwrite) {
+                    REQUIRE(pushed);
+                    while (reference.size() + 1U > uni_common_ringbuffer_record_count(&ctx)) {
+                        reference.pop_front();
+                    }
+                }
+                if (pushed) {
+                    reference.push_back(record);
+                }
+            } else {
+                uint8_t buf[128]{};
+                size_t size = 0U;
+                bool popped = uni_common_ringbuffer_record_pop(&ctx, buf, sizeof(buf), &size);
+                REQUIRE(popped == !reference.empty());
+                if (popped) {
+                    REQUIRE(size == reference.front().size());
+                    REQUIRE((size == 0U || memcmp(buf, reference.front().data(), size) == 0));
+                    reference.pop_front();
+                }
+            }
+
+            REQUIRE(uni_common_ringbuffer_record_count(&ctx) == reference.size());
+            REQUIRE(uni_common_ringbuffer_record_used(&ctx) <= sizeof(data));
+        }
+    }
+}
@@ -0,0 +1,74 @@
+//
+// Includes
+//
+
+// stdlib
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ringbuffer_record_bench_messages", "[.][benchmark][ringbuffer_record]") {
+    // log messages of 32..512 bytes, mostly short ones
+    std::vector<size_t> sizes;
+    uint32_t seed = 1;
+    for (size_t idx = 0; idx < 1024U; idx++) {
+        seed = seed * 1103515245U + 12345U;
+        size_t size = 32U + (seed >> 16U) % 96U;
+        if (idx % 16U == 0U) {
+            size = 512U;
+        }
+        sizes.push_back(size);
+    }
+    std::vector<uint8_t> message(512U, 0x5AU);
+
+    constexpr size_t size_total = 64U * 1024U;
+
+    // fixed-size ringbuffer pads every message to the maximum
+    {
+        std::vector<uint8_t> buf(size_total);
+        uni_common_ringbuffer_context_t ctx{};
+        uni_common_ringbuffer_init_pow2(&ctx, buf.data(), 512U, size_total);
+
+        size_t idx = 0;
+        BENCHMARK("push-pop/fixed-512") {
+            idx = (idx + 1U) % sizes.size();
+            uni_common_ringbuffer_push(&ctx, message.data(), 1U);
+            return uni_common_ringbuffer_pop(&ctx, message.data(), 1U);
+        };
+
+        WARN("fixed-512 stores " << size_total / 512U << " messages in " << size_total << " bytes");
+    }
+
+    for (size_t align : {4U, 16U}) {
+        std::vector<uint8_t> buf(size_total);
+        uni_common_ringbuffer_record_context_t ctx{};
+        uni_common_ringbuffer_record_init(&ctx, buf.data(), size_total, align);
+
+        size_t idx = 0;
+        BENCHMARK("push-pop/record-align-" + std::to_string(align)) {
+            idx = (idx + 1U) % sizes.size();
+            uni_common_ringbuffer_record_push(&ctx, message.data(), sizes[idx], true);
+            return uni_common_ringbuffer_record_pop(&ctx, message.data(), message.size(), nullptr);
+        };
+
+        // fill with overwrite and count how many messages fit
+        uni_common_ringbuffer_record_clear(&ctx);
+        for (size_t fill = 0; fill < 4U * sizes.size(); fill++) {
+            uni_common_ringbuffer_record_push(&ctx, message.data(), sizes[fill % sizes.size()], true);
+        }
+        WARN("record-align-" << align << " stores " << uni_common_ringbuffer_record_count(&ctx) << " messages in "
+                             << size_total << " bytes");
+    }
+}
@@ -0,0 +1,128 @@
+//
+// Includes
+//
+
+// stdlib
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("ringbuffer_spsc_init", "[ringbuffer_spsc]") {
+    uint8_t data[64]{};
+    uni_common_ringbuffer_spsc_context_t ctx{};
+
+    REQUIRE_FALSE(uni_common_ringbuffer_spsc_init(nullptr, data, 4U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_spsc_init(&ctx, nullptr, 4U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_spsc_init(&ctx, data, 0U, sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_spsc_init(&ctx, data, 4U, 12U * 4U));
+    REQUIRE(uni_common_ringbuffer_spsc_init(&ctx, data, 4U, sizeof(data)));
+
+    REQUIRE(uni_common_ringbuffer_spsc_capacity(&ctx) == 16U);
+    REQUIRE(uni_common_ringbuffer_spsc_is_empty(&ctx));
+    REQUIRE(uni_common_ringbuffer_spsc_length(&ctx) == 0U);
+
+    // indices must not share the cache line
+    REQUIRE(offsetof(uni_common_ringbuffer_spsc_context_t, pos_front) -
+            offsetof(uni_common_ringbuffer_spsc_context_t, pos_back) >= UNI_COMMON_COMPILER_CACHELINE);
+}
+
+
+TEST_CASE("ringbuffer_spsc_push_pop", "[ringbuffer_spsc]") {
+    uint32_t data[8]{};
+    uni_common_ringbuffer_spsc_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_spsc_init(&ctx, (uint8_t *)data, sizeof(uint32_t), sizeof(data)));
+
+    SECTION("back-pressure") {
+        uint32_t items[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        REQUIRE(uni_common_ringbuffer_spsc_push(&ctx, (uint8_t *)items, 5U) == 5U);
+        REQUIRE(uni_common_ringbuffer_spsc_push(&ctx, (uint8_t *)&items[5], 5U) == 3U);
+        REQUIRE(uni_common_ringbuffer_spsc_length(&ctx) == 8U);
+        REQUIRE(uni_common_ringbuffer_spsc_push(&ctx, (uint8_t *)items, 1U) == 0U);
+
+        uint32_t items_r[10]{};
+        REQUIRE(uni_common_ringbuffer_spsc_pop(&ctx, (uint8_t *)items_r, 10U) == 8U);
+        REQUIRE(memcmp(items, items_r, 8U * sizeof(uint32_t)) == 0);
+        REQUIRE(uni_common_ringbuffer_spsc_pop(&ctx, (uint8_t *)items_r, 1U) == 0U);
+        REQUIRE(uni_common_ringbuffer_spsc_is_empty(&ctx));
+    }
+
+    SECTION("wrap") {
+        uint32_t counter_push = 0;
+        uint32_t counter_pop = 0;
+
+        for (size_t iter = 0; iter < 100; iter++) {
+            uint32_t items[5];
+            for (auto &item : items) {
+                item = counter_push++;
+            }
+            REQUIRE(uni_common_ringbuffer_spsc_push(&ctx, (uint8_t *)items, 5U) == 5U);
+
+            uint32_t items_r[5]{};
+            REQUIRE(uni_common_ringbuffer_spsc_pop(&ctx, (uint8_t *)items_r, 5U) == 5U);
+            for (auto item : items_r) {
+                REQUIRE(item == counter_pop++);
+            }
+        }
+
+        REQUIRE(uni_common_ringbuffer_spsc_clear(&ctx));
+        REQUIRE(uni_common_ringbuffer_spsc_is_empty(&ctx));
+    }
+}
+
+
+TEST_CASE("ringbuffer_spsc_threads", "[ringbuffer_spsc]") {
+    constexpr uint64_t count = 200000U;
+
+    std::vector<uint64_t> data(64);
+    uni_common_ringbuffer_spsc_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_spsc_init(&ctx, (uint8_t *)data.data(), sizeof(uint64_t), data.size() * sizeof(uint64_t)));
+
+    std::thread producer([&ctx]() {
+        uint64_t chunk[7];
+        uint64_t value = 0;
+        while (value < count) {
+            size_t chunk_len = 0;
+            for (; chunk_len < 7 && value + chunk_len < count; chunk_len++) {
+                chunk[chunk_len] = value + chunk_len;
+            }
+
+            size_t pushed = uni_common_ringbuffer_spsc_push(&ctx, (uint8_t *)chunk, chunk_len);
+            value += pushed;
+            if (pushed == 0U) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // objects must arrive in order without loss or duplication
+    bool ordered = true;
+    uint64_t expected = 0;
+    uint64_t chunk[5];
+    while (expected < count) {
+        size_t popped = uni_common_ringbuffer_spsc_pop(&ctx, (uint8_t *)chunk, 5U);
+        for (size_t idx = 0; idx < popped; idx++) {
+            ordered = ordered && chunk[idx] == expected;
+            expected++;
+        }
+        if (popped == 0U) {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(uni_common_ringbuffer_spsc_is_empty(&ctx));
+}
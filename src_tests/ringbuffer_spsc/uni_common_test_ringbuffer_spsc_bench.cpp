@@ -0,0 +1,127 @@
+//
+// Includes
+//
+
+// stdlib
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct ringbuffer_spsc_bench {
+        std::vector<uint64_t> buf;
+        uni_common_ringbuffer_spsc_context_t ctx{};
+
+        explicit ringbuffer_spsc_bench(size_t capacity) : buf(capacity) {
+            uni_common_ringbuffer_spsc_init(&ctx, (uint8_t *)buf.data(), sizeof(uint64_t), capacity * sizeof(uint64_t));
+        }
+    };
+
+
+    /**
+     * Moves :count objects from the producer thread to the calling thread in chunks of :batch objects
+     */
+    uint64_t ringbuffer_spsc_bench_transfer(uni_common_ringbuffer_spsc_context_t *ctx, uint64_t count, size_t batch) {
+        std::thread producer([ctx, count, batch]() {
+            std::vector<uint64_t> chunk(batch);
+            uint64_t value = 0;
+            while (value < count) {
+                size_t chunk_len = std::min<uint64_t>(batch, count - value);
+                for (size_t idx = 0; idx < chunk_len; idx++) {
+                    chunk[idx] = value + idx;
+                }
+
+                size_t pushed = uni_common_ringbuffer_spsc_push(ctx, (uint8_t *)chunk.data(), chunk_len);
+                value += pushed;
+                if (pushed == 0U) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::vector<uint64_t> chunk(batch);
+        uint64_t received = 0;
+        uint64_t checksum = 0;
+        while (received < count) {
+            size_t popped = uni_common_ringbuffer_spsc_pop(ctx, (uint8_t *)chunk.data(), batch);
+            for (size_t idx = 0; idx < popped; idx++) {
+                checksum += chunk[idx];
+            }
+            received += popped;
+            if (popped == 0U) {
+                std::this_thread::yield();
+            }
+        }
+
+        producer.join();
+        return checksum;
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ringbuffer_spsc_bench_throughput", "[.][benchmark][ringbuffer_spsc]") {
+    constexpr uint64_t count = 1000000U;
+
+    for (size_t batch : {1U, 16U, 256U}) {
+        ringbuffer_spsc_bench bench(1024U);
+
+        BENCHMARK("transfer-1M/batch-" + std::to_string(batch)) {
+            return ringbuffer_spsc_bench_transfer(&bench.ctx, count, batch);
+        };
+    }
+}
+
+
+TEST_CASE("ringbuffer_spsc_bench_latency", "[.][benchmark][ringbuffer_spsc]") {
+    // ping-pong through two rings, one round trip is two one-way hand-offs
+    ringbuffer_spsc_bench ping(64U);
+    ringbuffer_spsc_bench pong(64U);
+    std::atomic<bool> running{true};
+
+    std::thread echo([&]() {
+        uint64_t value = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            if (uni_common_ringbuffer_spsc_pop(&ping.ctx, (uint8_t *)&value, 1U) == 1U) {
+                while (uni_common_ringbuffer_spsc_push(&pong.ctx, (uint8_t *)&value, 1U) == 0U) {
+                    std::this_thread::yield();
+                }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t value = 0;
+    BENCHMARK("round-trip") {
+        value++;
+        uni_common_ringbuffer_spsc_push(&ping.ctx, (uint8_t *)&value, 1U);
+        uint64_t value_r = 0;
+        while (uni_common_ringbuffer_spsc_pop(&pong.ctx, (uint8_t *)&value_r, 1U) == 0U) {
+            std::this_thread::yield();
+        }
+        return value_r;
+    };
+
+    running.store(false);
+    echo.join();
+}
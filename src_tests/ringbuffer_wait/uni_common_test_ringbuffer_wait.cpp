@@ -0,0 +1,190 @@
+//
+// Includes
+//
+
+// stdlib
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("ringbuffer_wait_init", "[ringbuffer_wait]") {
+    uint64_t data[16]{};
+    uni_common_ringbuffer_spsc_context_t ring{};
+    uni_common_ringbuffer_wait_context_t ctx{};
+
+    REQUIRE_FALSE(uni_common_ringbuffer_wait_init(&ctx, &ring));
+    REQUIRE(uni_common_ringbuffer_spsc_init(&ring, (uint8_t *)data, sizeof(uint64_t), sizeof(data)));
+    REQUIRE_FALSE(uni_common_ringbuffer_wait_init(nullptr, &ring));
+    REQUIRE_FALSE(uni_common_ringbuffer_wait_init(&ctx, nullptr));
+
+    uni_common_ringbuffer_wait_config_t config{};
+    config.ring = &ring;
+    config.wake_batch = 0U;
+    REQUIRE_FALSE(uni_common_ringbuffer_wait_init_ex(&ctx, &config));
+    config.wake_batch = 4U;
+    REQUIRE(uni_common_ringbuffer_wait_init_ex(&ctx, &config));
+    REQUIRE(uni_common_ringbuffer_wait_init(&ctx, &ring));
+    REQUIRE(uni_common_ringbuffer_wait_count_park(&ctx) == 0U);
+    REQUIRE(uni_common_ringbuffer_wait_count_wake(&ctx) == 0U);
+}
+
+
+TEST_CASE("ringbuffer_wait_pop", "[ringbuffer_wait]") {
+    uint64_t data[16]{};
+    uni_common_ringbuffer_spsc_context_t ring{};
+    uni_common_ringbuffer_wait_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_spsc_init(&ring, (uint8_t *)data, sizeof(uint64_t), sizeof(data)));
+    REQUIRE(uni_common_ringbuffer_wait_init(&ctx, &ring));
+
+    uint64_t items[4] = {1, 2, 3, 4};
+    uint64_t items_r[4]{};
+
+    SECTION("ready") {
+        REQUIRE(uni_common_ringbuffer_wait_push(&ctx, (uint8_t *)items, 4U) == 4U);
+        REQUIRE(uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)items_r, 4U, 0U) == 4U);
+        REQUIRE(items_r[3] == 4U);
+
+        // nobody is parked, so there is nothing to wake
+        REQUIRE(uni_common_ringbuffer_wait_count_wake(&ctx) == 0U);
+        REQUIRE_FALSE(uni_common_ringbuffer_wait_flush(&ctx));
+    }
+
+    SECTION("timeout") {
+        REQUIRE(uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)items_r, 4U, 0U) == 0U);
+
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)items_r, 4U, 5000000U) == 0U);
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(5));
+        REQUIRE(uni_common_ringbuffer_wait_count_park(&ctx) != 0U);
+    }
+}
+
+
+TEST_CASE("ringbuffer_wait_wake", "[ringbuffer_wait]") {
+    uint64_t data[64]{};
+    uni_common_ringbuffer_spsc_context_t ring{};
+    uni_common_ringbuffer_wait_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_spsc_init(&ring, (uint8_t *)data, sizeof(uint64_t), sizeof(data)));
+
+    uni_common_ringbuffer_wait_config_t config{};
+    config.ring = &ring;
+    config.spin_count = 16U;
+    config.yield_count = 1U;
+
+    SECTION("single") {
+        config.wake_batch = 1U;
+        REQUIRE(uni_common_ringbuffer_wait_init_ex(&ctx, &config));
+
+        std::thread producer([&ctx]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            uint64_t item = 42U;
+            uni_common_ringbuffer_wait_push(&ctx, (uint8_t *)&item, 1U);
+        });
+
+        uint64_t item_r = 0U;
+        REQUIRE(uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)&item_r, 1U, UNI_COMMON_RINGBUFFER_WAIT_INFINITE) == 1U);
+        REQUIRE(item_r == 42U);
+        producer.join();
+
+        REQUIRE(uni_common_ringbuffer_wait_count_park(&ctx) != 0U);
+    }
+
+    SECTION("batch") {
+        // consumer stays parked until the whole batch is available
+        config.wake_batch = 8U;
+        REQUIRE(uni_common_ringbuffer_wait_init_ex(&ctx, &config));
+
+        std::thread producer([&ctx]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            for (uint64_t item = 0; item < 8U; item++) {
+                uni_common_ringbuffer_wait_push(&ctx, (uint8_t *)&item, 1U);
+            }
+        });
+
+        uint64_t items_r[16]{};
+        REQUIRE(uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)items_r, 16U, UNI_COMMON_RINGBUFFER_WAIT_INFINITE) == 8U);
+        producer.join();
+        REQUIRE(items_r[7] == 7U);
+        REQUIRE(uni_common_ringbuffer_wait_count_wake(&ctx) <= 1U);
+    }
+
+    SECTION("park-limit") {
+        // unfinished batch is picked up after park_ns even without flush
+        config.wake_batch = 8U;
+        config.park_ns = 2000000U;
+        REQUIRE(uni_common_ringbuffer_wait_init_ex(&ctx, &config));
+
+        std::thread producer([&ctx]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            uint64_t item = 7U;
+            uni_common_ringbuffer_wait_push(&ctx, (uint8_t *)&item, 1U);
+        });
+
+        uint64_t item_r = 0U;
+        REQUIRE(uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)&item_r, 1U, UNI_COMMON_RINGBUFFER_WAIT_INFINITE) == 1U);
+        REQUIRE(item_r == 7U);
+        producer.join();
+    }
+}
+
+
+TEST_CASE("ringbuffer_wait_threads", "[ringbuffer_wait]") {
+    constexpr uint64_t count = 200000U;
+
+    std::vector<uint64_t> data(256);
+    uni_common_ringbuffer_spsc_context_t ring{};
+    uni_common_ringbuffer_wait_context_t ctx{};
+    REQUIRE(uni_common_ringbuffer_spsc_init(&ring, (uint8_t *)data.data(), sizeof(uint64_t), data.size() * sizeof(uint64_t)));
+
+    uni_common_ringbuffer_wait_config_t config{};
+    config.ring = &ring;
+    config.spin_count = 64U;
+    config.yield_count = 4U;
+    config.wake_batch = 16U;
+    REQUIRE(uni_common_ringbuffer_wait_init_ex(&ctx, &config));
+
+    std::thread producer([&ctx]() {
+        uint64_t value = 0;
+        while (value < count) {
+            uint64_t chunk[8];
+            size_t chunk_len = count - value < 8U ? (size_t)(count - value) : 8U;
+            for (size_t idx = 0; idx < chunk_len; idx++) {
+                chunk[idx] = value + idx;
+            }
+
+            size_t pushed = uni_common_ringbuffer_wait_push(&ctx, (uint8_t *)chunk, chunk_len);
+            value += pushed;
+            if (pushed == 0U) {
+                std::this_thread::yield();
+            }
+        }
+        uni_common_ringbuffer_wait_flush(&ctx);
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        uint64_t chunk[32];
+        size_t popped = uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)chunk, 32U, UNI_COMMON_RINGBUFFER_WAIT_INFINITE);
+        for (size_t idx = 0; idx < popped; idx++) {
+            ordered = ordered && chunk[idx] == expected;
+            expected++;
+        }
+    }
+    producer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(uni_common_ringbuffer_spsc_is_empty(&ring));
+}
@@ -0,0 +1,122 @@
+//
+// Includes
+//
+
+// stdlib
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct ringbuffer_wait_bench_result {
+        std::vector<uint64_t> latencies;
+        double cpu_share;
+        size_t parks;
+    };
+
+
+    uint64_t ringbuffer_wait_bench_now() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+    }
+
+
+    uint64_t ringbuffer_wait_bench_cpu() {
+        uint64_t result = 0;
+#if defined(__linux__)
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        result = (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+#endif
+        return result;
+    }
+
+
+    /**
+     * Producer sends timestamps with :gap_us pauses, consumer waits with the given strategy and records the latency
+     */
+    ringbuffer_wait_bench_result ringbuffer_wait_bench_run(uint32_t spin_count, uint32_t yield_count, size_t count, uint32_t gap_us) {
+        std::vector<uint64_t> data(1024);
+        uni_common_ringbuffer_spsc_context_t ring{};
+        uni_common_ringbuffer_spsc_init(&ring, (uint8_t *)data.data(), sizeof(uint64_t), data.size() * sizeof(uint64_t));
+
+        uni_common_ringbuffer_wait_config_t config{};
+        config.ring = &ring;
+        config.spin_count = spin_count;
+        config.yield_count = yield_count;
+        config.wake_batch = 1U;
+
+        uni_common_ringbuffer_wait_context_t ctx{};
+        uni_common_ringbuffer_wait_init_ex(&ctx, &config);
+
+        std::thread producer([&ctx, count, gap_us]() {
+            for (size_t idx = 0; idx < count; idx++) {
+                std::this_thread::sleep_for(std::chrono::microseconds(gap_us));
+                uint64_t stamp = ringbuffer_wait_bench_now();
+                uni_common_ringbuffer_wait_push(&ctx, (uint8_t *)&stamp, 1U);
+            }
+        });
+
+        ringbuffer_wait_bench_result result{};
+        result.latencies.reserve(count);
+
+        uint64_t wall_start = ringbuffer_wait_bench_now();
+        uint64_t cpu_start = ringbuffer_wait_bench_cpu();
+        while (result.latencies.size() < count) {
+            uint64_t stamp = 0;
+            if (uni_common_ringbuffer_wait_pop(&ctx, (uint8_t *)&stamp, 1U, UNI_COMMON_RINGBUFFER_WAIT_INFINITE) == 1U) {
+                result.latencies.push_back(ringbuffer_wait_bench_now() - stamp);
+            }
+        }
+        result.cpu_share = (double)(ringbuffer_wait_bench_cpu() - cpu_start) / (double)(ringbuffer_wait_bench_now() - wall_start);
+        result.parks = uni_common_ringbuffer_wait_count_park(&ctx);
+
+        producer.join();
+        std::sort(result.latencies.begin(), result.latencies.end());
+        return result;
+    }
+
+
+    void ringbuffer_wait_bench_print(const char *name, const ringbuffer_wait_bench_result &result) {
+        auto percentile = [&result](double p) {
+            return (double)result.latencies[(size_t)((double)(result.latencies.size() - 1U) * p)] / 1000.0;
+        };
+
+        std::printf("%-12s p50 %9.1f us  p90 %9.1f us  p99 %9.1f us  p99.9 %9.1f us  max %9.1f us  cpu %5.1f%%  parks %zu\n",
+                    name, percentile(0.5), percentile(0.9), percentile(0.99), percentile(0.999), percentile(1.0),
+                    result.cpu_share * 100.0, result.parks);
+    }
+}
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ringbuffer_wait_bench_latency", "[.][benchmark][ringbuffer_wait]") {
+    constexpr size_t count = 2000U;
+    constexpr uint32_t gap_us = 50U;
+
+    // consumer which never parks keeps its core busy, parked consumer trades some wakeup latency for the idle core
+    ringbuffer_wait_bench_print("spin", ringbuffer_wait_bench_run(UINT32_MAX, 0U, count, gap_us));
+    ringbuffer_wait_bench_print("yield", ringbuffer_wait_bench_run(0U, UINT32_MAX, count, gap_us));
+    ringbuffer_wait_bench_print("spin-park", ringbuffer_wait_bench_run(256U, 16U, count, gap_us));
+    ringbuffer_wait_bench_print("park", ringbuffer_wait_bench_run(0U, 0U, count, gap_us));
+}
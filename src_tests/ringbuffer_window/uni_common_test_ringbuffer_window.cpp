@@ -0,0 +1,153 @@
+//
+// Includes
+//
+
+// stdlib
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+// catch2
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Helpers
+//
+
+namespace {
+    struct ringbuffer_window_test {
+        std::vector<double> values;
+        std::vector<uni_common_ringbuffer_window_entry_t> entries_min;
+        std::vector<uni_common_ringbuffer_window_entry_t> entries_max;
+        uni_common_ringbuffer_window_context_t ctx{};
+
+        explicit ringbuffer_window_test(size_t capacity) : values(capacity), entries_min(capacity), entries_max(capacity) {
+            uni_common_ringbuffer_window_init(&ctx, values.data(), entries_min.data(), entries_max.data(), capacity);
+        }
+    };
+}
+
+
+
+//
+// Tests
+//
+
+TEST_CASE("ringbuffer_window_init", "[ringbuffer_window]") {
+    double values[4]{};
+    uni_common_ringbuffer_window_entry_t entries_min[4]{};
+    uni_common_ringbuffer_window_entry_t entries_max[4]{};
+    uni_common_ringbuffer_window_context_t ctx{};
+
+    REQUIRE_FALSE(uni_common_ringbuffer_window_init(nullptr, values, entries_min, entries_max, 4U));
+    REQUIRE_FALSE(uni_common_ringbuffer_window_init(&ctx, nullptr, entries_min, entries_max, 4U));
+    REQUIRE_FALSE(uni_common_ringbuffer_window_init(&ctx, values, nullptr, entries_max, 4U));
+    REQUIRE_FALSE(uni_common_ringbuffer_window_init(&ctx, values, entries_min, nullptr, 4U));
+    REQUIRE_FALSE(uni_common_ringbuffer_window_init(&ctx, values, entries_min, entries_max, 0U));
+    REQUIRE(uni_common_ringbuffer_window_init(&ctx, values, entries_min, entries_max, 4U));
+
+    double value = 0.0;
+    REQUIRE(uni_common_ringbuffer_window_capacity(&ctx) == 4U);
+    REQUIRE(uni_common_ringbuffer_window_length(&ctx) == 0U);
+    REQUIRE_FALSE(uni_common_ringbuffer_window_min(&ctx, &value));
+    REQUIRE_FALSE(uni_common_ringbuffer_window_max(&ctx, &value));
+    REQUIRE_FALSE(uni_common_ringbuffer_window_mean(&ctx, &value));
+    REQUIRE_FALSE(uni_common_ringbuffer_window_pop(&ctx));
+    REQUIRE(uni_common_ringbuffer_window_sum(&ctx) == 0.0);
+}
+
+
+TEST_CASE("ringbuffer_window_aggregates", "[ringbuffer_window]") {
+    ringbuffer_window_test window(4U);
+    double value = 0.0;
+
+    for (double sample : {5.0, 1.0, 3.0, 7.0}) {
+        REQUIRE(uni_common_ringbuffer_window_push(&window.ctx, sample));
+    }
+    REQUIRE(uni_common_ringbuffer_window_length(&window.ctx) == 4U);
+    REQUIRE((uni_common_ringbuffer_window_min(&window.ctx, &value) && value == 1.0));
+    REQUIRE((uni_common_ringbuffer_window_max(&window.ctx, &value) && value == 7.0));
+    REQUIRE(uni_common_ringbuffer_window_sum(&window.ctx) == 16.0);
+    REQUIRE((uni_common_ringbuffer_window_mean(&window.ctx, &value) && value == 4.0));
+
+    // 5 is evicted
+    REQUIRE(uni_common_ringbuffer_window_push(&window.ctx, 2.0));
+    REQUIRE(uni_common_ringbuffer_window_length(&window.ctx) == 4U);
+    REQUIRE(uni_common_ringbuffer_window_sum(&window.ctx) == 13.0);
+
+    // 1 and 3 are evicted
+    REQUIRE(uni_common_ringbuffer_window_pop(&window.ctx));
+    REQUIRE(uni_common_ringbuffer_window_pop(&window.ctx));
+    REQUIRE((uni_common_ringbuffer_window_min(&window.ctx, &value) && value == 2.0));
+    REQUIRE((uni_common_ringbuffer_window_max(&window.ctx, &value) && value == 7.0));
+
+    REQUIRE(uni_common_ringbuffer_window_clear(&window.ctx));
+    REQUIRE(uni_common_ringbuffer_window_length(&window.ctx) == 0U);
+    REQUIRE_FALSE(uni_common_ringbuffer_window_min(&window.ctx, &value));
+}
+
+
+TEST_CASE("ringbuffer_window_reference", "[ringbuffer_window]") {
+    for (size_t capacity : {1U, 2U, 7U, 64U}) {
+        ringbuffer_window_test window(capacity);
+        std::deque<double> reference;
+
+        uint64_t seed = 1;
+        bool matches = true;
+        for (size_t idx = 0; idx < 5000U; idx++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            double sample = (double)((seed >> 40) % 1000U) - 500.0;
+
+            // mix of size-based and explicit evictions
+            if ((seed >> 20) % 5U == 0U && !reference.empty()) {
+                uni_common_ringbuffer_window_pop(&window.ctx);
+                reference.pop_front();
+            } else {
+                uni_common_ringbuffer_window_push(&window.ctx, sample);
+                reference.push_back(sample);
+                if (reference.size() > capacity) {
+                    reference.pop_front();
+                }
+            }
+
+            double value_min = 0.0, value_max = 0.0;
+            if (reference.empty()) {
+                matches = matches && !uni_common_ringbuffer_window_min(&window.ctx, &value_min);
+            } else {
+                matches = matches && uni_common_ringbuffer_window_min(&window.ctx, &value_min) &&
+                          value_min == *std::min_element(reference.begin(), reference.end());
+                matches = matches && uni_common_ringbuffer_window_max(&window.ctx, &value_max) &&
+                          value_max == *std::max_element(reference.begin(), reference.end());
+            }
+            matches = matches && uni_common_ringbuffer_window_length(&window.ctx) == reference.size() &&
+                      uni_common_ringbuffer_window_sum(&window.ctx) == std::accumulate(reference.begin(), reference.end(), 0.0);
+        }
+        REQUIRE(matches);
+    }
+}
+
+
+TEST_CASE("ringbuffer_window_precision", "[ringbuffer_window]") {
+    ringbuffer_window_test window(16U);
+
+    // huge sample must not leave its rounding error in the sum after it was evicted
+    REQUIRE(uni_common_ringbuffer_window_push(&window.ctx, 1.0e17));
+    for (size_t idx = 0; idx < 16U; idx++) {
+        REQUIRE(uni_common_ringbuffer_window_push(&window.ctx, 0.1));
+    }
+    REQUIRE(std::fabs(uni_common_ringbuffer_window_sum(&window.ctx) - 1.6) < 1.0e-12);
+
+    // long run, the sum stays anchored
+    for (size_t idx = 0; idx < 100000U; idx++) {
+        REQUIRE(uni_common_ringbuffer_window_push(&window.ctx, idx % 2U == 0U ? 1.0e10 + 0.1 : -1.0e10));
+    }
+    double expected = 8.0 * (1.0e10 + 0.1) - 8.0 * 1.0e10;
+    REQUIRE(std::fabs(uni_common_ringbuffer_window_sum(&window.ctx) - expected) < 1.0e-5);
+}
@@ -0,0 +1,79 @@
+//
+// Includes
+//
+
+// stdlib
+#include <string>
+#include <vector>
+
+// catch2
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// uni_common
+#include "uni_common.h"
+
+
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ringbuffer_window_bench_tick", "[.][benchmark][ringbuffer_window]") {
+    for (size_t capacity : {1000U, 1000000U}) {
+        // recompute min/max/sum over the ringbuffer history on every tick
+        {
+            std::vector<double> buf(capacity);
+            uni_common_ringbuffer_context_t ctx{};
+            uni_common_ringbuffer_init(&ctx, (uint8_t *)buf.data(), sizeof(double), capacity * sizeof(double));
+
+            double sample = 0.0;
+            for (size_t idx = 0; idx < capacity; idx++) {
+                sample += 1.0;
+                uni_common_ringbuffer_push(&ctx, (const uint8_t *)&sample, 1U);
+            }
+
+            BENCHMARK("tick/recompute/" + std::to_string(capacity)) {
+                sample += 1.0;
+                uni_common_ringbuffer_push(&ctx, (const uint8_t *)&sample, 1U);
+
+                uni_common_ringbuffer_span_t spans[2];
+                size_t span_count = uni_common_ringbuffer_view(&ctx, spans);
+                double value_min = sample, value_max = sample, sum = 0.0;
+                for (size_t span = 0; span < span_count; span++) {
+                    const double *values = (const double *)spans[span].data;
+                    for (size_t idx = 0; idx < spans[span].count; idx++) {
+                        value_min = values[idx] < value_min ? values[idx] : value_min;
+                        value_max = values[idx] > value_max ? values[idx] : value_max;
+                        sum += values[idx];
+                    }
+                }
+                return value_min + value_max + sum;
+            };
+        }
+
+        // incremental window
+        {
+            std::vector<double> values(capacity);
+            std::vector<uni_common_ringbuffer_window_entry_t> entries_min(capacity), entries_max(capacity);
+            uni_common_ringbuffer_window_context_t ctx{};
+            uni_common_ringbuffer_window_init(&ctx, values.data(), entries_min.data(), entries_max.data(), capacity);
+
+            uint64_t seed = 1;
+            for (size_t idx = 0; idx < capacity; idx++) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                uni_common_ringbuffer_window_push(&ctx, (double)(seed >> 40));
+            }
+
+            BENCHMARK("tick/window/" + std::to_string(capacity)) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                uni_common_ringbuffer_window_push(&ctx, (double)(seed >> 40));
+
+                double value_min = 0.0, value_max = 0.0;
+                uni_common_ringbuffer_window_min(&ctx, &value_min);
+                uni_common_ringbuffer_window_max(&ctx, &value_max);
+                return value_min + value_max + uni_common_ringbuffer_window_sum(&ctx);
+            };
+        }
+    }
+}